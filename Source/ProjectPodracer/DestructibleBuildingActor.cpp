@@ -3,6 +3,7 @@
 #include "DestructibleBuildingActor.h"
 #include "Components/StaticMeshComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "ProceduralTrackGenerator.h"
 
 ADestructibleBuildingActor::ADestructibleBuildingActor()
 {
@@ -35,6 +36,8 @@ void ADestructibleBuildingActor::GetLifetimeReplicatedProps(TArray<FLifetimeProp
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
     // Replicate the bIsDestroyed variable to all clients.
     DOREPLIFETIME(ADestructibleBuildingActor, bIsDestroyed);
+    DOREPLIFETIME(ADestructibleBuildingActor, Source);
+    DOREPLIFETIME(ADestructibleBuildingActor, bPooled);
 }
 
 float ADestructibleBuildingActor::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -82,6 +85,65 @@ void ADestructibleBuildingActor::OnRep_IsDestroyed()
         FVector Impulse = (GetActorLocation() - GetActorUpVector() * 100).GetSafeNormal() * -1;
         GeometryCollectionComponent->AddImpulse(Impulse * 10000.0f, NAME_None, true);
     }
+    else
+    {
+        // Back from a pool: intact mesh up, pieces hidden and rebuilt at rest.
+        IntactMeshComponent->SetVisibility(true);
+        IntactMeshComponent->SetCollisionProfileName(TEXT("BlockAll"));
+
+        GeometryCollectionComponent->SetSimulatePhysics(false);
+        GeometryCollectionComponent->SetVisibility(false);
+        GeometryCollectionComponent->RecreatePhysicsState();
+    }
+}
+
+void ADestructibleBuildingActor::ResetToIntact()
+{
+    if (HasAuthority() && bIsDestroyed)
+    {
+        bIsDestroyed = false;
+        OnRep_IsDestroyed(); // Call locally on server
+    }
+}
+
+void ADestructibleBuildingActor::SetSource(AProceduralTrackGenerator* Track, int32 AssetIndex, int32 InstanceIndex)
+{
+    if (HasAuthority())
+    {
+        Source.Track = Track;
+        Source.AssetIndex = AssetIndex;
+        Source.InstanceIndex = InstanceIndex;
+    }
+}
+
+void ADestructibleBuildingActor::OnRep_Source()
+{
+    // The server hid its instance when it promoted this building.
+    if (Source.Track)
+    {
+        Source.Track->HideBuildingInstance(Source.AssetIndex, Source.InstanceIndex);
+    }
+}
+
+void ADestructibleBuildingActor::SetPooled(bool bInPooled)
+{
+    if (HasAuthority() && bPooled != bInPooled)
+    {
+        bPooled = bInPooled;
+        OnRep_Pooled(); // Call locally on server
+    }
+}
+
+void ADestructibleBuildingActor::OnRep_Pooled()
+{
+    // Collision doesn't replicate, so clients would otherwise keep a pooled building as an invisible wall.
+    SetActorHiddenInGame(bPooled);
+    SetActorEnableCollision(!bPooled);
+}
+
+UStaticMesh* ADestructibleBuildingActor::GetIntactMesh() const
+{
+    return IntactMeshComponent ? IntactMeshComponent->GetStaticMesh() : nullptr;
 }
 
 
@@ -7,6 +7,24 @@
 #include "GeometryCollection/GeometryCollectionComponent.h"
 #include "DestructibleBuildingActor.generated.h"
 
+class AProceduralTrackGenerator;
+
+// The instanced building on a generated track that a destructible stands in for.
+USTRUCT()
+struct FDestructibleBuildingSource
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AProceduralTrackGenerator* Track = nullptr;
+
+	UPROPERTY()
+	int32 AssetIndex = INDEX_NONE;
+
+	UPROPERTY()
+	int32 InstanceIndex = INDEX_NONE;
+};
+
 UCLASS()
 class PROJECTPODRACER_API ADestructibleBuildingActor : public AActor
 {
@@ -45,6 +63,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Destruction")
 	void TriggerDestruction();
 
+	// Puts the building back up, for reuse from a track's destructible pool. Server only.
+	void ResetToIntact();
+
+	// Ties this actor to the track instance it replaces, so clients hide their copy of the instance. Server only.
+	void SetSource(AProceduralTrackGenerator* Track, int32 AssetIndex, int32 InstanceIndex);
+
+	// Parks the building in a track's destructible pool (hidden, no collision) or takes it out again. Server only, and
+	// replicated, since clients don't get the actor's collision from the server.
+	void SetPooled(bool bInPooled);
+	bool IsPooled() const { return bPooled; }
+
+	// Mesh the intact building shows, read from class defaults to draw the building as an instance.
+	UStaticMesh* GetIntactMesh() const;
+
 private:
 	UPROPERTY(ReplicatedUsing = OnRep_IsDestroyed)
 	bool bIsDestroyed = false;
@@ -52,6 +84,18 @@ private:
 	// This function is called on clients when the bIsDestroyed variable is replicated.
 	UFUNCTION()
 	void OnRep_IsDestroyed();
+
+	UPROPERTY(ReplicatedUsing = OnRep_Source)
+	FDestructibleBuildingSource Source;
+
+	UFUNCTION()
+	void OnRep_Source();
+
+	UPROPERTY(ReplicatedUsing = OnRep_Pooled)
+	bool bPooled = false;
+
+	UFUNCTION()
+	void OnRep_Pooled();
     
 	// Ensures variables are replicated for multiplayer.
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
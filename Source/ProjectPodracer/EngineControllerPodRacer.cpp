@@ -5,9 +5,12 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "DrawDebugHelpers.h"
 #include "PhysicsEngine/BodyInstance.h"
+#include "PodAsyncPhysicsSubsystem.h"
+#include "PodGroundProbe.h"
 
 AEngineControllerPodRacer::AEngineControllerPodRacer()
 {
+    const FPodControllerTuning& Tuning = GetTuning();
     PrimaryActorTick.bCanEverTick = true;
     SetActorTickEnabled(true);
 
@@ -15,11 +18,11 @@ AEngineControllerPodRacer::AEngineControllerPodRacer()
     RootComponent = BoxCollider;
     BoxCollider->SetBoxExtent(FVector(100, 52, 12));
     BoxCollider->SetSimulatePhysics(true);
-    BoxCollider->SetMassOverrideInKg(NAME_None, Mass);
+    BoxCollider->SetMassOverrideInKg(NAME_None, Tuning.Mass);
     BoxCollider->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
     BoxCollider->SetCollisionResponseToChannel(ECC_Camera, ECR_Ignore);
-    BoxCollider->SetLinearDamping(LinearDamping);
-    BoxCollider->SetAngularDamping(AngularDamping);
+    BoxCollider->SetLinearDamping(Tuning.LinearDamping);
+    BoxCollider->SetAngularDamping(Tuning.AngularDamping);
     BoxCollider->SetEnableGravity(false);
     BoxCollider->SetGenerateOverlapEvents(false);
     BoxCollider->SetUseCCD(true);
@@ -126,7 +129,7 @@ AEngineControllerPodRacer::AEngineControllerPodRacer()
 
 float AEngineControllerPodRacer::GetSpeedPercentage() const
 {
-    return BoxCollider ? BoxCollider->GetPhysicsLinearVelocity().Size() / TerminalVelocity : 0.0f;
+    return BoxCollider ? BoxCollider->GetPhysicsLinearVelocity().Size() / GetTuning().TerminalVelocity : 0.0f;
 }
 
 void AEngineControllerPodRacer::BeginPlay()
@@ -144,6 +147,14 @@ void AEngineControllerPodRacer::BeginPlay()
     if (BoxCollider)
     {
         BoxCollider->OnComponentHit.AddDynamic(this, &AEngineControllerPodRacer::OnComponentHit);
+        // The constructor set up the body from the default tuning
+        if (TuningAsset)
+        {
+            const FPodControllerTuning& Tuning = GetTuning();
+            BoxCollider->SetMassOverrideInKg(NAME_None, Tuning.Mass);
+            BoxCollider->SetLinearDamping(Tuning.LinearDamping);
+            BoxCollider->SetAngularDamping(Tuning.AngularDamping);
+        }
     }
 
     // Initialize two engines
@@ -154,6 +165,14 @@ void AEngineControllerPodRacer::BeginPlay()
     AddEngine(EngineStatsHandle, FVector(100.0f, -50.0f, -25.0f)); // Right engine
 }
 
+void AEngineControllerPodRacer::PostLoad()
+{
+    Super::PostLoad();
+#if WITH_EDITORONLY_DATA
+    UPodTuningDataAsset::MigrateDeprecatedTuning(this, &ThisClass::TuningAsset, &UPodTuningDataAsset::Controller);
+#endif
+}
+
 void AEngineControllerPodRacer::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
     Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -191,6 +210,9 @@ void AEngineControllerPodRacer::Tick(float DeltaTime)
         }
     }
 
+    const UPodAsyncPhysicsSubsystem* AsyncPhysics = UPodAsyncPhysicsSubsystem::Get(GetWorld());
+    bForcesOnPhysicsThread = bSimulateForcesOnPhysicsThread && AsyncPhysics && AsyncPhysics->CanPublishBodyInput(BoxCollider);
+
     CalculateHover(DeltaTime);
     
     // ====================================================================
@@ -198,32 +220,41 @@ void AEngineControllerPodRacer::Tick(float DeltaTime)
     // ====================================================================
 
     // 1. Smooth the rudder input for keyboard friendliness
-    float InterpSpeed = (FMath::IsNearlyZero(RudderInput)) ? KeyboardSteeringReturnSpeed : KeyboardSteeringInterpSpeed;
+    const FPodControllerTuning& Tuning = GetTuning();
+    float InterpSpeed = (FMath::IsNearlyZero(RudderInput)) ? Tuning.KeyboardSteeringReturnSpeed : Tuning.KeyboardSteeringInterpSpeed;
     SmoothedRudderInput = FMath::FInterpTo(SmoothedRudderInput, RudderInput, DeltaTime, InterpSpeed);
 
     // ====================================================================
     // END OF NEW LOGIC
     // ====================================================================
     CalculatePropulsion(DeltaTime);
+
+    if (bForcesOnPhysicsThread)
+    {
+        PublishAsyncPhysicsInput();
+    }
 }
 
 void AEngineControllerPodRacer::CalculateHover(float DeltaTime)
 {
-    FVector GroundNormal = FVector::UpVector;
+    const FPodControllerTuning& Tuning = GetTuning();
+    GroundNormal = FVector::UpVector;
+    GroundPoint = BoxCollider->GetComponentLocation() - GroundNormal * Tuning.MaxGroundDist;
     bIsOnGround = false;
-    float Height = MaxGroundDist;
+    float Height = Tuning.MaxGroundDist;
 
     FVector Start = BoxCollider->GetComponentLocation();
-    FVector End = Start - GetActorUpVector() * MaxGroundDist;
+    FVector End = Start - GetActorUpVector() * Tuning.MaxGroundDist;
     FHitResult HitResult;
-    FCollisionQueryParams QueryParams;
+    FCollisionQueryParams QueryParams(PodQueryStats::Tag(EPodQueryClass::EngineController));
     QueryParams.AddIgnoredActor(this);
 
-    if (GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, GroundCollisionChannel, QueryParams))
+    if (PodGroundProbe::LineTrace(GetWorld(), GroundContactCache, AsyncGroundProbe, HitResult, Start, End, Tuning.GroundCollisionChannel, QueryParams))
     {
         bIsOnGround = true;
         Height = HitResult.Distance;
         GroundNormal = HitResult.Normal.GetSafeNormal();
+        GroundPoint = HitResult.ImpactPoint;
     }
 
     // Reset PID on ground transition
@@ -233,12 +264,22 @@ void AEngineControllerPodRacer::CalculateHover(float DeltaTime)
     }
     bWasOnGroundLastFrame = bIsOnGround;
 
+    if (HoverPID.bUseImplicitSpring)
+    {
+        float FullHoverForce = 0.0f;
+        for (UEngineComponent* Engine : Engines)
+        {
+            FullHoverForce += Engine->GetHoverForce(1.0f);
+        }
+        HoverPID.Spring.SetOutputMapping(FullHoverForce / Tuning.Mass, Tuning.HoverGravity);
+    }
+
     if (bDrawDebug)
     {
         DrawDebugLine(GetWorld(), Start, End, bIsOnGround ? FColor::Green : FColor::Red, false, 0.0f, 0, 1.0f);
         if (bIsOnGround)
         {
-            DrawDebugSphere(GetWorld(), Start - GetActorUpVector() * HoverHeight, 10.0f, 12, FColor::Blue, false, 0.0f);
+            DrawDebugSphere(GetWorld(), Start - GetActorUpVector() * Tuning.HoverHeight, 10.0f, 12, FColor::Blue, false, 0.0f);
             DrawDebugString(GetWorld(), BoxCollider->GetComponentLocation(), FString::Printf(TEXT("Height: %.1f"), Height), nullptr, FColor::White, 0.0f);
             for (UEngineComponent* Engine : Engines)
             {
@@ -247,44 +288,48 @@ void AEngineControllerPodRacer::CalculateHover(float DeltaTime)
         }
     }
 
-    if (bIsOnGround)
+    // With async physics the PID runs per substep on the physics thread instead
+    if (!bForcesOnPhysicsThread)
     {
-        float ForcePercent = HoverPID.Seek(HoverHeight, Height, DeltaTime);
-        if (Height > HoverHeight)
-        {
-            ForcePercent *= 0.5f; // Weaken upward force for descent
-        }
-        for (UEngineComponent* Engine : Engines)
+        if (bIsOnGround)
         {
-            float EngineHoverForce = Engine->GetHoverForce(ForcePercent);
-            FVector Force = GroundNormal * EngineHoverForce / Mass;
-            BoxCollider->AddForceAtLocation(Force * Mass, Engine->GetForceApplicationPoint());
+            float ForcePercent = HoverPID.Seek(Tuning.HoverHeight, Height, DeltaTime);
+            if (Height > Tuning.HoverHeight && !HoverPID.bUseImplicitSpring)
+            {
+                ForcePercent *= 0.5f; // Weaken upward force for descent
+            }
+            for (UEngineComponent* Engine : Engines)
+            {
+                float EngineHoverForce = Engine->GetHoverForce(ForcePercent);
+                FVector Force = GroundNormal * EngineHoverForce / Tuning.Mass;
+                BoxCollider->AddForceAtLocation(Force * Tuning.Mass, Engine->GetForceApplicationPoint());
+
+                if (bDrawDebug)
+                {
+                    FVector ForceEnd = Engine->GetForceApplicationPoint() + Force.GetSafeNormal() * DebugArrowLength * ForcePercent;
+                    UKismetSystemLibrary::DrawDebugArrow(GetWorld(), Engine->GetForceApplicationPoint(), ForceEnd, DebugArrowSize, FColor::Cyan, 0, 5.0f);
+                }
+            }
+            FVector Gravity = -GroundNormal * Tuning.HoverGravity;
+            BoxCollider->AddForce(Gravity * Tuning.Mass);
 
             if (bDrawDebug)
             {
-                FVector ForceEnd = Engine->GetForceApplicationPoint() + Force.GetSafeNormal() * DebugArrowLength * ForcePercent;
-                UKismetSystemLibrary::DrawDebugArrow(GetWorld(), Engine->GetForceApplicationPoint(), ForceEnd, DebugArrowSize, FColor::Cyan, 0, 5.0f);
+                float Proportional = Tuning.HoverHeight - Height;
+                float Integral = HoverPID.Integral;
+                float Derivative = (Proportional - HoverPID.LastProportional) / DeltaTime;
+                UE_LOG(LogTemp, Log, TEXT("Height: %f, ForcePercent: %f, P: %f, I: %f, D: %f"), Height, ForcePercent, Proportional * HoverPID.PCoeff, Integral * HoverPID.ICoeff, Derivative * HoverPID.DCoeff);
             }
         }
-        FVector Gravity = -GroundNormal * HoverGravity;
-        BoxCollider->AddForce(Gravity * Mass);
-
-        if (bDrawDebug)
-        {
-            float Proportional = HoverHeight - Height;
-            float Integral = HoverPID.Integral;
-            float Derivative = (Proportional - HoverPID.LastProportional) / DeltaTime;
-            UE_LOG(LogTemp, Log, TEXT("Height: %f, ForcePercent: %f, P: %f, I: %f, D: %f"), Height, ForcePercent, Proportional * HoverPID.PCoeff, Integral * HoverPID.ICoeff, Derivative * HoverPID.DCoeff);
-        }
-    }
-    else
-    {
-        FVector Gravity = -GroundNormal * FallGravity;
-        BoxCollider->AddForce(Gravity * Mass);
-        if (bDrawDebug)
+        else
         {
-            FVector CurrentVelocity = BoxCollider->GetPhysicsLinearVelocity();
-            UE_LOG(LogTemp, Log, TEXT("Airborne Velocity: X=%.1f, Y=%.1f, Z=%.1f"), CurrentVelocity.X, CurrentVelocity.Y, CurrentVelocity.Z);
+            FVector Gravity = -GroundNormal * Tuning.FallGravity;
+            BoxCollider->AddForce(Gravity * Tuning.Mass);
+            if (bDrawDebug)
+            {
+                FVector CurrentVelocity = BoxCollider->GetPhysicsLinearVelocity();
+                UE_LOG(LogTemp, Log, TEXT("Airborne Velocity: X=%.1f, Y=%.1f, Z=%.1f"), CurrentVelocity.X, CurrentVelocity.Y, CurrentVelocity.Z);
+            }
         }
     }
 
@@ -294,7 +339,7 @@ void AEngineControllerPodRacer::CalculateHover(float DeltaTime)
     BoxCollider->SetWorldRotation(NewRotation);
 
     RudderInput = FMath::FInterpTo(RudderInput, 0.0f, DeltaTime, 20.0f);
-    float RollAngle = AngleOfRoll * -RudderInput;
+    float RollAngle = Tuning.AngleOfRoll * -RudderInput;
     //FQuat BodyRotation = GetActorRotation().Quaternion() * FQuat(FVector(0, 0, 1), FMath::DegreesToRadians(RollAngle));
     FRotator LookAtRotation = UKismetMathLibrary::FindLookAtRotation(HullMesh->GetComponentLocation(), EngineConnectorRoot->GetComponentLocation());
     FQuat CurrentBodyRotation = HullMesh->GetComponentQuat();
@@ -307,37 +352,44 @@ void AEngineControllerPodRacer::CalculateHover(float DeltaTime)
 
 void AEngineControllerPodRacer::CalculatePropulsion(float DeltaTime)
 {
+    const FPodControllerTuning& Tuning = GetTuning();
     float TotalThrust = 0.0f;
     for (UEngineComponent* Engine : Engines)
     {
-        TotalThrust += Engine->GetThrustForce(1.0f, bIsBoosting, bIsDrifting, DriftMultiplier, BoostMultiplier);
+        TotalThrust += Engine->GetThrustForce(1.0f, bIsBoosting, bIsDrifting, Tuning.DriftMultiplier, Tuning.BoostMultiplier);
     }
-    Drag = TotalThrust / TerminalVelocity;
+    Drag = TotalThrust / Tuning.TerminalVelocity;
 
     float SidewaysSpeed = FVector::DotProduct(BoxCollider->GetPhysicsLinearVelocity(), BoxCollider->GetRightVector());
     // ✅ REVISED SideFriction calculation
     // This applies a stable corrective force to reduce drift, scaled by your new grip factor and the vehicle's mass.
-    FVector SideFriction = -BoxCollider->GetRightVector() * SidewaysSpeed * SidewaysGripFactor * Mass;//(SidewaysSpeed / DeltaTime);
-    BoxCollider->AddForce(SideFriction);
+    FVector SideFriction = -BoxCollider->GetRightVector() * SidewaysSpeed * Tuning.SidewaysGripFactor * Tuning.Mass;//(SidewaysSpeed / DeltaTime);
+    if (!bForcesOnPhysicsThread)
+    {
+        BoxCollider->AddForce(SideFriction);
+    }
 
     if (ThrusterInput <= 0.0f)
     {
         FVector CurrentVelocity = BoxCollider->GetPhysicsLinearVelocity();
-        BoxCollider->SetPhysicsLinearVelocity(CurrentVelocity * SlowingVelFactor);
+        BoxCollider->SetPhysicsLinearVelocity(CurrentVelocity * Tuning.SlowingVelFactor);
     }
 
     if (bIsBraking)
     {
         FVector CurrentVelocity = BoxCollider->GetPhysicsLinearVelocity();
-        BoxCollider->SetPhysicsLinearVelocity(CurrentVelocity * BrakingVelFactor);
+        BoxCollider->SetPhysicsLinearVelocity(CurrentVelocity * Tuning.BrakingVelFactor);
     }
 
     float AirborneThrustScale = bIsOnGround ? 1.0f : 0.5f; // 50% thrust when airborne
     for (UEngineComponent* Engine : Engines)
     {
-        float EngineThrust = Engine->GetThrustForce(ThrusterInput, bIsBoosting, bIsDrifting, DriftMultiplier, BoostMultiplier) * AirborneThrustScale;
+        float EngineThrust = Engine->GetThrustForce(ThrusterInput, bIsBoosting, bIsDrifting, Tuning.DriftMultiplier, Tuning.BoostMultiplier) * AirborneThrustScale;
         FVector Force = GetActorForwardVector() * EngineThrust;
-        BoxCollider->AddForceAtLocation(Force, Engine->GetForceApplicationPoint());
+        if (!bForcesOnPhysicsThread)
+        {
+            BoxCollider->AddForceAtLocation(Force, Engine->GetForceApplicationPoint());
+        }
 
         if (bDrawDebug)
         {
@@ -347,6 +399,35 @@ void AEngineControllerPodRacer::CalculatePropulsion(float DeltaTime)
     }
 }
 
+void AEngineControllerPodRacer::PublishAsyncPhysicsInput()
+{
+    const FPodControllerTuning& Tuning = GetTuning();
+    FPodAsyncBodyInput BodyInput;
+    BodyInput.GroundPoint = GroundPoint;
+    BodyInput.GroundNormal = GroundNormal;
+    BodyInput.bOnGround = bIsOnGround;
+    BodyInput.HoverHeight = Tuning.HoverHeight;
+    BodyInput.MaxGroundDist = Tuning.MaxGroundDist;
+    BodyInput.DescentForceScale = HoverPID.bUseImplicitSpring ? 1.0f : 0.5f;
+    BodyInput.bResetPIDOnLanding = true;
+    BodyInput.HoverPID = HoverPID;
+    BodyInput.HoverGravity = Tuning.HoverGravity;
+    BodyInput.FallGravity = Tuning.FallGravity;
+    BodyInput.AirborneThrustScale = 0.5f;
+    BodyInput.SideGrip = Tuning.SidewaysGripFactor * Tuning.Mass;
+
+    const FTransform& BodyTransform = BoxCollider->GetComponentTransform();
+    for (UEngineComponent* Engine : Engines)
+    {
+        FPodAsyncForcePoint& Point = BodyInput.ForcePoints.AddDefaulted_GetRef();
+        Point.LocalOffset = BodyTransform.InverseTransformPositionNoScale(Engine->GetForceApplicationPoint());
+        Point.HoverForce = Engine->GetHoverForce(1.0f);
+        Point.ThrustForce = Engine->GetThrustForce(ThrusterInput, bIsBoosting, bIsDrifting, Tuning.DriftMultiplier, Tuning.BoostMultiplier);
+    }
+
+    UPodAsyncPhysicsSubsystem::Get(GetWorld())->PublishBodyInput(BoxCollider, MoveTemp(BodyInput));
+}
+
 void AEngineControllerPodRacer::Accelerate(const FInputActionValue& Value)
 {
     ThrusterInput = Value.Get<float>();
@@ -354,27 +435,28 @@ void AEngineControllerPodRacer::Accelerate(const FInputActionValue& Value)
 
 void AEngineControllerPodRacer::Steer(const FInputActionValue& Value)
 {
+    const FPodControllerTuning& Tuning = GetTuning();
     RudderInput = Value.Get<float>();
     // 2. Implement Speed-based agility (from Suggestion 3)
     float ForwardSpeed = FVector::DotProduct(BoxCollider->GetPhysicsLinearVelocity(), GetActorForwardVector());
     float SpeedMultiplier = FMath::GetMappedRangeValueClamped(
-        FVector2D(0.0f, TerminalVelocity),
-        FVector2D(1.0f, HighSpeedSteeringDampFactor),
+        FVector2D(0.0f, Tuning.TerminalVelocity),
+        FVector2D(1.0f, Tuning.HighSpeedSteeringDampFactor),
         ForwardSpeed
     );
 
     // 3. Define the target angular velocity using the SMOOTHED input
-    float TargetAngularVelocity = SmoothedRudderInput * MaxTurnRate * SpeedMultiplier;
+    float TargetAngularVelocity = SmoothedRudderInput * Tuning.MaxTurnRate * SpeedMultiplier;
     if (bIsDrifting)
     {
-        TargetAngularVelocity *= DriftMultiplier;
+        TargetAngularVelocity *= Tuning.DriftMultiplier;
     }
 
     // 4. Apply torque using the P-Controller logic (from Suggestion 2)
     float CurrentAngularVelocity = BoxCollider->GetPhysicsAngularVelocityInRadians().Z;
     float Error = TargetAngularVelocity - CurrentAngularVelocity;
     // NOTE: Your original code had "SteeringMultiplier" here. We are using the renamed "SteeringStiffness"
-    float RotationTorque = Error * SteeringMultiplier; 
+    float RotationTorque = Error * Tuning.SteeringMultiplier; 
     BoxCollider->AddTorqueInDegrees(FVector(0, 0, RotationTorque * 1000.0f), NAME_None, true);
     /*
     float CurrentYawVelocity = BoxCollider->GetPhysicsAngularVelocityInRadians().Z;
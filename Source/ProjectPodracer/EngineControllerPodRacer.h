@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "PIDController.h"
+#include "PodGroundProbe.h"
+#include "PodTuningDataAsset.h"
 #include "GameFramework/Pawn.h"
 #include "EngineComponent.h"
 #include "Components/BoxComponent.h"
@@ -53,11 +55,13 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void PostLoad() override;
     virtual void Tick(float DeltaTime) override;
     virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
     void CalculateHover(float DeltaTime);
     void CalculatePropulsion(float DeltaTime);
+    void PublishAsyncPhysicsInput();
 
 public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -78,68 +82,18 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UCameraComponent* Camera;
 
-    UPROPERTY(EditAnywhere, Category = "ConfigData|DriveSettings")
-    float SlowingVelFactor = 0.99f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|DriveSettings")
-    float BrakingVelFactor = 0.98f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|DriveSettings")
-    float AngleOfRoll = 30.0f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|HoverSettings")
-    float HoverHeight = 100.0f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|HoverSettings")
-    float MaxGroundDist = 500.0f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|HoverSettings")
-    TEnumAsByte<ECollisionChannel> GroundCollisionChannel = ECC_WorldStatic;
+    // Shared tuning asset, pods of the same class should all reference one. Defaults are used when unset
+    UPROPERTY(EditAnywhere, Category = "ConfigData")
+    TObjectPtr<UPodTuningDataAsset> TuningAsset;
+    const FPodControllerTuning& GetTuning() const { return UPodTuningDataAsset::GetControllerTuning(TuningAsset); }
 
+    // Per-pod: the PID keeps its integral and last error between ticks
     UPROPERTY(EditAnywhere, Category = "ConfigData|HoverSettings")
     FPIDController HoverPID;
 
+    // Hover, thrust and side friction are evaluated every physics substep by UPodAsyncPhysicsSubsystem; the game thread only publishes inputs
     UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float TerminalVelocity = 30000.0f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float HoverGravity = 2000.0f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float FallGravity = 9810.0f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float MaxTurnRate = 2.0f; // Max turn rate in radians/sec at full stick input
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float SteeringMultiplier = 600.0f; // This was SteeringMultiplier
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float SidewaysGripFactor = 100.0f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings", meta=(ClampMin="0.0", ClampMax="1.0"))
-    float HighSpeedSteeringDampFactor = 0.4f; // At max speed, steering is 40% as effective
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float KeyboardSteeringInterpSpeed = 5.0f; // How fast the steering ramps up when a key is pressed
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float KeyboardSteeringReturnSpeed = 8.0f; // How fast the steering returns to center when released (often slightly faster)
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float DriftMultiplier = 1.5f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float BoostMultiplier = 3.0f;
-
-    UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
-    float Mass = 100.0f;
-
-    UPROPERTY(EditAnywhere, Category = "Physics")
-    float LinearDamping = 0.5f;
-
-    UPROPERTY(EditAnywhere, Category = "Physics")
-    float AngularDamping = 3.0f; // Increased for imbalance
+    bool bSimulateForcesOnPhysicsThread = true;
 
     UPROPERTY(EditAnywhere, Category = "Debug")
     bool bDrawDebug = true;
@@ -204,8 +158,41 @@ private:
     float AccelerationInput;
     bool bWasOnGroundLastFrame = false;
 
+    // Set each tick when the async physics callback owns the forces this frame
+    bool bForcesOnPhysicsThread = false;
+    FVector GroundPoint = FVector::ZeroVector;
+    FVector GroundNormal = FVector::UpVector;
+    // Ground plane reused between hover traces while the pod stays on it
+    FPodGroundContactCache GroundContactCache;
+    // Last frame's hover query when Pod.GroundProbe.Async is on
+    FPodAsyncGroundProbe AsyncGroundProbe;
+
     // Add this in the private member variables section at the bottom of the .h file
     float SmoothedRudderInput;
 
+#if WITH_EDITORONLY_DATA
+    // Tuning saved per instance before TuningAsset, checked against the class default asset by PostLoad
+    UPROPERTY() float SlowingVelFactor_DEPRECATED = 0.99f;
+    UPROPERTY() float BrakingVelFactor_DEPRECATED = 0.98f;
+    UPROPERTY() float AngleOfRoll_DEPRECATED = 30.0f;
+    UPROPERTY() float HoverHeight_DEPRECATED = 100.0f;
+    UPROPERTY() float MaxGroundDist_DEPRECATED = 500.0f;
+    UPROPERTY() float TerminalVelocity_DEPRECATED = 30000.0f;
+    UPROPERTY() float HoverGravity_DEPRECATED = 2000.0f;
+    UPROPERTY() float FallGravity_DEPRECATED = 9810.0f;
+    UPROPERTY() float MaxTurnRate_DEPRECATED = 2.0f;
+    UPROPERTY() float SteeringMultiplier_DEPRECATED = 600.0f;
+    UPROPERTY() float SidewaysGripFactor_DEPRECATED = 100.0f;
+    UPROPERTY() float HighSpeedSteeringDampFactor_DEPRECATED = 0.4f;
+    UPROPERTY() float KeyboardSteeringInterpSpeed_DEPRECATED = 5.0f;
+    UPROPERTY() float KeyboardSteeringReturnSpeed_DEPRECATED = 8.0f;
+    UPROPERTY() float DriftMultiplier_DEPRECATED = 1.5f;
+    UPROPERTY() float BoostMultiplier_DEPRECATED = 3.0f;
+    UPROPERTY() float Mass_DEPRECATED = 100.0f;
+    UPROPERTY() float LinearDamping_DEPRECATED = 0.5f;
+    UPROPERTY() float AngularDamping_DEPRECATED = 3.0f;
+    UPROPERTY() TEnumAsByte<ECollisionChannel> GroundCollisionChannel_DEPRECATED = ECC_PodGround;
+#endif
+
     int32 EngineNameIndex = 0;
 };
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "Components/BoxComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "PodAsyncPhysicsSubsystem.h"
+#include "PodGroundProbe.h"
 
 
 // Sets default values for this component's properties
@@ -94,9 +96,17 @@ void UHoverJetEngineComp::TickComponent(float DeltaTime, ELevelTick TickType,
 		CurrentSpeed = FVector::DotProduct(BoxCollider->GetPhysicsLinearVelocity(), GetForwardVector());
 	}
 
+	const UPodAsyncPhysicsSubsystem* AsyncPhysics = UPodAsyncPhysicsSubsystem::Get(GetWorld());
+	bForcesOnPhysicsThread = bSimulateForcesOnPhysicsThread && AsyncPhysics && AsyncPhysics->CanPublishBodyInput(BoxCollider);
+
 	// Perform physics calculations
 	CalculateHover(DeltaTime);
 	CalculatePropulsion(DeltaTime);
+
+	if (bForcesOnPhysicsThread)
+	{
+		PublishAsyncPhysicsInput();
+	}
 }
 
 float UHoverJetEngineComp::GetSpeedPercentage() const
@@ -106,7 +116,8 @@ float UHoverJetEngineComp::GetSpeedPercentage() const
 
 void UHoverJetEngineComp::CalculateHover(float DeltaTime)
 {
-	FVector GroundNormal = FVector::UpVector;
+	GroundNormal = FVector::UpVector;
+	GroundPoint = BoxCollider->GetComponentLocation() - GroundNormal * MaxGroundDist;
 	bIsOnGround = false;
 	float Height = MaxGroundDist;
 
@@ -114,14 +125,15 @@ void UHoverJetEngineComp::CalculateHover(float DeltaTime)
 	FVector Start = BoxCollider->GetComponentLocation();
 	FVector End = Start - GetUpVector() * MaxGroundDist;
 	FHitResult HitResult;
-	FCollisionQueryParams QueryParams;
+	FCollisionQueryParams QueryParams(PodQueryStats::Tag(EPodQueryClass::HoverJetEngine));
 	QueryParams.AddIgnoredActor(GetOwner());
 
-	if (GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, GroundCollisionChannel, QueryParams))
+	if (PodGroundProbe::LineTrace(GetWorld(), GroundContactCache, AsyncGroundProbe, HitResult, Start, End, GroundCollisionChannel, QueryParams))
 	{
 		bIsOnGround = true;
 		Height = HitResult.Distance;
 		GroundNormal = HitResult.Normal.GetSafeNormal();
+		GroundPoint = HitResult.ImpactPoint;
 	}
 
 	// Draw debug line
@@ -134,9 +146,17 @@ void UHoverJetEngineComp::CalculateHover(float DeltaTime)
 		}
 	}
 
-	if (bIsOnGround)
+	if (bForcesOnPhysicsThread)
+	{
+		// Hover force and gravity are evaluated per substep by the async physics callback
+	}
+	else if (bIsOnGround)
 	{
 		float Proportional = HoverHeight - Height;
+		if (HoverPID.bUseImplicitSpring)
+		{
+			HoverPID.Spring.SetOutputMapping(HoverForce / Mass, HoverGravity);
+		}
         float ForcePercent = HoverPID.Seek(HoverHeight, Height, DeltaTime);
         FVector Force = GroundNormal * HoverForce * ForcePercent / Mass; // Normalize by mass
         FVector Gravity = -GroundNormal * HoverGravity;
@@ -169,7 +189,10 @@ void UHoverJetEngineComp::CalculatePropulsion(float DeltaTime)
 	// Calculate sideways speed
 	float SidewaysSpeed = FVector::DotProduct(BoxCollider->GetPhysicsLinearVelocity(), BoxCollider->GetRightVector());
 	FVector SideFriction = -BoxCollider->GetRightVector() * (SidewaysSpeed / DeltaTime);
-	BoxCollider->AddForce(SideFriction);
+	if (!bForcesOnPhysicsThread)
+	{
+		BoxCollider->AddForce(SideFriction);
+	}
 
 	// Apply slowing when not thrusting
 	if (ThrusterInput <= 0.0f)
@@ -203,10 +226,45 @@ void UHoverJetEngineComp::CalculatePropulsion(float DeltaTime)
 	}
 
 	// Apply propulsion
+	if (bForcesOnPhysicsThread)
+	{
+		return;
+	}
 	float Propulsion = DriveForce * ThrusterInput * DriftValue * BoostValue - Drag * FMath::Clamp(CurrentSpeed, 0.0f, TerminalVelocity * BoostValue);
 	BoxCollider->AddForce(BoxCollider->GetForwardVector() * Propulsion);
 }
 
+void UHoverJetEngineComp::PublishAsyncPhysicsInput()
+{
+	const float BoostValue = bIsBoosting ? BoostMultiplier : 1.f;
+	const float DriftValue = bIsDrifting ? 1 / DriftMultiplier : 1.f;
+
+	FPodAsyncBodyInput BodyInput;
+	BodyInput.GroundPoint = GroundPoint;
+	BodyInput.GroundNormal = GroundNormal;
+	BodyInput.bOnGround = bIsOnGround;
+	BodyInput.HoverHeight = HoverHeight;
+	BodyInput.MaxGroundDist = MaxGroundDist;
+	BodyInput.HoverPID = HoverPID;
+	BodyInput.HoverPID.Spring.SetOutputMapping(HoverForce / Mass, HoverGravity);
+	BodyInput.HoverGravity = HoverGravity;
+	BodyInput.FallGravity = FallGravity;
+
+	// Single point at the body origin, no propulsion while airborne
+	FPodAsyncForcePoint& Point = BodyInput.ForcePoints.AddDefaulted_GetRef();
+	Point.HoverForce = HoverForce;
+	Point.ThrustForce = DriveForce * ThrusterInput * DriftValue * BoostValue;
+	BodyInput.AirborneThrustScale = 0.f;
+	BodyInput.Drag = Drag;
+	BodyInput.DragSpeedCap = TerminalVelocity * BoostValue;
+
+	// Matches the game thread's SidewaysSpeed / DeltaTime, using the substep instead of the frame
+	BodyInput.SideGrip = 1.f;
+	BodyInput.bSideGripPerStep = true;
+
+	UPodAsyncPhysicsSubsystem::Get(GetWorld())->PublishBodyInput(BoxCollider, MoveTemp(BodyInput));
+}
+
 void UHoverJetEngineComp::OnComponentHit(UPrimitiveComponent* HitComponent, AActor* OtherActor,
                                          UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "PIDController.h"
+#include "PodGroundProbe.h"
 #include "Components/SceneComponent.h"
 #include "HoverJetEngineComp.generated.h"
 
@@ -36,6 +37,7 @@ public:
 	// Physics calculations
 	void CalculateHover(float DeltaTime);
 	void CalculatePropulsion(float DeltaTime);
+	void PublishAsyncPhysicsInput();
 
 public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -70,7 +72,7 @@ public:
 	float HoverForce = 400000.f;
 	// LayerMask to determine what layer the ground is on
 	UPROPERTY(EditAnywhere, Category = "ConfigData|HoverSettings")
-	TEnumAsByte<ECollisionChannel> GroundCollisionChannel = ECC_WorldStatic; // TODO: Use channel for this for line tracing // TODO: Unless we want to be able to hover above other players?
+	TEnumAsByte<ECollisionChannel> GroundCollisionChannel = ECC_PodGround; // TODO: Unless we want to be able to hover above other players?
 	// A PID Controller to smooth the ship's hovering
 	UPROPERTY(EditAnywhere, Category = "ConfigData|HoverSettings")
 	FPIDController HoverPID = FPIDController();
@@ -92,6 +94,9 @@ public:
 	float BoostMultiplier = 3.f;
 	UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
 	float Mass = 100.0f; // Explicit mass in kg
+	// Let UPodAsyncPhysicsSubsystem apply hover, propulsion and side friction every physics substep
+	UPROPERTY(EditAnywhere, Category = "ConfigData|PhysicsSettings")
+	bool bSimulateForcesOnPhysicsThread = true;
 	UPROPERTY(EditAnywhere, Category = "Physics")
 	float LinearDamping = 1.0f; // Increased
 	UPROPERTY(EditAnywhere, Category = "Physics")
@@ -119,6 +124,15 @@ public:
 	float Drag = 0.f;
 	//A flag determining if the ship is currently on the ground
 	bool bIsOnGround = false;
+	// True while the async physics callback owns the forces, game thread only publishes inputs
+	bool bForcesOnPhysicsThread = false;
+	// Last ground plane found by the hover trace
+	FVector GroundPoint = FVector::ZeroVector;
+	FVector GroundNormal = FVector::UpVector;
+	// Ground plane reused between hover traces while the pod stays on it
+	FPodGroundContactCache GroundContactCache;
+	// Last frame's hover query when Pod.GroundProbe.Async is on
+	FPodAsyncGroundProbe AsyncGroundProbe;
 	float AccelerationInput = 0.f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "InputValues")
 	bool bIsDrifting = false;
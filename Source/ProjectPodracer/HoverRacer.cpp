@@ -11,6 +11,8 @@
 #include "GameFramework/SpringArmComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "PodAsyncPhysicsSubsystem.h"
+#include "PodGroundProbe.h"
 
 
 // Sets default values
@@ -162,9 +164,17 @@ void AHoverRacer::Tick(float DeltaTime)
 		CurrentSpeed = FVector::DotProduct(BoxCollider->GetPhysicsLinearVelocity(), GetActorForwardVector());
 	}
 
+	const UPodAsyncPhysicsSubsystem* AsyncPhysics = UPodAsyncPhysicsSubsystem::Get(GetWorld());
+	bForcesOnPhysicsThread = bSimulateForcesOnPhysicsThread && AsyncPhysics && AsyncPhysics->CanPublishBodyInput(BoxCollider);
+
 	// Perform physics calculations
 	CalculateHover(DeltaTime);
 	CalculatePropulsion(DeltaTime);
+
+	if (bForcesOnPhysicsThread)
+	{
+		PublishAsyncPhysicsInput();
+	}
 }
 
 // Called to bind functionality to input
@@ -190,7 +200,8 @@ void AHoverRacer::SetupPlayerInputComponent(UInputComponent* PlayerInputComponen
 
 void AHoverRacer::CalculateHover(float DeltaTime)
 {
-	FVector GroundNormal = FVector::UpVector;
+	GroundNormal = FVector::UpVector;
+	GroundPoint = BoxCollider->GetComponentLocation() - GroundNormal * MaxGroundDist;
 	bIsOnGround = false;
 	float Height = MaxGroundDist;
 
@@ -198,14 +209,15 @@ void AHoverRacer::CalculateHover(float DeltaTime)
 	FVector Start = BoxCollider->GetComponentLocation();
 	FVector End = Start - GetActorUpVector() * MaxGroundDist;
 	FHitResult HitResult;
-	FCollisionQueryParams QueryParams;
+	FCollisionQueryParams QueryParams(PodQueryStats::Tag(EPodQueryClass::HoverRacer));
 	QueryParams.AddIgnoredActor(this);
 
-	if (GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, GroundCollisionChannel, QueryParams))
+	if (PodGroundProbe::LineTrace(GetWorld(), GroundContactCache, HitResult, Start, End, GroundCollisionChannel, QueryParams))
 	{
 		bIsOnGround = true;
 		Height = HitResult.Distance;
 		GroundNormal = HitResult.Normal.GetSafeNormal();
+		GroundPoint = HitResult.ImpactPoint;
 	}
 
 	// Draw debug line
@@ -218,9 +230,17 @@ void AHoverRacer::CalculateHover(float DeltaTime)
 		}
 	}
 
-	if (bIsOnGround)
+	if (bForcesOnPhysicsThread)
+	{
+		// Hover force and gravity are evaluated per substep by the async physics callback
+	}
+	else if (bIsOnGround)
 	{
 		float Proportional = HoverHeight - Height;
+		if (HoverPID.bUseImplicitSpring)
+		{
+			HoverPID.Spring.SetOutputMapping(HoverForce / Mass, HoverGravity);
+		}
         float ForcePercent = HoverPID.Seek(HoverHeight, Height, DeltaTime);
         FVector Force = GroundNormal * HoverForce * ForcePercent / Mass; // Normalize by mass
         FVector Gravity = -GroundNormal * HoverGravity;
@@ -263,7 +283,10 @@ void AHoverRacer::CalculatePropulsion(float DeltaTime)
 	// Calculate sideways speed
 	float SidewaysSpeed = FVector::DotProduct(BoxCollider->GetPhysicsLinearVelocity(), BoxCollider->GetRightVector());
 	FVector SideFriction = -BoxCollider->GetRightVector() * (SidewaysSpeed / DeltaTime);
-	BoxCollider->AddForce(SideFriction);
+	if (!bForcesOnPhysicsThread)
+	{
+		BoxCollider->AddForce(SideFriction);
+	}
 
 	// Apply slowing when not thrusting
 	if (ThrusterInput <= 0.0f)
@@ -297,10 +320,45 @@ void AHoverRacer::CalculatePropulsion(float DeltaTime)
 	}
 
 	// Apply propulsion
+	if (bForcesOnPhysicsThread)
+	{
+		return;
+	}
 	float Propulsion = DriveForce * ThrusterInput * DriftValue * BoostValue - Drag * FMath::Clamp(CurrentSpeed, 0.0f, TerminalVelocity * BoostValue);
 	BoxCollider->AddForce(BoxCollider->GetForwardVector() * Propulsion);
 }
 
+void AHoverRacer::PublishAsyncPhysicsInput()
+{
+	const float BoostValue = bIsBoosting ? BoostMultiplier : 1.f;
+	const float DriftValue = bIsDrifting ? 1 / DriftMultiplier : 1.f;
+
+	FPodAsyncBodyInput BodyInput;
+	BodyInput.GroundPoint = GroundPoint;
+	BodyInput.GroundNormal = GroundNormal;
+	BodyInput.bOnGround = bIsOnGround;
+	BodyInput.HoverHeight = HoverHeight;
+	BodyInput.MaxGroundDist = MaxGroundDist;
+	BodyInput.HoverPID = HoverPID;
+	BodyInput.HoverPID.Spring.SetOutputMapping(HoverForce / Mass, HoverGravity);
+	BodyInput.HoverGravity = HoverGravity;
+	BodyInput.FallGravity = FallGravity;
+
+	// Single point at the body origin, no propulsion while airborne
+	FPodAsyncForcePoint& Point = BodyInput.ForcePoints.AddDefaulted_GetRef();
+	Point.HoverForce = HoverForce;
+	Point.ThrustForce = DriveForce * ThrusterInput * DriftValue * BoostValue;
+	BodyInput.AirborneThrustScale = 0.f;
+	BodyInput.Drag = Drag;
+	BodyInput.DragSpeedCap = TerminalVelocity * BoostValue;
+
+	// Matches the game thread's SidewaysSpeed / DeltaTime, using the substep instead of the frame
+	BodyInput.SideGrip = 1.f;
+	BodyInput.bSideGripPerStep = true;
+
+	UPodAsyncPhysicsSubsystem::Get(GetWorld())->PublishBodyInput(BoxCollider, MoveTemp(BodyInput));
+}
+
 void AHoverRacer::Accelerate(const FInputActionValue& Value)
 {
 	ThrusterInput = Value.Get<float>(); // -1 to 1
@@ -9,6 +9,7 @@
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
 #include "PhysicsEngine/BodyInstance.h" // Required for FBodyInstance
+#include "PodGroundProbe.h"
 
 AHoverRacerPawn::AHoverRacerPawn()
 {
@@ -24,6 +25,8 @@ AHoverRacerPawn::AHoverRacerPawn()
     HoverPidKi = 50.0f;   // Integral: Adjust to eliminate steady-state error (e.g., slight sinking)
     HoverPidKd = 150.0f;  // Derivative: Adjust to dampen oscillations
 
+    bUseImplicitHoverSpring = false;
+
     TargetHoverHeight = 150.0f;
     HoverTraceLength = TargetHoverHeight * 2.0f; // Trace a bit further than target height
 
@@ -88,6 +91,41 @@ void AHoverRacerPawn::BeginPlay()
     {
         PIDState.Reset();
     }
+    HoverPointGroundContacts.SetNum(HoverPoints.Num());
+
+    if (UPodHoverQuerySubsystem* HoverQueries = UPodHoverQuerySubsystem::Get(GetWorld()))
+    {
+        HoverQueries->RegisterSource(this, PrimaryActorTick);
+    }
+}
+
+void AHoverRacerPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UPodHoverQuerySubsystem* HoverQueries = UPodHoverQuerySubsystem::Get(GetWorld()))
+    {
+        HoverQueries->UnregisterSource(this, PrimaryActorTick);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AHoverRacerPawn::GatherHoverRays(FPodGroundRayBatch& Batch)
+{
+    HoverRayFirst = INDEX_NONE;
+    if (!HullMesh || !HullMesh->IsSimulatingPhysics() || HoverPoints.Num() != HoverPointGroundContacts.Num() || HoverPoints.Contains(nullptr))
+    {
+        return;
+    }
+
+    const int32 ParamsIndex = Batch.AddQueryParams(FCollisionQueryParams(PodQueryStats::Tag(EPodQueryClass::HoverRacerPawn), SCENE_QUERY_STAT_ONLY(HoverPoint), false, this));
+    HoverRayFirst = Batch.Num();
+    HoverRayFrame = GFrameCounter;
+    for (int32 i = 0; i < HoverPoints.Num(); ++i)
+    {
+        FVector StartLocation = HoverPoints[i]->GetComponentLocation();
+        FVector EndLocation = StartLocation - (HoverPoints[i]->GetUpVector() * HoverTraceLength);
+        Batch.AddRay(StartLocation, EndLocation, ECC_PodGround, ParamsIndex, &HoverPointGroundContacts[i]);
+    }
 }
 
 void AHoverRacerPawn::Tick(float DeltaTime)
@@ -111,13 +149,23 @@ void AHoverRacerPawn::Tick(float DeltaTime)
 
 void AHoverRacerPawn::ApplyHover(float DeltaTime)
 {
-    if (HoverPoints.Num() == 0 || HoverPoints.Num() != HoverPointPIDStates.Num())
+    if (HoverPoints.Num() == 0 || HoverPoints.Num() != HoverPointPIDStates.Num() || HoverPoints.Num() != HoverPointGroundContacts.Num())
     {
         return;
     }
 
     bool bAnyPointHitGroundThisFrame = false;
 
+    // Each point carries an equal share of the hull against gravity
+    const float PointMass = HullMesh->GetMass() / HoverPoints.Num();
+    const float HoldAcceleration = HullMesh->IsGravityEnabled() ? -GetWorld()->GetGravityZ() : 0.0f;
+
+    // The hover batch already traced this pod's points before it ticked, otherwise trace them here
+    const UPodHoverQuerySubsystem* HoverQueries = UPodHoverQuerySubsystem::Get(GetWorld());
+    const bool bUseBatchedRays = HoverRayFirst != INDEX_NONE && HoverRayFrame == GFrameCounter
+        && HoverQueries && HoverQueries->HasResultsForFrame(GFrameCounter);
+    FCollisionQueryParams CollisionParams(PodQueryStats::Tag(EPodQueryClass::HoverRacerPawn), SCENE_QUERY_STAT_ONLY(HoverPoint), false, this);
+
     for (int32 i = 0; i < HoverPoints.Num(); ++i)
     {
         USceneComponent* HoverPoint = HoverPoints[i];
@@ -129,12 +177,21 @@ void AHoverRacerPawn::ApplyHover(float DeltaTime)
         FVector EndLocation = StartLocation - (HoverPoint->GetUpVector() * HoverTraceLength);
         
         FHitResult HitResult;
-        FCollisionQueryParams CollisionParams;
-        CollisionParams.AddIgnoredActor(this);
-
-        bool bHit = GetWorld()->LineTraceSingleByChannel(
-            HitResult, StartLocation, EndLocation, ECC_Visibility, CollisionParams
-        );
+        bool bHit = false;
+        if (bUseBatchedRays)
+        {
+            bHit = HoverQueries->GetBatch().HasHit(HoverRayFirst + i);
+            if (bHit)
+            {
+                HitResult = HoverQueries->GetBatch().GetHit(HoverRayFirst + i);
+            }
+        }
+        else
+        {
+            bHit = PodGroundProbe::LineTrace(
+                GetWorld(), HoverPointGroundContacts[i], HitResult, StartLocation, EndLocation, ECC_PodGround, CollisionParams
+            );
+        }
         // DrawDebugLine(GetWorld(), StartLocation, EndLocation, bHit ? FColor::Green : FColor::Red, false, -1, 0, 1.0f);
 
         if (bHit)
@@ -143,6 +200,18 @@ void AHoverRacerPawn::ApplyHover(float DeltaTime)
             float CurrentHeight = HitResult.Distance;
             float Error = TargetHoverHeight - CurrentHeight;
 
+            if (bUseImplicitHoverSpring)
+            {
+                FVector ForceDirection = HoverPoint->GetUpVector();
+                float HeightRate = FVector::DotProduct(HullMesh->GetPhysicsLinearVelocityAtPoint(StartLocation), ForceDirection);
+                float SpringAcceleration = HoverSpring.SolveAcceleration(-Error, HeightRate, DeltaTime);
+                float OutputForce = FMath::Max(0.f, PointMass * (HoldAcceleration + SpringAcceleration));
+                HullMesh->AddForceAtLocation(ForceDirection * OutputForce, StartLocation);
+
+                PIDState.PreviousError = Error;
+                continue;
+            }
+
             // Integral term (with anti-windup, though not explicitly shown here, Ki should be tuned)
             PIDState.IntegralTerm += Error * DeltaTime;
             PIDState.IntegralTerm = FMath::Clamp(PIDState.IntegralTerm, -200.0f, 200.0f); // Clamp integral term
@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "HoverSpringSolver.h"
+#include "PodGroundProbe.h"
+#include "PodHoverQuerySubsystem.h"
 #include "HoverRacerPawn.generated.h"
 
 class UStaticMeshComponent;
@@ -33,7 +36,7 @@ struct FPIDControllerState
 };
 
 UCLASS(Blueprintable)
-class PROJECTPODRACER_API AHoverRacerPawn : public APawn
+class PROJECTPODRACER_API AHoverRacerPawn : public APawn, public IPodHoverRaySource
 {
     GENERATED_BODY()
 
@@ -42,11 +45,15 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     virtual void Tick(float DeltaTime) override;
     virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+    // IPodHoverRaySource
+    virtual void GatherHoverRays(FPodGroundRayBatch& Batch) override;
+
     // --- Components ---
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -72,6 +79,13 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Physics|PID")
     float HoverPidKd; // Derivative gain
 
+    // Use the implicit spring instead of the per-point PID, stays stable at low server tick rates
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Physics|Spring")
+    bool bUseImplicitHoverSpring;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Physics|Spring", meta = (EditCondition = "bUseImplicitHoverSpring"))
+    FHoverSpringSolver HoverSpring;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Physics")
     float TargetHoverHeight; // Desired distance from the ground
 
@@ -120,6 +134,11 @@ private:
 
     // PID states for each hover point
     TArray<FPIDControllerState> HoverPointPIDStates;
+    // Cached ground contact for each hover point
+    TArray<FPodGroundContactCache> HoverPointGroundContacts;
+    // Where this pod's rays start in the hover batch, and the frame they were gathered
+    int32 HoverRayFirst = INDEX_NONE;
+    uint64 HoverRayFrame = 0;
     bool bIsGrounded; // Simple flag, true if any hover point hits ground
 
     // Input binding functions
@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+// Implicit (backward Euler) spring-damper for hover ride height. Unlike the explicit PID/spring updates it can't
+// overshoot into divergence when DeltaTime grows, so the same tuning holds from 240 Hz clients down to 15 Hz servers
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HoverSpringSolver.generated.h"
+
+USTRUCT(BlueprintType)
+struct FHoverSpringSolver
+{
+	GENERATED_BODY()
+
+	// Natural frequency of the ride height spring, independent of the body's mass
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spring", meta = (ClampMin = "0.01", Units = "Hz"))
+	float Frequency = 2.0f;
+
+	// 1 = critically damped, below 1 allows some bounce
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spring", meta = (ClampMin = "0.0"))
+	float DampingRatio = 1.0f;
+
+	// Output limit as a fraction of the full hover force
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spring", meta = (ClampMin = "0.0"))
+	float MaxOutput = 1.0f;
+
+	// Set by the owner before seeking: acceleration produced at 100% output, and the acceleration needed to hold
+	// the body at rest against its gravity
+	float FullOutputAcceleration = 0.0f;
+	float HoldAcceleration = 0.0f;
+
+public:
+	// Velocity after one implicit step of x'' = -Stiffness * x - Damping * x'. Displacement is measured from the rest
+	// position, Stiffness and Damping are per unit mass (1/s^2 and 1/s)
+	static float SolveRate(float Displacement, float Rate, float Stiffness, float Damping, float DeltaTime)
+	{
+		return (Rate - DeltaTime * Stiffness * Displacement) / (1.0f + DeltaTime * Damping + DeltaTime * DeltaTime * Stiffness);
+	}
+
+	// Spring acceleration to apply over DeltaTime to reach the implicit step's velocity
+	float SolveAcceleration(float Displacement, float Rate, float DeltaTime) const
+	{
+		if (DeltaTime <= KINDA_SMALL_NUMBER)
+		{
+			return 0.0f;
+		}
+		const float Omega = 2.0f * PI * Frequency;
+		const float NewRate = SolveRate(Displacement, Rate, Omega * Omega, 2.0f * DampingRatio * Omega, DeltaTime);
+		return (NewRate - Rate) / DeltaTime;
+	}
+
+	void SetOutputMapping(float InFullOutputAcceleration, float InHoldAcceleration)
+	{
+		FullOutputAcceleration = InFullOutputAcceleration;
+		HoldAcceleration = InHoldAcceleration;
+	}
+
+	// Converts a spring acceleration into a fraction of full hover force, including the gravity hold
+	float ToOutput(float SpringAcceleration) const
+	{
+		if (FullOutputAcceleration <= KINDA_SMALL_NUMBER)
+		{
+			return 0.0f;
+		}
+		return FMath::Clamp((HoldAcceleration + SpringAcceleration) / FullOutputAcceleration, -MaxOutput, MaxOutput);
+	}
+};
@@ -0,0 +1,239 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HoverSpringSolver.h"
+#include "PIDController.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HoverSpringSolverTests
+{
+	struct FSettleResult
+	{
+		// Furthest the body went past the rest height, positive above it
+		float Overshoot = 0.f;
+		float FinalDisplacement = 0.f;
+		bool bFinite = true;
+	};
+
+	// Drops the body from StartDisplacement at rest and steps it like the pods do: the spring acceleration goes through
+	// ToOutput, gravity is taken off again, then velocity and position are integrated. Without bClampOutput the hover
+	// force is unlimited, which leaves the spring itself as the only thing under test
+	static FSettleResult Settle(const FHoverSpringSolver& Solver, bool bClampOutput, float StartDisplacement, float DeltaTime, float Duration)
+	{
+		const float Gravity = Solver.HoldAcceleration;
+		FSettleResult Result;
+		float Displacement = StartDisplacement;
+		float Rate = 0.f;
+		for (float Time = 0.f; Time < Duration; Time += DeltaTime)
+		{
+			const float SpringAcceleration = Solver.SolveAcceleration(Displacement, Rate, DeltaTime);
+			const float Acceleration = bClampOutput
+				? Solver.ToOutput(SpringAcceleration) * Solver.FullOutputAcceleration - Gravity
+				: SpringAcceleration;
+			Rate += Acceleration * DeltaTime;
+			Displacement += Rate * DeltaTime;
+			Result.Overshoot = FMath::Max(Result.Overshoot, Displacement);
+			Result.bFinite &= FMath::IsFinite(Displacement);
+		}
+		Result.FinalDisplacement = Displacement;
+		return Result;
+	}
+
+	// Same drop through FPIDController::SeekSpring, which only sees heights and differences them for the rate. The
+	// body is stepped like DefaultEngine.ini's physics substepping: the tick's hover force held over substeps of at
+	// most 1/120 s, at most 8 of them
+	static FSettleResult SettleSeek(const FHoverSpringSolver& Spring, float StartDisplacement, float DeltaTime, float Duration)
+	{
+		constexpr float MaxSubstepDeltaTime = 1.f / 120.f;
+		constexpr int32 MaxSubsteps = 8;
+		const int32 Substeps = FMath::Clamp(FMath::CeilToInt(DeltaTime / MaxSubstepDeltaTime - UE_KINDA_SMALL_NUMBER), 1, MaxSubsteps);
+		const float SubstepDeltaTime = DeltaTime / Substeps;
+
+		FPIDController Controller;
+		Controller.bUseImplicitSpring = true;
+		Controller.bEnableDebugLogging = false;
+		Controller.Spring = Spring;
+
+		constexpr float RideHeight = 100.f;
+		FSettleResult Result;
+		float Height = RideHeight + StartDisplacement;
+		float Rate = 0.f;
+		for (float Time = 0.f; Time < Duration; Time += DeltaTime)
+		{
+			const float Output = Controller.SeekSpring(RideHeight, Height, DeltaTime);
+			const float Acceleration = Output * Spring.FullOutputAcceleration - Spring.HoldAcceleration;
+			for (int32 Substep = 0; Substep < Substeps; ++Substep)
+			{
+				Rate += Acceleration * SubstepDeltaTime;
+				Height += Rate * SubstepDeltaTime;
+			}
+			Result.Overshoot = FMath::Max(Result.Overshoot, Height - RideHeight);
+			Result.bFinite &= FMath::IsFinite(Height);
+		}
+		Result.FinalDisplacement = Height - RideHeight;
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHoverSpringSolverDeltaTimeSweepTest, "ProjectPodracer.HoverSpringSolver.DeltaTimeSweep",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// The same tuning from 240 Hz down to 15 Hz must stay finite, never overshoot more than the continuous spring would,
+// and settle at the same ride height
+bool FHoverSpringSolverDeltaTimeSweepTest::RunTest(const FString& Parameters)
+{
+	using namespace HoverSpringSolverTests;
+
+	constexpr float Gravity = 980.f;
+	constexpr float StartDisplacement = -50.f;
+	constexpr float Duration = 4.f;
+	const float TickRates[] = { 240.f, 120.f, 60.f, 30.f, 20.f, 15.f };
+	const float DampingRatios[] = { 1.f, 0.5f };
+	struct FSpringCase
+	{
+		float Frequency;
+		bool bClampOutput;
+	};
+	// The default pod tuning with and without the hover force limit, and a stiff spring past what an explicit step
+	// holds at 15 Hz. The stiff one is left unclamped: at 3g it saturates, and a saturated spring overshoots at any rate
+	const FSpringCase SpringCases[] = { { 2.f, false }, { 2.f, true }, { 10.f, false } };
+
+	for (const FSpringCase& SpringCase : SpringCases)
+	{
+		const float Frequency = SpringCase.Frequency;
+		for (const float DampingRatio : DampingRatios)
+		{
+			FHoverSpringSolver Solver;
+			Solver.Frequency = Frequency;
+			Solver.DampingRatio = DampingRatio;
+			Solver.SetOutputMapping(3.f * Gravity, Gravity);
+
+			// Peak overshoot of the continuous spring. The implicit step only adds damping, so it stays under this
+			const float ContinuousOvershoot = DampingRatio < 1.f
+				? FMath::Abs(StartDisplacement) * FMath::Exp(-DampingRatio * PI / FMath::Sqrt(1.f - DampingRatio * DampingRatio))
+				: 0.f;
+			const float OvershootBound = ContinuousOvershoot + 0.005f * FMath::Abs(StartDisplacement);
+
+			for (const float TickRate : TickRates)
+			{
+				const FSettleResult Result = Settle(Solver, SpringCase.bClampOutput, StartDisplacement, 1.f / TickRate, Duration);
+				const FString Case = FString::Printf(TEXT("%.0f Hz spring%s, damping %.1f, %.0f Hz tick"), Frequency,
+					SpringCase.bClampOutput ? TEXT(" (clamped)") : TEXT(""), DampingRatio, TickRate);
+
+				if (!TestTrue(FString::Printf(TEXT("%s stays finite"), *Case), Result.bFinite))
+				{
+					continue;
+				}
+				TestTrue(FString::Printf(TEXT("%s overshoots %.3f cm, at most %.3f"), *Case, Result.Overshoot, OvershootBound), Result.Overshoot <= OvershootBound);
+				TestTrue(FString::Printf(TEXT("%s settles at %.3f cm from the ride height"), *Case, Result.FinalDisplacement), FMath::Abs(Result.FinalDisplacement) <= 0.01f * FMath::Abs(StartDisplacement));
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHoverSpringSeekDeltaTimeSweepTest, "ProjectPodracer.HoverSpringSolver.SeekDeltaTimeSweep",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// FPIDController::SeekSpring from 240 Hz down to 15 Hz. With the default pod tuning it must stay within the continuous
+// spring's overshoot and settle at the ride height. Over substeps the differenced rate lags the body by up to half a
+// tick's velocity change, which a stiff spring at low rates turns into extra bounce, so that one only has to stay
+// bounded and still settle
+bool FHoverSpringSeekDeltaTimeSweepTest::RunTest(const FString& Parameters)
+{
+	using namespace HoverSpringSolverTests;
+
+	constexpr float Gravity = 980.f;
+	constexpr float StartDisplacement = -50.f;
+	constexpr float Duration = 8.f;
+	const float TickRates[] = { 240.f, 120.f, 60.f, 30.f, 20.f, 15.f };
+	const float DampingRatios[] = { 1.f, 0.5f };
+	struct FSpringCase
+	{
+		float Frequency;
+		float MaxOutput;
+		bool bStiff;
+	};
+	// The default pod tuning, and a stiff spring with enough force left that it never saturates
+	const FSpringCase SpringCases[] = { { 2.f, 1.f, false }, { 10.f, 1000.f, true } };
+
+	for (const FSpringCase& SpringCase : SpringCases)
+	{
+		for (const float DampingRatio : DampingRatios)
+		{
+			FHoverSpringSolver Spring;
+			Spring.Frequency = SpringCase.Frequency;
+			Spring.DampingRatio = DampingRatio;
+			Spring.MaxOutput = SpringCase.MaxOutput;
+			Spring.SetOutputMapping(3.f * Gravity, Gravity);
+
+			const float ContinuousOvershoot = DampingRatio < 1.f
+				? FMath::Abs(StartDisplacement) * FMath::Exp(-DampingRatio * PI / FMath::Sqrt(1.f - DampingRatio * DampingRatio))
+				: 0.f;
+			const float OvershootBound = SpringCase.bStiff
+				? FMath::Abs(StartDisplacement)
+				: ContinuousOvershoot + 0.005f * FMath::Abs(StartDisplacement);
+
+			for (const float TickRate : TickRates)
+			{
+				const FSettleResult Result = SettleSeek(Spring, StartDisplacement, 1.f / TickRate, Duration);
+				const FString Case = FString::Printf(TEXT("%.0f Hz seek, damping %.1f, %.0f Hz tick"), SpringCase.Frequency, DampingRatio, TickRate);
+
+				if (!TestTrue(FString::Printf(TEXT("%s stays finite"), *Case), Result.bFinite))
+				{
+					continue;
+				}
+				TestTrue(FString::Printf(TEXT("%s overshoots %.3f cm, at most %.3f"), *Case, Result.Overshoot, OvershootBound), Result.Overshoot <= OvershootBound);
+				TestTrue(FString::Printf(TEXT("%s settles at %.3f cm from the ride height"), *Case, Result.FinalDisplacement), FMath::Abs(Result.FinalDisplacement) <= 0.01f * FMath::Abs(StartDisplacement));
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHoverSpringVelocityStepSweepTest, "ProjectPodracer.HoverSpringSolver.VelocityStepSweep",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// UPodracerMovementComponent's implicit mode only changes the velocity with SolveRate and then moves with it. With its
+// default stiffness and damping that must hold from 240 Hz down to 15 Hz the way the acceleration form does
+bool FHoverSpringVelocityStepSweepTest::RunTest(const FString& Parameters)
+{
+	constexpr float Stiffness = 10.f;
+	constexpr float Damping = 5.f;
+	constexpr float StartDisplacement = -50.f;
+	constexpr float Duration = 4.f;
+	const float TickRates[] = { 240.f, 120.f, 60.f, 30.f, 20.f, 15.f };
+
+	const float DampingRatio = Damping / (2.f * FMath::Sqrt(Stiffness));
+	const float OvershootBound = FMath::Abs(StartDisplacement) * FMath::Exp(-DampingRatio * PI / FMath::Sqrt(1.f - DampingRatio * DampingRatio))
+		+ 0.005f * FMath::Abs(StartDisplacement);
+
+	for (const float TickRate : TickRates)
+	{
+		const float DeltaTime = 1.f / TickRate;
+		float Displacement = StartDisplacement;
+		float Rate = 0.f;
+		float Overshoot = 0.f;
+		bool bFinite = true;
+		for (float Time = 0.f; Time < Duration; Time += DeltaTime)
+		{
+			Rate = FHoverSpringSolver::SolveRate(Displacement, Rate, Stiffness, Damping, DeltaTime);
+			Displacement += Rate * DeltaTime;
+			Overshoot = FMath::Max(Overshoot, Displacement);
+			bFinite &= FMath::IsFinite(Displacement);
+		}
+
+		const FString Case = FString::Printf(TEXT("%.0f Hz tick"), TickRate);
+		if (!TestTrue(FString::Printf(TEXT("%s stays finite"), *Case), bFinite))
+		{
+			continue;
+		}
+		TestTrue(FString::Printf(TEXT("%s overshoots %.3f cm, at most %.3f"), *Case, Overshoot, OvershootBound), Overshoot <= OvershootBound);
+		TestTrue(FString::Printf(TEXT("%s settles at %.3f cm from the ride height"), *Case, Displacement), FMath::Abs(Displacement) <= 0.01f * FMath::Abs(StartDisplacement));
+	}
+	return true;
+}
+
+#endif
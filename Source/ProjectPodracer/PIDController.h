@@ -2,6 +2,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HoverSpringSolver.h"
 #include "PIDController.generated.h"
 
 USTRUCT(BlueprintType)
@@ -31,14 +32,28 @@ struct FPIDController
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PID|Debug")
 	bool bEnableDebugLogging = true;
+
+	// Replace the PID terms with an implicit spring-damper that stays stable at low tick rates (servers at 20-30 Hz).
+	// The owner has to call Spring.SetOutputMapping before seeking so the output can include the gravity hold
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PID|Spring")
+	bool bUseImplicitSpring = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PID|Spring", meta = (EditCondition = "bUseImplicitSpring"))
+	FHoverSpringSolver Spring;
 	
 	float Integral = 0.0f;
 	float LastProportional = 0.0f;
 	float LastOutput = 0.0f;
+	bool bSpringPrimed = false; // LastProportional holds a real sample, the spring rate can be differenced from it
 
 public:
 	float Seek(float SeekValue, float CurrentValue, float DeltaTime)
 	{
+		if (bUseImplicitSpring)
+		{
+			return SeekSpring(SeekValue, CurrentValue, DeltaTime);
+		}
+
 		float Error = SeekValue - CurrentValue;
 		float Derivative = 0.0f;
 		if (DeltaTime > KINDA_SMALL_NUMBER)
@@ -76,10 +91,35 @@ public:
 		*/
 	}
 
+	float SeekSpring(float SeekValue, float CurrentValue, float DeltaTime)
+	{
+		float Error = SeekValue - CurrentValue;
+		float Rate = 0.0f;
+		if (bSpringPrimed && DeltaTime > KINDA_SMALL_NUMBER)
+		{
+			Rate = (LastProportional - Error) / DeltaTime;
+		}
+		LastProportional = Error;
+		bSpringPrimed = true;
+
+		// No output smoothing here, the lag it adds is what makes the explicit loop ring at large steps
+		float Acceleration = Spring.SolveAcceleration(-Error, Rate, DeltaTime);
+		float Value = Spring.ToOutput(Acceleration);
+		LastOutput = Value;
+
+		if (bEnableDebugLogging)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Spring Seek: Error=%.1f, Rate=%.1f, Accel=%.1f, Output=%.3f"),
+				Error, Rate, Acceleration, Value);
+		}
+		return Value;
+	}
+
 	void Reset()
 	{
 		Integral = 0.0f;
 		LastProportional = 0.0f;
 		LastOutput = 0.0f;
+		bSpringPrimed = false;
 	}
 };
\ No newline at end of file
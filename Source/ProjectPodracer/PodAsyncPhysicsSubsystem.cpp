@@ -0,0 +1,187 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodAsyncPhysicsSubsystem.h"
+
+#include "PBDRigidsSolver.h"
+#include "Components/PrimitiveComponent.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+
+
+void FPodHoverSimCallback::OnPreSimulate_Internal()
+{
+	const FPodHoverAsyncInput* Input = GetConsumerInput_Internal();
+	const float DeltaTime = GetDeltaTime_Internal();
+	if (!Input || DeltaTime <= KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	TSet<Chaos::FSingleParticlePhysicsProxy*, DefaultKeyFuncs<Chaos::FSingleParticlePhysicsProxy*>, TInlineSetAllocator<16>> SeenProxies;
+
+	for (const FPodAsyncBodyInput& Body : Input->Bodies)
+	{
+		Chaos::FRigidBodyHandle_Internal* Handle = Body.Proxy ? Body.Proxy->GetPhysicsThreadAPI() : nullptr;
+		if (!Handle)
+		{
+			continue;
+		}
+		SeenProxies.Add(Body.Proxy);
+
+		const FVector Location = Handle->X();
+		const FQuat Rotation = Handle->R();
+		const FVector Velocity = Handle->V();
+		const float BodyMass = Handle->M();
+		const FVector Forward = Rotation.GetForwardVector();
+		const FVector Right = Rotation.GetRightVector();
+		const FVector CenterOfMass = Location + Rotation.RotateVector(Handle->CenterOfMass());
+
+		FVector Force = FVector::ZeroVector;
+		FVector Torque = FVector::ZeroVector;
+		auto AddForceAtLocation = [&](const FVector& PointForce, const FVector& Point)
+		{
+			Force += PointForce;
+			Torque += FVector::CrossProduct(Point - CenterOfMass, PointForce);
+		};
+
+		// Re-measure the height against the published ground plane so the hover responds within the frame
+		const float Height = FVector::DotProduct(Location - Body.GroundPoint, Body.GroundNormal);
+		const bool bOnGround = Body.bOnGround && Height <= Body.MaxGroundDist;
+
+		FHoverState& State = HoverStates.FindOrAdd(Body.Proxy);
+		FPIDController HoverPID = Body.HoverPID;
+		HoverPID.bEnableDebugLogging = false;
+		HoverPID.Integral = State.Integral;
+		HoverPID.LastProportional = State.LastProportional;
+		HoverPID.LastOutput = State.LastOutput;
+		HoverPID.bSpringPrimed = State.bSpringPrimed;
+		if (Body.bResetPIDOnLanding && bOnGround && !State.bWasOnGround)
+		{
+			HoverPID.Reset();
+		}
+
+		if (bOnGround)
+		{
+			float ForcePercent = HoverPID.Seek(Body.HoverHeight, Height, DeltaTime);
+			if (Height > Body.HoverHeight)
+			{
+				ForcePercent *= Body.DescentForceScale;
+			}
+			for (const FPodAsyncForcePoint& Point : Body.ForcePoints)
+			{
+				AddForceAtLocation(Body.GroundNormal * Point.HoverForce * ForcePercent, Location + Rotation.RotateVector(Point.LocalOffset));
+			}
+			Force += -Body.GroundNormal * Body.HoverGravity * BodyMass;
+		}
+		else
+		{
+			Force += -Body.GroundNormal * Body.FallGravity * BodyMass;
+		}
+
+		State.Integral = HoverPID.Integral;
+		State.LastProportional = HoverPID.LastProportional;
+		State.LastOutput = HoverPID.LastOutput;
+		State.bSpringPrimed = HoverPID.bSpringPrimed;
+		State.bWasOnGround = bOnGround;
+
+		// Thrust
+		const float ThrustScale = bOnGround ? 1.f : Body.AirborneThrustScale;
+		if (ThrustScale != 0.f)
+		{
+			for (const FPodAsyncForcePoint& Point : Body.ForcePoints)
+			{
+				if (Point.ThrustForce != 0.f)
+				{
+					AddForceAtLocation(Forward * Point.ThrustForce * ThrustScale, Location + Rotation.RotateVector(Point.LocalOffset));
+				}
+			}
+		}
+		if (bOnGround && Body.Drag > 0.f)
+		{
+			const float ForwardSpeed = FVector::DotProduct(Velocity, Forward);
+			Force -= Forward * Body.Drag * FMath::Clamp(ForwardSpeed, 0.f, Body.DragSpeedCap);
+		}
+
+		// Side friction
+		const float SidewaysSpeed = FVector::DotProduct(Velocity, Right);
+		const float SideGrip = Body.bSideGripPerStep ? Body.SideGrip / DeltaTime : Body.SideGrip;
+		Force -= Right * SidewaysSpeed * SideGrip;
+
+		Handle->AddForce(Force);
+		Handle->AddTorque(Torque);
+	}
+
+	// Drop state for pods that stopped publishing (destroyed or switched back to game thread forces)
+	for (auto It = HoverStates.CreateIterator(); It; ++It)
+	{
+		if (!SeenProxies.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+
+UPodAsyncPhysicsSubsystem* UPodAsyncPhysicsSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UPodAsyncPhysicsSubsystem>() : nullptr;
+}
+
+bool UPodAsyncPhysicsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPodAsyncPhysicsSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (FPhysScene* PhysScene = InWorld.GetPhysicsScene())
+	{
+		if (Chaos::FPhysicsSolver* Solver = PhysScene->GetSolver())
+		{
+			HoverCallback = Solver->CreateAndRegisterSimCallbackObject_External<FPodHoverSimCallback>();
+		}
+	}
+}
+
+void UPodAsyncPhysicsSubsystem::Deinitialize()
+{
+	if (HoverCallback)
+	{
+		if (FPhysScene* PhysScene = GetWorld()->GetPhysicsScene())
+		{
+			if (Chaos::FPhysicsSolver* Solver = PhysScene->GetSolver())
+			{
+				Solver->UnregisterAndFreeSimCallbackObject_External(HoverCallback);
+			}
+		}
+		HoverCallback = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+bool UPodAsyncPhysicsSubsystem::CanPublishBodyInput(const UPrimitiveComponent* Body) const
+{
+	if (!HoverCallback || !Body || !Body->IsSimulatingPhysics())
+	{
+		return false;
+	}
+
+	const FBodyInstance* BodyInstance = Body->GetBodyInstance();
+	return BodyInstance && BodyInstance->GetPhysicsActorHandle();
+}
+
+bool UPodAsyncPhysicsSubsystem::PublishBodyInput(UPrimitiveComponent* Body, FPodAsyncBodyInput&& BodyInput)
+{
+	if (!CanPublishBodyInput(Body))
+	{
+		return false;
+	}
+
+	BodyInput.Proxy = Body->GetBodyInstance()->GetPhysicsActorHandle();
+	HoverCallback->GetProducerInputData_External()->Bodies.Add(MoveTemp(BodyInput));
+	return true;
+}
@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PIDController.h"
+#include "Chaos/SimCallbackInput.h"
+#include "Chaos/SimCallbackObject.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PodAsyncPhysicsSubsystem.generated.h"
+
+namespace Chaos
+{
+	class FSingleParticlePhysicsProxy;
+}
+
+class UPrimitiveComponent;
+
+// A point on the body that receives hover and/or thrust force, relative to the body transform
+struct FPodAsyncForcePoint
+{
+	FVector LocalOffset = FVector::ZeroVector;
+	// Force at 100% hover output, scaled by the PID result every substep
+	float HoverForce = 0.f;
+	// Forward force with the player's input already applied
+	float ThrustForce = 0.f;
+};
+
+// Everything the physics thread needs to drive one pod body until the next game frame publishes again
+struct FPodAsyncBodyInput
+{
+	Chaos::FSingleParticlePhysicsProxy* Proxy = nullptr;
+
+	// Ground plane found by the game thread trace
+	FVector GroundPoint = FVector::ZeroVector;
+	FVector GroundNormal = FVector::UpVector;
+	bool bOnGround = false;
+
+	float HoverHeight = 100.f;
+	float MaxGroundDist = 500.f;
+	// Hover output is scaled by this while above HoverHeight (softer descent)
+	float DescentForceScale = 1.f;
+	bool bResetPIDOnLanding = false;
+	// Gains only, the integrator state lives on the physics thread
+	FPIDController HoverPID;
+
+	// Accelerations in cm/s^2, multiplied by the body mass on the physics thread
+	float HoverGravity = 2000.f;
+	float FallGravity = 9810.f;
+
+	TArray<FPodAsyncForcePoint, TInlineAllocator<4>> ForcePoints;
+	// Thrust multiplier while airborne (0 disables thrust off the ground)
+	float AirborneThrustScale = 1.f;
+	// Forward drag (N per cm/s) and the speed at which it stops growing, only applied on the ground
+	float Drag = 0.f;
+	float DragSpeedCap = 0.f;
+
+	// Side friction force per cm/s of sideways speed. When bSideGripPerStep is set it is divided by the substep DeltaTime
+	float SideGrip = 0.f;
+	bool bSideGripPerStep = false;
+};
+
+struct FPodHoverAsyncInput : public Chaos::FSimCallbackInput
+{
+	TArray<FPodAsyncBodyInput> Bodies;
+
+	void Reset()
+	{
+		Bodies.Reset();
+	}
+};
+
+// Evaluates hover, thrust and side friction for every published pod on each physics substep
+class FPodHoverSimCallback : public Chaos::TSimCallbackObject<FPodHoverAsyncInput, Chaos::FSimCallbackNoOutput>
+{
+private:
+	virtual void OnPreSimulate_Internal() override;
+
+	// PID integrator state per body, only touched on the physics thread
+	struct FHoverState
+	{
+		float Integral = 0.f;
+		float LastProportional = 0.f;
+		float LastOutput = 0.f;
+		bool bSpringPrimed = false;
+		bool bWasOnGround = false;
+	};
+	TMap<Chaos::FSingleParticlePhysicsProxy*, FHoverState> HoverStates;
+};
+
+/**
+ * Owns the hover sim callback for a game world. Pods publish an FPodAsyncBodyInput every game frame instead of
+ * calling AddForce themselves, so the forces track the body through every physics substep.
+ */
+UCLASS()
+class PROJECTPODRACER_API UPodAsyncPhysicsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UPodAsyncPhysicsSubsystem* Get(const UWorld* World);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	bool IsActive() const { return HoverCallback != nullptr; }
+
+	// Whether the callback can take the body's input this frame: it has to be simulating and have a physics proxy.
+	// Pods check this before computing their forces, since a pod that publishes skips its own AddForce calls
+	bool CanPublishBodyInput(const UPrimitiveComponent* Body) const;
+
+	// Queues the body's input for the next physics step. Returns false when CanPublishBodyInput doesn't hold, in which
+	// case the caller should apply its forces on the game thread as before
+	bool PublishBodyInput(UPrimitiveComponent* Body, FPodAsyncBodyInput&& BodyInput);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FPodHoverSimCallback* HoverCallback = nullptr;
+};
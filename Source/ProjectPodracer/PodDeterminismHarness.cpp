@@ -0,0 +1,696 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodDeterminismHarness.h"
+
+#if WITH_POD_DETERMINISM_HARNESS
+
+#include "PodMovementComponent.h"
+#include "PodVehicleMovementComponent.h"
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+#include "Engine/Engine.h"
+#include "Misc/AutomationTest.h"
+#include "PodTestWorld.h"
+#include "ReplicatedPodRacer.h"
+
+bool FPodDeterminismHarness::bRecording = false;
+int32 FPodDeterminismHarness::CorrectionReplayDepth = 0;
+
+namespace PodDeterminism
+{
+	static const uint32 FileMagic = 0x50445231; // "PDR1"
+	static const int32 FileVersion = 1;
+
+	enum class ETarget : uint8
+	{
+		None,
+		PodMovement,
+		PodVehicleMovement
+	};
+
+	enum EStateFlags : uint8
+	{
+		Flag_OnGround = 1 << 0,
+		Flag_WasOnGroundLastFrame = 1 << 1,
+		Flag_DriftingLastFrame = 1 << 2,
+	};
+
+	// Field names used when reporting a divergence, in FState hashing order
+	static const TCHAR* FieldNames[] = { TEXT("Location"), TEXT("Rotation"), TEXT("LinearVelocity"), TEXT("AngularVelocity"), TEXT("GroundNormal"), TEXT("DriftVelocity"), TEXT("Scalar"), TEXT("Flags") };
+	static constexpr int32 NumFields = UE_ARRAY_COUNT(FieldNames);
+}
+
+struct FPodDeterminismHarness::FState
+{
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector LinearVelocity = FVector::ZeroVector;
+	// UPodVehicleMovementComponent only tracks yaw velocity, stored in Z
+	FVector AngularVelocity = FVector::ZeroVector;
+	FVector GroundNormal = FVector::UpVector;
+	FVector DriftVelocity = FVector::ZeroVector;
+	// Hover height for UPodMovementComponent, drift duration for UPodVehicleMovementComponent
+	float Scalar = 0.f;
+	uint8 Flags = 0;
+
+	// Hashes the exact bit patterns so any last-bit difference is reported
+	void HashFields(uint32 (&OutHashes)[PodDeterminism::NumFields]) const
+	{
+		OutHashes[0] = FCrc::MemCrc32(&Location, sizeof(Location));
+		OutHashes[1] = FCrc::MemCrc32(&Rotation, sizeof(Rotation));
+		OutHashes[2] = FCrc::MemCrc32(&LinearVelocity, sizeof(LinearVelocity));
+		OutHashes[3] = FCrc::MemCrc32(&AngularVelocity, sizeof(AngularVelocity));
+		OutHashes[4] = FCrc::MemCrc32(&GroundNormal, sizeof(GroundNormal));
+		OutHashes[5] = FCrc::MemCrc32(&DriftVelocity, sizeof(DriftVelocity));
+		OutHashes[6] = FCrc::MemCrc32(&Scalar, sizeof(Scalar));
+		OutHashes[7] = FCrc::MemCrc32(&Flags, sizeof(Flags));
+	}
+
+	FString DescribeField(int32 FieldIndex) const
+	{
+		switch (FieldIndex)
+		{
+		case 0: return Location.ToString();
+		case 1: return Rotation.ToString();
+		case 2: return LinearVelocity.ToString();
+		case 3: return AngularVelocity.ToString();
+		case 4: return GroundNormal.ToString();
+		case 5: return DriftVelocity.ToString();
+		case 6: return FString::Printf(TEXT("%.9g"), Scalar);
+		default: return FString::Printf(TEXT("0x%02x"), Flags);
+		}
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FState& State)
+	{
+		return Ar << State.Location << State.Rotation << State.LinearVelocity << State.AngularVelocity << State.GroundNormal << State.DriftVelocity << State.Scalar << State.Flags;
+	}
+};
+
+struct FPodDeterminismHarness::FMove
+{
+	float DeltaTime = 0.f;
+	float ThrottleInput = 0.f;
+	float SteerInput = 0.f;
+	bool bIsBraking = false;
+	bool bIsDrifting = false;
+	bool bIsBoosting = false;
+
+	friend FArchive& operator<<(FArchive& Ar, FMove& Move)
+	{
+		return Ar << Move.DeltaTime << Move.ThrottleInput << Move.SteerInput << Move.bIsBraking << Move.bIsDrifting << Move.bIsBoosting;
+	}
+};
+
+struct FPodDeterminismHarness::FRecording
+{
+	TWeakObjectPtr<UActorComponent> Component;
+	PodDeterminism::ETarget Target = PodDeterminism::ETarget::None;
+	bool bHasInitialState = false;
+	FState InitialState;
+	TArray<FMove> Moves;
+	int32 MaxSteps = 0;
+};
+
+namespace PodDeterminism
+{
+	struct FStepHashes
+	{
+		uint32 Fields[NumFields];
+
+		friend FArchive& operator<<(FArchive& Ar, FStepHashes& Step)
+		{
+			for (uint32& Hash : Step.Fields)
+			{
+				Ar << Hash;
+			}
+			return Ar;
+		}
+	};
+
+	static FPodDeterminismHarness::FRecording Recording;
+	static bool bReplaying = false;
+
+	static UActorComponent* FindLocalPodComponent(UWorld* World, ETarget& OutTarget)
+	{
+		OutTarget = ETarget::None;
+		APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			return nullptr;
+		}
+		if (UPodMovementComponent* PodMovement = Pawn->FindComponentByClass<UPodMovementComponent>())
+		{
+			OutTarget = ETarget::PodMovement;
+			return PodMovement;
+		}
+		if (UPodVehicleMovementComponent* PodVehicleMovement = Pawn->FindComponentByClass<UPodVehicleMovementComponent>())
+		{
+			OutTarget = ETarget::PodVehicleMovement;
+			return PodVehicleMovement;
+		}
+		return nullptr;
+	}
+
+	static FString GetRecordingPath(const FString& Name)
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Determinism") / (Name + TEXT(".pdr"));
+	}
+}
+
+void FPodDeterminismHarness::NotifySimulateMove(UPodMovementComponent* Component, const FPodRacerMoveStruct& Move)
+{
+	using namespace PodDeterminism;
+	if (!bRecording || bReplaying || CorrectionReplayDepth > 0 || Recording.Component.Get() != Component)
+	{
+		return;
+	}
+
+	if (!Recording.bHasInitialState)
+	{
+		CaptureState(Component, Recording.InitialState);
+		Recording.bHasInitialState = true;
+	}
+
+	FMove& Recorded = Recording.Moves.AddDefaulted_GetRef();
+	Recorded.DeltaTime = Move.DeltaTime;
+	Recorded.ThrottleInput = Move.ThrusterInput;
+	Recorded.SteerInput = Move.RudderInput;
+	Recorded.bIsBraking = Move.bIsBraking;
+	Recorded.bIsDrifting = Move.bIsDrifting;
+	Recorded.bIsBoosting = Move.bIsBoosting;
+
+	if (Recording.Moves.Num() >= Recording.MaxSteps)
+	{
+		bRecording = false;
+		UE_LOG(LogTemp, Display, TEXT("Pod.Determinism: Recorded %d moves from %s"), Recording.Moves.Num(), *Component->GetOwner()->GetName());
+	}
+}
+
+void FPodDeterminismHarness::NotifyApplyMovementLogic(UPodVehicleMovementComponent* Component, float InMoveForwardInput, float InTurnRightInput,
+	bool InIsBoosting, bool InIsBraking, bool InIsDrifting, float InDeltaTime,
+	const FVector& InVelocity, const FRotator& InRotation, float InAngularYawVelocity)
+{
+	using namespace PodDeterminism;
+	if (!bRecording || bReplaying || CorrectionReplayDepth > 0 || Recording.Component.Get() != Component)
+	{
+		return;
+	}
+
+	if (!Recording.bHasInitialState)
+	{
+		// Use the values actually fed into this step, they can differ from the component's members during a replay
+		CaptureState(Component, Recording.InitialState);
+		Recording.InitialState.Rotation = InRotation.Quaternion();
+		Recording.InitialState.LinearVelocity = InVelocity;
+		Recording.InitialState.AngularVelocity = FVector(0.f, 0.f, InAngularYawVelocity);
+		Recording.bHasInitialState = true;
+	}
+
+	FMove& Recorded = Recording.Moves.AddDefaulted_GetRef();
+	Recorded.DeltaTime = InDeltaTime;
+	Recorded.ThrottleInput = InMoveForwardInput;
+	Recorded.SteerInput = InTurnRightInput;
+	Recorded.bIsBraking = InIsBraking;
+	Recorded.bIsDrifting = InIsDrifting;
+	Recorded.bIsBoosting = InIsBoosting;
+
+	if (Recording.Moves.Num() >= Recording.MaxSteps)
+	{
+		bRecording = false;
+		UE_LOG(LogTemp, Display, TEXT("Pod.Determinism: Recorded %d moves from %s"), Recording.Moves.Num(), *Component->GetOwner()->GetName());
+	}
+}
+
+void FPodDeterminismHarness::CaptureState(UPodMovementComponent* Component, FState& OutState)
+{
+	UBoxComponent* PhysicsBody = Component->GetPhysicsBody();
+	if (!PhysicsBody)
+	{
+		return;
+	}
+	OutState.Location = PhysicsBody->GetComponentLocation();
+	OutState.Rotation = PhysicsBody->GetComponentQuat();
+	OutState.LinearVelocity = PhysicsBody->GetPhysicsLinearVelocity();
+	OutState.AngularVelocity = PhysicsBody->GetPhysicsAngularVelocityInRadians();
+	OutState.GroundNormal = Component->GroundNormal;
+	OutState.DriftVelocity = FVector::ZeroVector;
+	OutState.Scalar = Component->Height;
+	OutState.Flags = (Component->bIsOnGround ? PodDeterminism::Flag_OnGround : 0) | (Component->bWasOnGroundLastFrame ? PodDeterminism::Flag_WasOnGroundLastFrame : 0);
+}
+
+void FPodDeterminismHarness::RestoreState(UPodMovementComponent* Component, const FState& State)
+{
+	UBoxComponent* PhysicsBody = Component->GetPhysicsBody();
+	if (!PhysicsBody)
+	{
+		return;
+	}
+	PhysicsBody->SetWorldLocationAndRotation(State.Location, State.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	PhysicsBody->SetPhysicsLinearVelocity(State.LinearVelocity, false);
+	PhysicsBody->SetPhysicsAngularVelocityInRadians(State.AngularVelocity, false);
+	Component->GroundNormal = State.GroundNormal;
+	Component->Height = State.Scalar;
+	Component->bIsOnGround = (State.Flags & PodDeterminism::Flag_OnGround) != 0;
+	Component->bWasOnGroundLastFrame = (State.Flags & PodDeterminism::Flag_WasOnGroundLastFrame) != 0;
+}
+
+void FPodDeterminismHarness::StepMove(UPodMovementComponent* Component, const FMove& Move)
+{
+	UBoxComponent* PhysicsBody = Component->GetPhysicsBody();
+	if (!PhysicsBody)
+	{
+		return;
+	}
+
+	FPodRacerMoveStruct PodMove;
+	PodMove.DeltaTime = Move.DeltaTime;
+	PodMove.ThrusterInput = Move.ThrottleInput;
+	PodMove.RudderInput = Move.SteerInput;
+	PodMove.bIsBraking = Move.bIsBraking;
+	PodMove.bIsDrifting = Move.bIsDrifting;
+	PodMove.bIsBoosting = Move.bIsBoosting;
+
+	// SimulateMove logs every step when enabled
+	TGuardValue<bool> LoggingGuard(Component->bEnableDebugLogging, false);
+	Component->ApplyHover(Move.DeltaTime, PhysicsBody, false);
+	Component->SimulateMove(PodMove);
+
+	// No physics step runs inside a replay, advance the body with the velocity SimulateMove produced
+	const FVector NewLocation = PhysicsBody->GetComponentLocation() + PhysicsBody->GetPhysicsLinearVelocity() * Move.DeltaTime;
+	PhysicsBody->SetWorldLocation(NewLocation, false, nullptr, ETeleportType::TeleportPhysics);
+}
+
+void FPodDeterminismHarness::CaptureState(UPodVehicleMovementComponent* Component, FState& OutState)
+{
+	OutState.Location = Component->UpdatedComponent->GetComponentLocation();
+	OutState.Rotation = Component->UpdatedComponent->GetComponentQuat();
+	OutState.LinearVelocity = Component->Velocity;
+	OutState.AngularVelocity = FVector(0.f, 0.f, Component->CurrentAngularYawVelocity);
+	OutState.GroundNormal = FVector::UpVector;
+	OutState.DriftVelocity = Component->DriftOriginalVelocity;
+	OutState.Scalar = Component->DriftDuration;
+	OutState.Flags = Component->bIsDriftingLastFrame ? PodDeterminism::Flag_DriftingLastFrame : 0;
+}
+
+void FPodDeterminismHarness::RestoreState(UPodVehicleMovementComponent* Component, const FState& State)
+{
+	Component->UpdatedComponent->SetWorldLocationAndRotation(State.Location, State.Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	Component->Velocity = State.LinearVelocity;
+	Component->CurrentAngularYawVelocity = State.AngularVelocity.Z;
+	Component->DriftOriginalVelocity = State.DriftVelocity;
+	Component->DriftDuration = State.Scalar;
+	Component->bIsDriftingLastFrame = (State.Flags & PodDeterminism::Flag_DriftingLastFrame) != 0;
+}
+
+void FPodDeterminismHarness::StepMove(UPodVehicleMovementComponent* Component, const FMove& Move)
+{
+	// Mirrors the authority path in TickComponent, which feeds the component's own Velocity through the step
+	FRotator NewRotation = Component->UpdatedComponent->GetComponentRotation();
+	Component->ApplyMovementLogic(Move.ThrottleInput, Move.SteerInput, Move.bIsBoosting, Move.bIsBraking, Move.bIsDrifting, Move.DeltaTime,
+		Component->Velocity, NewRotation, Component->CurrentAngularYawVelocity);
+}
+
+namespace PodDeterminism
+{
+	// Replays Recording from its initial state and returns the per-step hashes (and optionally full states). Restores the live state afterwards.
+	static bool Replay(const FPodDeterminismHarness::FRecording& InRecording, UActorComponent* Component, TArray<FStepHashes>& OutHashes, TArray<FPodDeterminismHarness::FState>* OutStates)
+	{
+		if (!Component || InRecording.Target == ETarget::None)
+		{
+			return false;
+		}
+
+		TGuardValue<bool> ReplayGuard(bReplaying, true);
+		OutHashes.Reset(InRecording.Moves.Num());
+
+		auto Run = [&](auto* Typed)
+		{
+			FPodDeterminismHarness::FState LiveState;
+			FPodDeterminismHarness::CaptureState(Typed, LiveState);
+			FPodDeterminismHarness::RestoreState(Typed, InRecording.InitialState);
+
+			for (const FPodDeterminismHarness::FMove& Move : InRecording.Moves)
+			{
+				FPodDeterminismHarness::StepMove(Typed, Move);
+
+				FPodDeterminismHarness::FState StepState;
+				FPodDeterminismHarness::CaptureState(Typed, StepState);
+				StepState.HashFields(OutHashes.AddDefaulted_GetRef().Fields);
+				if (OutStates)
+				{
+					OutStates->Add(StepState);
+				}
+			}
+
+			FPodDeterminismHarness::RestoreState(Typed, LiveState);
+		};
+
+		if (InRecording.Target == ETarget::PodMovement)
+		{
+			UPodMovementComponent* PodMovement = Cast<UPodMovementComponent>(Component);
+			if (!PodMovement)
+			{
+				return false;
+			}
+			Run(PodMovement);
+		}
+		else
+		{
+			UPodVehicleMovementComponent* PodVehicleMovement = Cast<UPodVehicleMovementComponent>(Component);
+			if (!PodVehicleMovement)
+			{
+				return false;
+			}
+			Run(PodVehicleMovement);
+		}
+		return true;
+	}
+
+	// Returns the first step index that differs and the field that differs in it, or INDEX_NONE if the runs match
+	static int32 FindFirstDivergence(const TArray<FStepHashes>& A, const TArray<FStepHashes>& B, int32& OutField)
+	{
+		OutField = INDEX_NONE;
+		const int32 NumSteps = FMath::Min(A.Num(), B.Num());
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			for (int32 Field = 0; Field < NumFields; ++Field)
+			{
+				if (A[Step].Fields[Field] != B[Step].Fields[Field])
+				{
+					OutField = Field;
+					return Step;
+				}
+			}
+		}
+		return A.Num() != B.Num() ? NumSteps : INDEX_NONE;
+	}
+
+	static UActorComponent* GetReplayComponent(UWorld* World)
+	{
+		ETarget Target = ETarget::None;
+		UActorComponent* Component = Recording.Component.Get();
+		if (!Component)
+		{
+			Component = FindLocalPodComponent(World, Target);
+		}
+		if (!Component || Recording.Moves.Num() == 0 || !Recording.bHasInitialState)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Pod.Determinism: Nothing to replay, run Pod.Determinism.Record first"));
+			return nullptr;
+		}
+		if (bRecording)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Pod.Determinism: Still recording (%d/%d moves)"), Recording.Moves.Num(), Recording.MaxSteps);
+			return nullptr;
+		}
+		return Component;
+	}
+
+	static void RecordCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		ETarget Target = ETarget::None;
+		UActorComponent* Component = FindLocalPodComponent(World, Target);
+		if (!Component)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Pod.Determinism.Record: The local player pawn has no pod movement component"));
+			return;
+		}
+
+		Recording = FPodDeterminismHarness::FRecording();
+		Recording.Component = Component;
+		Recording.Target = Target;
+		Recording.MaxSteps = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 300;
+		FPodDeterminismHarness::bRecording = true;
+		UE_LOG(LogTemp, Display, TEXT("Pod.Determinism.Record: Recording %d moves from %s"), Recording.MaxSteps, *Component->GetOwner()->GetName());
+	}
+
+	static void VerifyCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		UActorComponent* Component = GetReplayComponent(World);
+		if (!Component)
+		{
+			return;
+		}
+
+		TArray<FStepHashes> FirstHashes, SecondHashes;
+		TArray<FPodDeterminismHarness::FState> FirstStates, SecondStates;
+		Replay(Recording, Component, FirstHashes, &FirstStates);
+		Replay(Recording, Component, SecondHashes, &SecondStates);
+
+		int32 Field = INDEX_NONE;
+		const int32 Step = FindFirstDivergence(FirstHashes, SecondHashes, Field);
+		if (Step == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Display, TEXT("Pod.Determinism.Verify: %d steps replayed twice, identical"), FirstHashes.Num());
+		}
+		else if (Field == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Pod.Determinism.Verify: Step counts differ (%d vs %d)"), FirstHashes.Num(), SecondHashes.Num());
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("Pod.Determinism.Verify: First divergence at step %d, field %s: %s vs %s"),
+				Step, FieldNames[Field], *FirstStates[Step].DescribeField(Field), *SecondStates[Step].DescribeField(Field));
+		}
+	}
+
+	static void SaveCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		UActorComponent* Component = GetReplayComponent(World);
+		if (!Component || Args.Num() == 0)
+		{
+			UE_CLOG(Args.Num() == 0, LogTemp, Warning, TEXT("Pod.Determinism.Save: Usage Pod.Determinism.Save <Name>"));
+			return;
+		}
+
+		TArray<FStepHashes> Hashes;
+		Replay(Recording, Component, Hashes, nullptr);
+
+		FBufferArchive Writer;
+		uint32 Magic = FileMagic;
+		int32 Version = FileVersion;
+		uint8 Target = static_cast<uint8>(Recording.Target);
+		Writer << Magic << Version << Target << Recording.InitialState << Recording.Moves << Hashes;
+
+		const FString Path = GetRecordingPath(Args[0]);
+		if (FFileHelper::SaveArrayToFile(Writer, *Path))
+		{
+			UE_LOG(LogTemp, Display, TEXT("Pod.Determinism.Save: Wrote %d steps to %s"), Hashes.Num(), *Path);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("Pod.Determinism.Save: Could not write %s"), *Path);
+		}
+	}
+
+	static void CompareCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Pod.Determinism.Compare: Usage Pod.Determinism.Compare <Name>"));
+			return;
+		}
+
+		const FString Path = GetRecordingPath(Args[0]);
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Pod.Determinism.Compare: Could not read %s"), *Path);
+			return;
+		}
+
+		FMemoryReader Reader(Bytes);
+		uint32 Magic = 0;
+		int32 Version = 0;
+		uint8 Target = 0;
+		Reader << Magic << Version;
+		if (Magic != FileMagic || Version != FileVersion)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Pod.Determinism.Compare: %s is not a version %d recording"), *Path, FileVersion);
+			return;
+		}
+
+		FPodDeterminismHarness::FRecording Loaded;
+		TArray<FStepHashes> SavedHashes;
+		Reader << Target << Loaded.InitialState << Loaded.Moves << SavedHashes;
+		Loaded.Target = static_cast<ETarget>(Target);
+		Loaded.bHasInitialState = true;
+
+		ETarget LocalTarget = ETarget::None;
+		UActorComponent* Component = FindLocalPodComponent(World, LocalTarget);
+		if (!Component || LocalTarget != Loaded.Target)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Pod.Determinism.Compare: The local player pawn doesn't use the movement component this recording was made with"));
+			return;
+		}
+
+		TArray<FStepHashes> LocalHashes;
+		TArray<FPodDeterminismHarness::FState> LocalStates;
+		Replay(Loaded, Component, LocalHashes, &LocalStates);
+
+		int32 Field = INDEX_NONE;
+		const int32 Step = FindFirstDivergence(SavedHashes, LocalHashes, Field);
+		if (Step == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Display, TEXT("Pod.Determinism.Compare: %d steps match %s"), LocalHashes.Num(), *Path);
+		}
+		else if (Field == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Pod.Determinism.Compare: Step counts differ (%d saved vs %d local)"), SavedHashes.Num(), LocalHashes.Num());
+		}
+		else
+		{
+			// Only hashes are stored in the file, so just the local value can be shown
+			UE_LOG(LogTemp, Error, TEXT("Pod.Determinism.Compare: First divergence at step %d, field %s (local value %s)"),
+				Step, FieldNames[Field], *LocalStates[Step].DescribeField(Field));
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs RecordCmd(
+		TEXT("Pod.Determinism.Record"),
+		TEXT("Record the local pod's next N moves (default 300) for determinism checks"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RecordCommand));
+
+	static FAutoConsoleCommandWithWorldAndArgs VerifyCmd(
+		TEXT("Pod.Determinism.Verify"),
+		TEXT("Replay the recorded moves twice from the same initial state and report the first divergent step and field"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&VerifyCommand));
+
+	static FAutoConsoleCommandWithWorldAndArgs SaveCmd(
+		TEXT("Pod.Determinism.Save"),
+		TEXT("Replay the recording and save inputs, initial state and per-step hashes to Saved/Determinism/<Name>.pdr"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SaveCommand));
+
+	static FAutoConsoleCommandWithWorldAndArgs CompareCmd(
+		TEXT("Pod.Determinism.Compare"),
+		TEXT("Replay Saved/Determinism/<Name>.pdr (e.g. saved by a server build) on the local pod and compare per-step hashes"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&CompareCommand));
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PodDeterminism
+{
+	// Records a scripted run of Movement through the live hooks, then replays it twice the way Pod.Determinism.Verify
+	// does. Partway through, a few moves are simulated again as a server correction would, and must stay out of the
+	// recording. The two replays must hash the same at every step, and the pod must be back where the live run left it
+	template <typename ComponentType>
+	static void TestRecordAndReplay(FAutomationTestBase& Test, ComponentType* Movement, ETarget Target)
+	{
+		auto ScriptedMove = [](int32 Step)
+		{
+			// Throttle, a weave, then a drift and a boost, so every branch of the step is covered
+			FPodDeterminismHarness::FMove Move;
+			Move.DeltaTime = Step % 3 == 0 ? 1.f / 30.f : 1.f / 60.f;
+			Move.ThrottleInput = 1.f;
+			Move.SteerInput = FMath::Sin(Step * 0.1f);
+			Move.bIsDrifting = Step >= 120 && Step < 180;
+			Move.bIsBoosting = Step >= 200;
+			Move.bIsBraking = Step >= 230;
+			return Move;
+		};
+
+		constexpr int32 NumSteps = 240;
+		constexpr int32 CorrectionStep = 100;
+		constexpr int32 CorrectedMoves = 5;
+		Recording = FPodDeterminismHarness::FRecording();
+		Recording.Component = Movement;
+		Recording.Target = Target;
+		Recording.MaxSteps = NumSteps;
+		FPodDeterminismHarness::bRecording = true;
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			FPodDeterminismHarness::StepMove(Movement, ScriptedMove(Step));
+			if (Step == CorrectionStep)
+			{
+				FPodDeterminismHarness::FScopedCorrectionReplay CorrectionReplay;
+				for (int32 Replayed = Step - CorrectedMoves; Replayed < Step; ++Replayed)
+				{
+					FPodDeterminismHarness::StepMove(Movement, ScriptedMove(Replayed));
+				}
+				Test.TestEqual(TEXT("Corrections add no moves"), Recording.Moves.Num(), Step + 1);
+			}
+		}
+
+		Test.TestFalse(TEXT("Recording stops after the requested steps"), FPodDeterminismHarness::bRecording);
+		Test.TestEqual(TEXT("Recorded moves"), Recording.Moves.Num(), NumSteps);
+
+		FPodDeterminismHarness::FState LiveState;
+		FPodDeterminismHarness::CaptureState(Movement, LiveState);
+
+		TArray<FStepHashes> FirstHashes, SecondHashes;
+		Test.TestTrue(TEXT("First replay runs"), Replay(Recording, Movement, FirstHashes, nullptr));
+		Test.TestTrue(TEXT("Second replay runs"), Replay(Recording, Movement, SecondHashes, nullptr));
+		Test.TestEqual(TEXT("Replayed steps"), FirstHashes.Num(), NumSteps);
+
+		int32 Field = INDEX_NONE;
+		const int32 Divergence = FindFirstDivergence(FirstHashes, SecondHashes, Field);
+		Test.TestEqual(TEXT("First divergent step"), Divergence, int32(INDEX_NONE));
+
+		FPodDeterminismHarness::FState RestoredState;
+		FPodDeterminismHarness::CaptureState(Movement, RestoredState);
+		uint32 LiveFields[NumFields], RestoredFields[NumFields];
+		LiveState.HashFields(LiveFields);
+		RestoredState.HashFields(RestoredFields);
+		Test.TestTrue(TEXT("Replays restore the live state"), FMemory::Memcmp(LiveFields, RestoredFields, sizeof(LiveFields)) == 0);
+
+		Recording = FPodDeterminismHarness::FRecording();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodDeterminismReplayTest, "ProjectPodracer.Determinism.ReplayTwice",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Records and replays a scripted run of a vehicle pod in an empty world
+bool FPodDeterminismReplayTest::RunTest(const FString& Parameters)
+{
+	using namespace PodDeterminism;
+
+	FPodTestWorld TestWorld;
+	APawn* Pawn = TestWorld.World->SpawnActor<APawn>();
+	UBoxComponent* Body = NewObject<UBoxComponent>(Pawn);
+	Pawn->SetRootComponent(Body);
+	Body->RegisterComponent();
+	UPodVehicleMovementComponent* Movement = NewObject<UPodVehicleMovementComponent>(Pawn);
+	Movement->RegisterComponent();
+	Movement->SetUpdatedComponent(Body);
+
+	TestRecordAndReplay(*this, Movement, ETarget::PodVehicleMovement);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodDeterminismHoverReplayTest, "ProjectPodracer.Determinism.HoverReplayTwice",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Records and replays a scripted run of a hovering pod (UPodMovementComponent::SimulateMove with ApplyHover) over a
+// floor, so the hover probe and the on ground state are part of every step
+bool FPodDeterminismHoverReplayTest::RunTest(const FString& Parameters)
+{
+	using namespace PodDeterminism;
+
+	FPodTestWorld TestWorld;
+	TestWorld.AddStaticBox(FVector(0.f, 0.f, -50.f), FVector(100000.f, 100000.f, 50.f));
+	AReplicatedPodRacer* Pod = TestWorld.World->SpawnActor<AReplicatedPodRacer>(FVector(0.f, 0.f, 150.f), FRotator::ZeroRotator);
+	UPodMovementComponent* Movement = Pod ? Pod->GetPodMovementComponent() : nullptr;
+	if (!TestNotNull(TEXT("Pod movement"), Movement) || !TestNotNull(TEXT("Pod physics body"), Pod->GetPhysicsBody()))
+	{
+		return false;
+	}
+
+	TestRecordAndReplay(*this, Movement, ETarget::PodMovement);
+	return true;
+}
+
+#endif
+
+#endif
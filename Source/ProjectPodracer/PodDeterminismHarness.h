@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Replay verification is a development tool, keep it out of shipping builds
+#ifndef WITH_POD_DETERMINISM_HARNESS
+#define WITH_POD_DETERMINISM_HARNESS (!UE_BUILD_SHIPPING)
+#endif
+
+#if WITH_POD_DETERMINISM_HARNESS
+
+class UPodMovementComponent;
+class UPodVehicleMovementComponent;
+struct FPodRacerMoveStruct;
+
+/**
+ * Records the input stream of a pod and replays it from the recorded initial state, hashing the movement state after
+ * every step so two replays (or a replay against a file saved by another build) can be compared field by field.
+ *
+ * Console commands (act on the first local player's pod):
+ *   Pod.Determinism.Record [Steps]   Start recording the next Steps moves (default 300)
+ *   Pod.Determinism.Verify           Replay the recording twice and report the first divergent step and field
+ *   Pod.Determinism.Save <Name>      Replay once and write inputs, initial state and hashes to Saved/Determinism/<Name>.pdr
+ *   Pod.Determinism.Compare <Name>   Replay a saved file (e.g. from a server build) and compare against its hashes
+ *
+ * Covers UPodMovementComponent::SimulateMove (with ApplyHover, position is advanced kinematically since no physics step
+ * runs during a replay) and UPodVehicleMovementComponent::ApplyMovementLogic. Moves simulated again to reconcile with
+ * the server are left out of the recording. The automation tests ProjectPodracer.Determinism.ReplayTwice (vehicle) and
+ * HoverReplayTwice (hover pod) run the Verify check on scripted runs in an empty world.
+ */
+class FPodDeterminismHarness
+{
+public:
+	// Hooks called at the top of the simulated step; cheap no-ops unless a recording targets this component
+	static void NotifySimulateMove(UPodMovementComponent* Component, const FPodRacerMoveStruct& Move);
+	static void NotifyApplyMovementLogic(UPodVehicleMovementComponent* Component, float InMoveForwardInput, float InTurnRightInput,
+		bool InIsBoosting, bool InIsBraking, bool InIsDrifting, float InDeltaTime,
+		const FVector& InVelocity, const FRotator& InRotation, float InAngularYawVelocity);
+
+	// Held while a movement component simulates its unacknowledged moves again after a server correction. Those moves
+	// were recorded when they were first made, so the hooks ignore them
+	struct FScopedCorrectionReplay
+	{
+		FScopedCorrectionReplay() { ++CorrectionReplayDepth; }
+		~FScopedCorrectionReplay() { --CorrectionReplayDepth; }
+	};
+
+	// Set by Pod.Determinism.Record, cleared once the requested number of moves has been captured
+	static bool bRecording;
+	static int32 CorrectionReplayDepth;
+
+	struct FState;
+	struct FMove;
+	struct FRecording;
+
+	// Component access for the replay, both movement components befriend the harness
+	static void CaptureState(UPodMovementComponent* Component, FState& OutState);
+	static void RestoreState(UPodMovementComponent* Component, const FState& State);
+	static void StepMove(UPodMovementComponent* Component, const FMove& Move);
+	static void CaptureState(UPodVehicleMovementComponent* Component, FState& OutState);
+	static void RestoreState(UPodVehicleMovementComponent* Component, const FState& State);
+	static void StepMove(UPodVehicleMovementComponent* Component, const FMove& Move);
+};
+
+#endif
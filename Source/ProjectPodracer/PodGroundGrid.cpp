@@ -0,0 +1,348 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodGroundGrid.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	// Corners further apart than this (in cells) straddle an edge or an overpass, the blend would be meaningless
+	constexpr float MaxCornerSpreadInCells = 2.0f;
+	// Bytes per grid point per layer: 16 bit height and two 8 bit normal components
+	constexpr int32 BytesPerSample = sizeof(uint16) + 2 * sizeof(int8);
+}
+
+bool UPodGroundGridAsset::SamplePoint(int32 X, int32 Y, float MaxHeight, float& OutHeight, FVector& OutNormal) const
+{
+	for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+	{
+		const int32 Index = (Layer * SizeY + Y) * SizeX + X;
+		if (Heights[Index] == EmptySample)
+		{
+			break;
+		}
+
+		// Layers are sorted highest first, the first one under the query is the ground
+		const float Height = MinHeight + Heights[Index] * HeightStep;
+		if (Height <= MaxHeight + HeightStep)
+		{
+			const float NormalX = Normals[Index * 2] / 127.0f;
+			const float NormalY = Normals[Index * 2 + 1] / 127.0f;
+			OutHeight = Height;
+			OutNormal = FVector(NormalX, NormalY, FMath::Sqrt(FMath::Max(0.0f, 1.0f - NormalX * NormalX - NormalY * NormalY)));
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UPodGroundGridAsset::SampleGround(const FVector& Position, float& OutHeight, FVector& OutNormal) const
+{
+	if (!IsBaked())
+	{
+		return false;
+	}
+
+	const float GridX = (Position.X - Origin.X) / CellSize;
+	const float GridY = (Position.Y - Origin.Y) / CellSize;
+	const int32 X = FMath::FloorToInt(GridX);
+	const int32 Y = FMath::FloorToInt(GridY);
+	if (X < 0 || Y < 0 || X >= SizeX - 1 || Y >= SizeY - 1)
+	{
+		return false;
+	}
+
+	float CornerHeights[4];
+	FVector CornerNormals[4];
+	if (!SamplePoint(X, Y, Position.Z, CornerHeights[0], CornerNormals[0])
+		|| !SamplePoint(X + 1, Y, Position.Z, CornerHeights[1], CornerNormals[1])
+		|| !SamplePoint(X, Y + 1, Position.Z, CornerHeights[2], CornerNormals[2])
+		|| !SamplePoint(X + 1, Y + 1, Position.Z, CornerHeights[3], CornerNormals[3]))
+	{
+		return false;
+	}
+
+	const float Spread = FMath::Max(FMath::Max(CornerHeights[0], CornerHeights[1]), FMath::Max(CornerHeights[2], CornerHeights[3]))
+		- FMath::Min(FMath::Min(CornerHeights[0], CornerHeights[1]), FMath::Min(CornerHeights[2], CornerHeights[3]));
+	if (Spread > CellSize * MaxCornerSpreadInCells)
+	{
+		return false;
+	}
+
+	const float AlphaX = GridX - X;
+	const float AlphaY = GridY - Y;
+	OutHeight = FMath::BiLerp(CornerHeights[0], CornerHeights[1], CornerHeights[2], CornerHeights[3], AlphaX, AlphaY);
+	OutNormal = FMath::BiLerp(CornerNormals[0], CornerNormals[1], CornerNormals[2], CornerNormals[3], AlphaX, AlphaY).GetSafeNormal();
+	return !OutNormal.IsZero();
+}
+
+bool UPodGroundGridAsset::LineTrace(const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	const FVector Ray = End - Start;
+	const double Length = Ray.Size();
+	if (Length < UE_KINDA_SMALL_NUMBER || -Ray.Z < Length * UE_HALF_SQRT_2)
+	{
+		return false;
+	}
+
+	// A slanted ray meets the ground away from its start, a couple of fixed point steps move the sample there
+	FVector HitPoint = Start;
+	FVector GroundNormal = FVector::UpVector;
+	double Time = 0.0;
+	for (int32 Step = 0; Step < 2; ++Step)
+	{
+		float GroundHeight;
+		if (!SampleGround(FVector(HitPoint.X, HitPoint.Y, Start.Z), GroundHeight, GroundNormal))
+		{
+			return false;
+		}
+		Time = (Start.Z - GroundHeight) / -Ray.Z;
+		HitPoint = Start + Ray * Time;
+	}
+
+	if (Time < 0.0 || Time > 1.0)
+	{
+		return false;
+	}
+
+	OutHit = FHitResult(Start, End);
+	OutHit.bBlockingHit = true;
+	OutHit.Time = Time;
+	OutHit.Distance = Time * Length;
+	OutHit.Location = HitPoint;
+	OutHit.ImpactPoint = HitPoint;
+	OutHit.Normal = GroundNormal;
+	OutHit.ImpactNormal = GroundNormal;
+	return true;
+}
+
+double UPodGroundGridAsset::GetBytesPerSquareKilometre() const
+{
+	const double PointsPerSquareKilometre = 1.0e10 / (double(CellSize) * CellSize);
+	return PointsPerSquareKilometre * NumLayers * BytesPerSample;
+}
+
+#if WITH_EDITOR
+void UPodGroundGridAsset::Bake(UWorld* World, const FBox& Region, float InCellSize, int32 MaxLayers, ECollisionChannel Channel)
+{
+	if (!World || !Region.IsValid || InCellSize <= 0.0f)
+	{
+		return;
+	}
+
+	Modify();
+
+	CellSize = InCellSize;
+	Origin = FVector2D(Region.Min.X, Region.Min.Y);
+	SizeX = FMath::FloorToInt((Region.Max.X - Region.Min.X) / CellSize) + 1;
+	SizeY = FMath::FloorToInt((Region.Max.Y - Region.Min.Y) / CellSize) + 1;
+	NumLayers = FMath::Clamp(MaxLayers, 1, 8);
+
+	const int32 NumSamples = SizeX * SizeY * NumLayers;
+	TArray<float> RawHeights;
+	TArray<FVector> RawNormals;
+	RawHeights.Init(MAX_flt, NumSamples);
+	RawNormals.Init(FVector::UpVector, NumSamples);
+
+	// Only static geometry is baked, anything that can move still has to be traced
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(PodGroundGridBake), false);
+	Params.MobilityType = EQueryMobilityType::Static;
+
+	// Surfaces closer than this under one point are treated as the same deck
+	const float MinLayerGap = 200.0f;
+	float Lowest = MAX_flt;
+	float Highest = -MAX_flt;
+	int32 NumSurfaces = 0;
+
+	for (int32 Y = 0; Y < SizeY; ++Y)
+	{
+		for (int32 X = 0; X < SizeX; ++X)
+		{
+			FVector Start(Origin.X + X * CellSize, Origin.Y + Y * CellSize, Region.Max.Z);
+			const FVector End(Start.X, Start.Y, Region.Min.Z);
+
+			int32 Layer = 0;
+			while (Layer < NumLayers && Start.Z > End.Z)
+			{
+				FHitResult Hit;
+				if (!World->LineTraceSingleByChannel(Hit, Start, End, Channel, Params) || Hit.bStartPenetrating)
+				{
+					break;
+				}
+
+				// Undersides of overpasses aren't ground, keep looking below them
+				if (Hit.ImpactNormal.Z > 0.0f)
+				{
+					const int32 Index = (Layer * SizeY + Y) * SizeX + X;
+					RawHeights[Index] = Hit.ImpactPoint.Z;
+					RawNormals[Index] = Hit.ImpactNormal;
+					Lowest = FMath::Min(Lowest, float(Hit.ImpactPoint.Z));
+					Highest = FMath::Max(Highest, float(Hit.ImpactPoint.Z));
+					++Layer;
+					++NumSurfaces;
+				}
+				Start.Z = Hit.ImpactPoint.Z - MinLayerGap;
+			}
+		}
+	}
+
+	MinHeight = NumSurfaces > 0 ? Lowest : 0.0f;
+	HeightStep = FMath::Max((Highest - Lowest) / (EmptySample - 1), 0.01f);
+
+	Heights.SetNumUninitialized(NumSamples);
+	Normals.SetNumUninitialized(NumSamples * 2);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		if (RawHeights[Index] == MAX_flt)
+		{
+			Heights[Index] = EmptySample;
+			Normals[Index * 2] = 0;
+			Normals[Index * 2 + 1] = 0;
+			continue;
+		}
+		Heights[Index] = uint16(FMath::Clamp(FMath::RoundToInt((RawHeights[Index] - MinHeight) / HeightStep), 0, EmptySample - 1));
+		Normals[Index * 2] = int8(FMath::RoundToInt(FMath::Clamp(RawNormals[Index].X, -1.0, 1.0) * 127.0));
+		Normals[Index * 2 + 1] = int8(FMath::RoundToInt(FMath::Clamp(RawNormals[Index].Y, -1.0, 1.0) * 127.0));
+	}
+
+	MarkPackageDirty();
+
+	UE_LOG(LogTemp, Log, TEXT("PodGroundGrid: Baked %s, %dx%d points x %d layers, %d surfaces, %.1f KB (%.2f MB per km2), height step %.2f cm"),
+		*GetName(), SizeX, SizeY, NumLayers, NumSurfaces, GetGridBytes() / 1024.0, GetBytesPerSquareKilometre() / (1024.0 * 1024.0), HeightStep);
+}
+#endif
+
+UPodGroundGridSubsystem* UPodGroundGridSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UPodGroundGridSubsystem>() : nullptr;
+}
+
+bool UPodGroundGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPodGroundGridSubsystem::RegisterGrid(UPodGroundGridAsset* Grid)
+{
+	if (Grid && Grid->IsBaked())
+	{
+		Grids.AddUnique(Grid);
+	}
+}
+
+void UPodGroundGridSubsystem::UnregisterGrid(UPodGroundGridAsset* Grid)
+{
+	Grids.Remove(Grid);
+}
+
+bool UPodGroundGridSubsystem::LineTrace(const FVector& Start, const FVector& End, ECollisionChannel Channel, FHitResult& OutHit) const
+{
+	bool bHit = false;
+	FHitResult GridHit;
+	for (const UPodGroundGridAsset* Grid : Grids)
+	{
+		if (Grid->Answers(Channel) && Grid->LineTrace(Start, End, GridHit) && (!bHit || GridHit.Time < OutHit.Time))
+		{
+			OutHit = GridHit;
+			bHit = true;
+		}
+	}
+	return bHit;
+}
+
+#if !UE_BUILD_SHIPPING
+namespace PodGroundGridBench
+{
+	// Times grid lookups against scene traces over the same hover-length rays and reports how far the heights disagree
+	static void BenchCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		const UPodGroundGridSubsystem* GridSubsystem = UPodGroundGridSubsystem::Get(World);
+		if (!GridSubsystem || !GridSubsystem->HasGrids())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Pod.GroundGrid.Bench: No baked grids in this world"));
+			return;
+		}
+
+		const int32 NumQueries = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const float HoverHeight = 200.0f;
+		const float RayLength = 500.0f;
+
+		for (const UPodGroundGridAsset* Grid : GridSubsystem->GetGrids())
+		{
+			if (Grid->AnsweredChannels.Num() == 0)
+			{
+				continue;
+			}
+			const ECollisionChannel Channel = Grid->AnsweredChannels[0];
+			const FBox2D Bounds = Grid->GetBounds();
+			const float TopHeight = Grid->MinHeight + (UPodGroundGridAsset::EmptySample - 1) * Grid->HeightStep + HoverHeight;
+
+			// Rays start at hover height above the baked ground so both paths answer the same question
+			FRandomStream Stream(NumQueries);
+			TArray<TPair<FVector, FVector>> Rays;
+			Rays.Reserve(NumQueries);
+			for (int32 Attempt = 0; Attempt < NumQueries * 4 && Rays.Num() < NumQueries; ++Attempt)
+			{
+				const FVector Top(Stream.FRandRange(Bounds.Min.X, Bounds.Max.X), Stream.FRandRange(Bounds.Min.Y, Bounds.Max.Y), TopHeight);
+				float GroundHeight;
+				FVector GroundNormal;
+				if (Grid->SampleGround(Top, GroundHeight, GroundNormal))
+				{
+					const FVector Start(Top.X, Top.Y, GroundHeight + HoverHeight);
+					Rays.Emplace(Start, Start - FVector::UpVector * RayLength);
+				}
+			}
+			if (Rays.Num() == 0)
+			{
+				continue;
+			}
+
+			TArray<FHitResult> GridHits, SceneHits;
+			GridHits.SetNum(Rays.Num());
+			SceneHits.SetNum(Rays.Num());
+			TBitArray<> GridHit(false, Rays.Num()), SceneHit(false, Rays.Num());
+
+			const double GridStart = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < Rays.Num(); ++Index)
+			{
+				GridHit[Index] = Grid->LineTrace(Rays[Index].Key, Rays[Index].Value, GridHits[Index]);
+			}
+			const double GridSeconds = FPlatformTime::Seconds() - GridStart;
+
+			FCollisionQueryParams Params(SCENE_QUERY_STAT(PodGroundGridBench), false);
+			const double SceneStart = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < Rays.Num(); ++Index)
+			{
+				SceneHit[Index] = World->LineTraceSingleByChannel(SceneHits[Index], Rays[Index].Key, Rays[Index].Value, Channel, Params);
+			}
+			const double SceneSeconds = FPlatformTime::Seconds() - SceneStart;
+
+			int32 NumBoth = 0;
+			double HeightErrorSum = 0.0;
+			double HeightErrorMax = 0.0;
+			for (int32 Index = 0; Index < Rays.Num(); ++Index)
+			{
+				if (GridHit[Index] && SceneHit[Index])
+				{
+					const double Error = FMath::Abs(GridHits[Index].ImpactPoint.Z - SceneHits[Index].ImpactPoint.Z);
+					HeightErrorSum += Error;
+					HeightErrorMax = FMath::Max(HeightErrorMax, Error);
+					++NumBoth;
+				}
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("Pod.GroundGrid.Bench: %s, %d rays: grid %.3f us/query, trace %.3f us/query (%.1fx), %d both hit, height error mean %.2f cm max %.2f cm, %.2f MB per km2"),
+				*Grid->GetName(), Rays.Num(), GridSeconds * 1.0e6 / Rays.Num(), SceneSeconds * 1.0e6 / Rays.Num(),
+				GridSeconds > 0.0 ? SceneSeconds / GridSeconds : 0.0, NumBoth, NumBoth > 0 ? HeightErrorSum / NumBoth : 0.0, HeightErrorMax,
+				Grid->GetBytesPerSquareKilometre() / (1024.0 * 1024.0));
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs BenchCmd(
+		TEXT("Pod.GroundGrid.Bench"),
+		TEXT("Time N (default 10000) baked grid lookups against the same line traces and report the cost, height error and memory per km2"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchCommand));
+}
+#endif
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectPodracer.h"
+#include "PodGroundGrid.generated.h"
+
+/**
+ * Static ground baked into a 2D grid of heights and normals, so hover code can read the ground under a pod with a
+ * bilinear lookup instead of a scene query. Each grid point stores up to NumLayers surfaces (highest first) so
+ * overpasses keep the road underneath. Heights are quantized to 16 bits over the baked range and normals to two
+ * signed bytes, 4 bytes per point per layer.
+ */
+UCLASS(BlueprintType)
+class PROJECTPODRACER_API UPodGroundGridAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// World XY of grid point (0, 0)
+	UPROPERTY(VisibleAnywhere, Category = "Ground Grid")
+	FVector2D Origin = FVector2D::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category = "Ground Grid")
+	float CellSize = 200.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Ground Grid")
+	int32 SizeX = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Ground Grid")
+	int32 SizeY = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Ground Grid")
+	int32 NumLayers = 0;
+
+	// World Z = MinHeight + Quantized * HeightStep
+	UPROPERTY(VisibleAnywhere, Category = "Ground Grid")
+	float MinHeight = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Ground Grid")
+	float HeightStep = 1.0f;
+
+	// Trace channels this bake can stand in for. Queries on other channels always go to the scene
+	UPROPERTY(EditAnywhere, Category = "Ground Grid")
+	TArray<TEnumAsByte<ECollisionChannel>> AnsweredChannels = { ECC_WorldStatic, ECC_Visibility, ECC_PodGround };
+
+	// [Layer][Y][X], EmptySample where the layer has no surface
+	UPROPERTY()
+	TArray<uint16> Heights;
+
+	// Normal X and Y per sample scaled to +-127, Z is rebuilt (baked normals always face up)
+	UPROPERTY()
+	TArray<int8> Normals;
+
+	static constexpr uint16 EmptySample = MAX_uint16;
+
+	bool IsBaked() const { return SizeX > 1 && SizeY > 1 && NumLayers > 0 && Heights.Num() == SizeX * SizeY * NumLayers; }
+	bool Answers(ECollisionChannel Channel) const { return AnsweredChannels.Contains(Channel); }
+	FBox2D GetBounds() const { return FBox2D(Origin, Origin + FVector2D(SizeX - 1, SizeY - 1) * CellSize); }
+
+	// Bilinear ground height and normal of the highest surface at or below Position.Z. Fails outside the grid or
+	// where any of the four surrounding points has no surface
+	bool SampleGround(const FVector& Position, float& OutHeight, FVector& OutNormal) const;
+
+	// Stand-in for a downward line trace against static geometry. Only rays within 45 degrees of straight down are
+	// answered, and a miss means the grid couldn't tell (the caller should trace)
+	bool LineTrace(const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+
+	SIZE_T GetGridBytes() const { return Heights.GetAllocatedSize() + Normals.GetAllocatedSize(); }
+	double GetBytesPerSquareKilometre() const;
+
+#if WITH_EDITOR
+	// Traces static geometry blocking Channel inside Region every CellSize, keeping up to MaxLayers surfaces per point
+	void Bake(UWorld* World, const FBox& Region, float InCellSize, int32 MaxLayers, ECollisionChannel Channel);
+#endif
+
+private:
+	bool SamplePoint(int32 X, int32 Y, float MaxHeight, float& OutHeight, FVector& OutNormal) const;
+};
+
+/**
+ * Grids placed in the current world by APodGroundGridVolume. PodGroundProbe asks these after the track surfaces and
+ * before tracing the scene.
+ */
+UCLASS()
+class PROJECTPODRACER_API UPodGroundGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UPodGroundGridSubsystem* Get(const UWorld* World);
+
+	void RegisterGrid(UPodGroundGridAsset* Grid);
+	void UnregisterGrid(UPodGroundGridAsset* Grid);
+
+	bool HasGrids() const { return Grids.Num() > 0; }
+	const TArray<TObjectPtr<UPodGroundGridAsset>>& GetGrids() const { return Grids; }
+
+	bool LineTrace(const FVector& Start, const FVector& End, ECollisionChannel Channel, FHitResult& OutHit) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<UPodGroundGridAsset>> Grids;
+};
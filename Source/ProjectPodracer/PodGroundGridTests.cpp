@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodGroundGrid.h"
+#include "PodTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodGroundGridBakeTest, "ProjectPodracer.GroundGrid.BakeMatchesTrace",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Bakes a floor with an overpass across it into two layers, then checks grid lookups land where traces do, on the deck
+// from above it and on the floor from under it. Reports lookup cost against the trace and memory per km2
+bool FPodGroundGridBakeTest::RunTest(const FString& Parameters)
+{
+	FPodTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+
+	// Floor top at 0, deck top at 1000 spanning X -1000 to 1000
+	constexpr float DeckHeight = 1000.f;
+	TestWorld.AddStaticBox(FVector(0.f, 0.f, -50.f), FVector(5000.f, 5000.f, 50.f));
+	TestWorld.AddStaticBox(FVector(0.f, 0.f, DeckHeight - 25.f), FVector(1000.f, 5000.f, 25.f));
+
+	UPodGroundGridAsset* Grid = NewObject<UPodGroundGridAsset>(GetTransientPackage());
+	constexpr float CellSize = 200.f;
+	Grid->Bake(World, FBox(FVector(-4000.f, -4000.f, -500.f), FVector(4000.f, 4000.f, 2000.f)), CellSize, 2, ECC_WorldStatic);
+	if (!TestTrue(TEXT("Grid baked"), Grid->IsBaked()))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Layers"), Grid->NumLayers, 2);
+
+	// Rays away from the deck edges, where the corners of a cell disagree and the grid rightly passes
+	struct FRay
+	{
+		FVector Start;
+		float ExpectedHeight;
+	};
+	TArray<FRay> Rays;
+	for (float Y = -3000.f; Y <= 3000.f; Y += 330.f)
+	{
+		for (const float X : { -3100.f, -2050.f, 2050.f, 3100.f })
+		{
+			Rays.Add({ FVector(X, Y, 300.f), 0.f });
+		}
+		for (const float X : { -610.f, 0.f, 570.f })
+		{
+			Rays.Add({ FVector(X, Y, DeckHeight + 300.f), DeckHeight });
+			Rays.Add({ FVector(X, Y, DeckHeight - 500.f), 0.f });
+		}
+	}
+
+	const FVector Down(0.f, 0.f, -1000.f);
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(PodGroundGridTest), false);
+	double GridSeconds = 0.0;
+	double TraceSeconds = 0.0;
+	for (const FRay& Ray : Rays)
+	{
+		FHitResult GridHit, TraceHit;
+		double Start = FPlatformTime::Seconds();
+		const bool bGridHit = Grid->LineTrace(Ray.Start, Ray.Start + Down, GridHit);
+		GridSeconds += FPlatformTime::Seconds() - Start;
+		Start = FPlatformTime::Seconds();
+		const bool bTraceHit = World->LineTraceSingleByChannel(TraceHit, Ray.Start, Ray.Start + Down, ECC_WorldStatic, Params);
+		TraceSeconds += FPlatformTime::Seconds() - Start;
+
+		const FString Where = Ray.Start.ToCompactString();
+		if (TestTrue(FString::Printf(TEXT("Grid answers at %s"), *Where), bGridHit)
+			&& TestTrue(FString::Printf(TEXT("Trace hits at %s"), *Where), bTraceHit))
+		{
+			TestNearlyEqual(FString::Printf(TEXT("Grid height at %s"), *Where), float(GridHit.ImpactPoint.Z), Ray.ExpectedHeight, 1.f);
+			TestNearlyEqual(FString::Printf(TEXT("Grid and trace agree at %s"), *Where), float(GridHit.ImpactPoint.Z), float(TraceHit.ImpactPoint.Z), 1.f);
+			TestTrue(FString::Printf(TEXT("Grid normal is up at %s"), *Where), GridHit.ImpactNormal.Equals(FVector::UpVector, 0.01f));
+		}
+	}
+
+	// Two layers of 4 bytes per point every 200 cm
+	const double ExpectedBytesPerSquareKilometre = 1.0e10 / (CellSize * CellSize) * 2 * 4;
+	TestNearlyEqual(TEXT("Bytes per km2"), Grid->GetBytesPerSquareKilometre(), ExpectedBytesPerSquareKilometre, 1.0);
+	AddInfo(FString::Printf(TEXT("%d rays: grid %.3f us/query, trace %.3f us/query, %.2f MB per km2 at %.0f cm cells and %d layers"),
+		Rays.Num(), GridSeconds * 1.0e6 / Rays.Num(), TraceSeconds * 1.0e6 / Rays.Num(),
+		Grid->GetBytesPerSquareKilometre() / (1024.0 * 1024.0), CellSize, Grid->NumLayers));
+	return true;
+}
+
+#endif
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodGroundGridVolume.h"
+
+#include "PodGroundGrid.h"
+#include "Components/BoxComponent.h"
+
+APodGroundGridVolume::APodGroundGridVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	BakeBounds = CreateDefaultSubobject<UBoxComponent>(TEXT("BakeBounds"));
+	BakeBounds->SetBoxExtent(FVector(50000.0f, 50000.0f, 10000.0f));
+	BakeBounds->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	BakeBounds->SetHiddenInGame(true);
+	RootComponent = BakeBounds;
+}
+
+void APodGroundGridVolume::Bake()
+{
+#if WITH_EDITOR
+	if (!Grid)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("PodGroundGridVolume: %s has no grid asset to bake into"), *GetName());
+		return;
+	}
+	Grid->Bake(GetWorld(), BakeBounds->Bounds.GetBox(), CellSize, MaxLayers, BakeChannel);
+#endif
+}
+
+void APodGroundGridVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UPodGroundGridSubsystem* GridSubsystem = UPodGroundGridSubsystem::Get(GetWorld()))
+	{
+		GridSubsystem->RegisterGrid(Grid);
+	}
+}
+
+void APodGroundGridVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPodGroundGridSubsystem* GridSubsystem = UPodGroundGridSubsystem::Get(GetWorld()))
+	{
+		GridSubsystem->UnregisterGrid(Grid);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ProjectPodracer.h"
+#include "PodGroundGridVolume.generated.h"
+
+class UBoxComponent;
+class UPodGroundGridAsset;
+
+// Marks the region to bake into a ground grid and makes the grid available to hover code while the level plays
+UCLASS()
+class PROJECTPODRACER_API APodGroundGridVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	APodGroundGridVolume();
+
+	// Everything inside is baked, traces start from the top face
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UBoxComponent* BakeBounds;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ground Grid")
+	TObjectPtr<UPodGroundGridAsset> Grid;
+
+	// Grid spacing, 200 cm keeps a square kilometre of single layer ground around 1 MB
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ground Grid", meta = (ClampMin = "25.0"))
+	float CellSize = 200.0f;
+
+	// Surfaces kept per grid point, more than one only where the track passes over itself
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ground Grid", meta = (ClampMin = "1", ClampMax = "8"))
+	int32 MaxLayers = 2;
+
+	// Not PodGround: nothing blocks it by default, and UPodGroundProxyComponent only adds its proxies once play starts,
+	// so an editor bake on that channel finds no ground. WorldStatic sees the same meshes' simple collision
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ground Grid")
+	TEnumAsByte<ECollisionChannel> BakeChannel = ECC_WorldStatic;
+
+	// Re-run after moving static ground or regenerating a track
+	UFUNCTION(CallInEditor, Category = "Ground Grid")
+	void Bake();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+};
@@ -0,0 +1,542 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodGroundProbe.h"
+
+#include "PodGroundGrid.h"
+#include "PodTrackSurfaceSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/ObjectKey.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contact cache hits"), STAT_PodGroundCacheHits, STATGROUP_PodGround);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contact cache misses"), STAT_PodGroundCacheMisses, STATGROUP_PodGround);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contact cache uncacheable"), STAT_PodGroundCacheUncacheable, STATGROUP_PodGround);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PodGround fallback traces"), STAT_PodGroundFallbackTraces, STATGROUP_PodGround);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async probe results used"), STAT_PodGroundAsyncResults, STATGROUP_PodGround);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async probe sync traces"), STAT_PodGroundAsyncSyncTraces, STATGROUP_PodGround);
+
+namespace PodGroundProbe
+{
+	// The analytic answer only knows about the road, anything on top of it is only found with Pod.GroundProbe.AnalyticOccluders
+	static int32 GUseTrackSurface = 1;
+	static FAutoConsoleVariableRef CVarUseTrackSurface(
+		TEXT("Pod.GroundProbe.TrackSurface"),
+		GUseTrackSurface,
+		TEXT("Answer hover ground traces over generated tracks from the track spline instead of the physics scene (0 = always trace)"));
+
+	// Same for the baked grids, which only hold static geometry
+	static int32 GUseGroundGrid = 1;
+	static FAutoConsoleVariableRef CVarUseGroundGrid(
+		TEXT("Pod.GroundProbe.Grid"),
+		GUseGroundGrid,
+		TEXT("Answer hover ground traces from baked ground grids (APodGroundGridVolume) before tracing the scene (0 = always trace)"));
+
+	// Levels whose ground has no PodGroundProxy collision yet would leave every pod falling through the PodGround channel,
+	// which ignores everything but the proxies. Worlds with no proxy at all skip the PodGround trace that can only miss
+	static int32 GPodGroundFallback = 1;
+	static FAutoConsoleVariableRef CVarPodGroundFallback(
+		TEXT("Pod.GroundProbe.PodGroundFallback"),
+		GPodGroundFallback,
+		TEXT("Re-trace PodGround misses against WorldStatic simple collision, and trace WorldStatic straight away in worlds without hover ground proxies (0 = off)"));
+
+	// Off by default: the point of the analytic answers is that hover probes over the road make no scene query. Turn it
+	// on for tracks where pods have to ride over each other or over debris
+	static int32 GAnalyticOccluders = 0;
+	static FAutoConsoleVariableRef CVarAnalyticOccluders(
+		TEXT("Pod.GroundProbe.AnalyticOccluders"),
+		GAnalyticOccluders,
+		TEXT("Follow track surface and ground grid hits with a scene query for pods and debris on the ground (1 = on)"));
+
+	// With Pod.GroundProbe.AnalyticOccluders, pods, debris and level geometry above an analytic hit are found by a scene
+	// query from the ray start that stops this far short of the hit. It would mostly touch the road's own triangles if
+	// it went all the way down, and what sits lower than this on the road is ignored
+	static float GAnalyticClearance = 10.0f;
+	static FAutoConsoleVariableRef CVarAnalyticClearance(
+		TEXT("Pod.GroundProbe.AnalyticClearance"),
+		GAnalyticClearance,
+		TEXT("Distance (cm) above a track surface or ground grid hit where the scene query for things on the ground stops (negative = no scene query)"));
+
+	static int32 GAsyncProbes = 0;
+	static FAutoConsoleVariableRef CVarAsyncProbes(
+		TEXT("Pod.GroundProbe.Async"),
+		GAsyncProbes,
+		TEXT("Issue hover ground scene traces a frame ahead and read them back next frame, corrected for the pod's movement (1 = on)"));
+
+	static int32 GContactCacheTicks = 4;
+	static FAutoConsoleVariableRef CVarContactCacheTicks(
+		TEXT("Pod.GroundProbe.CacheTicks"),
+		GContactCacheTicks,
+		TEXT("Ticks a cached ground contact plane is reused before re-tracing (0 disables the contact cache)"));
+
+	// Roughly the size of a track triangle, beyond it the cached plane may belong to the neighbouring one
+	static float GContactCacheRadius = 100.0f;
+	static FAutoConsoleVariableRef CVarContactCacheRadius(
+		TEXT("Pod.GroundProbe.CacheRadius"),
+		GContactCacheRadius,
+		TEXT("Distance (cm) from the last impact within which the cached ground plane is trusted"));
+
+	// Totals for Pod.GroundProbe.CacheStats, the stat counters reset every frame
+	static uint64 GTotalCacheHits = 0;
+	static uint64 GTotalCacheMisses = 0;
+
+	static TMap<TObjectKey<UWorld>, TSet<TObjectKey<UObject>>> GGroundProxyOwners;
+
+	void RegisterGroundProxyOwner(const UObject* Owner)
+	{
+		check(IsInGameThread());
+		if (const UWorld* World = Owner ? Owner->GetWorld() : nullptr)
+		{
+			GGroundProxyOwners.FindOrAdd(World).Add(Owner);
+		}
+	}
+
+	void UnregisterGroundProxyOwner(const UObject* Owner)
+	{
+		check(IsInGameThread());
+		const UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+		TSet<TObjectKey<UObject>>* Owners = World ? GGroundProxyOwners.Find(World) : nullptr;
+		if (Owners && Owners->Remove(Owner) > 0 && Owners->Num() == 0)
+		{
+			GGroundProxyOwners.Remove(World);
+		}
+	}
+
+	bool HasGroundProxies(const UWorld* World)
+	{
+		check(IsInGameThread());
+		return GGroundProxyOwners.Contains(World);
+	}
+
+	// The channel scene queries use for Channel: PodGround goes straight to the WorldStatic fallback in a world where
+	// it can only miss
+	static ECollisionChannel GetSceneChannel(ECollisionChannel Channel, bool bGroundProxies)
+	{
+		return Channel == ECC_PodGround && GPodGroundFallback && !bGroundProxies ? ECC_WorldStatic : Channel;
+	}
+
+	// Track surfaces and baked grids, the answers that need no scene query
+	static bool TraceStaticGround(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel Channel)
+	{
+		if (GUseTrackSurface)
+		{
+			const UPodTrackSurfaceSubsystem* TrackSurfaces = UPodTrackSurfaceSubsystem::Get(World);
+			if (TrackSurfaces && TrackSurfaces->HasTracks() && TrackSurfaces->LineTrace(Start, End, Channel, OutHit))
+			{
+				return true;
+			}
+		}
+
+		if (GUseGroundGrid)
+		{
+			const UPodGroundGridSubsystem* GroundGrids = UPodGroundGridSubsystem::Get(World);
+			if (GroundGrids && GroundGrids->HasGrids() && GroundGrids->LineTrace(Start, End, Channel, OutHit))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool WantsOccluders()
+	{
+		return GAnalyticOccluders && GAnalyticClearance >= 0.0f;
+	}
+
+	// Replaces a static ground hit with whatever the scene has between the ray start and it. Only a scene query, so
+	// safe on worker threads
+	static void TraceOccluders(const UWorld* World, FHitResult& InOutHit, const FVector& Start, const FVector& End,
+		ECollisionChannel Channel, const FCollisionQueryParams& Params)
+	{
+		const double OccluderDistance = InOutHit.Distance - GAnalyticClearance;
+		if (OccluderDistance <= UE_KINDA_SMALL_NUMBER)
+		{
+			return;
+		}
+
+		const FVector Ray = End - Start;
+		const double RayLength = Ray.Size();
+		FHitResult OccluderHit;
+		if (PodQueryStats::LineTraceSingleByChannel(World, OccluderHit, Start, Start + Ray * (OccluderDistance / RayLength), Channel, Params))
+		{
+			// Reported against the whole ray like any other hit
+			OccluderHit.TraceEnd = End;
+			OccluderHit.Time = OccluderHit.Distance / RayLength;
+			InOutHit = OccluderHit;
+		}
+	}
+
+	// The static ground, or whatever the scene has between the ray start and it
+	static bool TraceAnalytic(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End,
+		ECollisionChannel Channel, ECollisionChannel SceneChannel, const FCollisionQueryParams& Params)
+	{
+		if (!TraceStaticGround(World, OutHit, Start, End, Channel))
+		{
+			return false;
+		}
+
+		if (WantsOccluders())
+		{
+			TraceOccluders(World, OutHit, Start, End, SceneChannel, Params);
+		}
+		return true;
+	}
+
+	static bool TraceScene(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End,
+		ECollisionChannel Channel, const FCollisionQueryParams& Params)
+	{
+		if (PodQueryStats::LineTraceSingleByChannel(World, OutHit, Start, End, Channel, Params))
+		{
+			return true;
+		}
+
+		if (Channel == ECC_PodGround && GPodGroundFallback)
+		{
+			INC_DWORD_STAT(STAT_PodGroundFallbackTraces);
+			return PodQueryStats::LineTraceSingleByChannel(World, OutHit, Start, End, ECC_WorldStatic, Params);
+		}
+		return false;
+	}
+
+	bool LineTrace(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End,
+		ECollisionChannel Channel, const FCollisionQueryParams& Params)
+	{
+		if (!World)
+		{
+			return false;
+		}
+		const ECollisionChannel SceneChannel = GetSceneChannel(Channel, HasGroundProxies(World));
+		return TraceAnalytic(World, OutHit, Start, End, Channel, SceneChannel, Params)
+			|| TraceScene(World, OutHit, Start, End, SceneChannel, Params);
+	}
+
+	// Meets Start-End with the plane of an earlier hit, keeping that hit's component, face index and material
+	static bool IntersectHitPlane(const FHitResult& PlaneHit, const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		const FVector Ray = End - Start;
+		const FVector& PlanePoint = PlaneHit.ImpactPoint;
+		const FVector& PlaneNormal = PlaneHit.ImpactNormal;
+		const double Approach = FVector::DotProduct(Ray, PlaneNormal);
+		if (Approach >= -UE_KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const double Time = FVector::DotProduct(PlanePoint - Start, PlaneNormal) / Approach;
+		if (Time < 0.0 || Time > 1.0)
+		{
+			return false;
+		}
+
+		const FVector ImpactPoint = Start + Ray * Time;
+		OutHit = PlaneHit;
+		OutHit.TraceStart = Start;
+		OutHit.TraceEnd = End;
+		OutHit.Time = Time;
+		OutHit.Distance = Time * Ray.Size();
+		OutHit.Location = ImpactPoint;
+		OutHit.ImpactPoint = ImpactPoint;
+		return true;
+	}
+
+	static bool TryCachedContact(const FPodGroundContactCache& Cache, const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		if (!Cache.bValid || Cache.TicksSinceTrace >= GContactCacheTicks || !Cache.Component.IsValid())
+		{
+			return false;
+		}
+
+		// The pod's up vector changed too much, the ray no longer samples the same patch
+		const FVector RayDirection = (End - Start).GetSafeNormal();
+		if (FVector::DotProduct(RayDirection, Cache.RayDirection) < 0.995f)
+		{
+			return false;
+		}
+
+		return IntersectHitPlane(Cache.LastHit, Start, End, OutHit)
+			&& FVector::DistSquared(OutHit.ImpactPoint, Cache.LastHit.ImpactPoint) <= FMath::Square(GContactCacheRadius);
+	}
+
+	// Cache hit or miss, with the accounting. A miss leaves the cache invalid until StoreContact
+	static bool ReadCachedContact(FPodGroundContactCache& Cache, const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		if (TryCachedContact(Cache, Start, End, OutHit))
+		{
+			++Cache.TicksSinceTrace;
+			++GTotalCacheHits;
+			INC_DWORD_STAT(STAT_PodGroundCacheHits);
+			return true;
+		}
+
+		++GTotalCacheMisses;
+		INC_DWORD_STAT(STAT_PodGroundCacheMisses);
+		Cache.bValid = false;
+		return false;
+	}
+
+	static void StoreContact(FPodGroundContactCache& Cache, bool bHit, const FHitResult& Hit, const FVector& Start, const FVector& End)
+	{
+		// Only static primitives can be trusted not to move under the cached plane
+		const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+		if (bHit && GContactCacheTicks > 0 && HitComponent && HitComponent->Mobility == EComponentMobility::Static)
+		{
+			Cache.Component = Hit.Component;
+			Cache.LastHit = Hit;
+			Cache.RayDirection = (End - Start).GetSafeNormal();
+			Cache.TicksSinceTrace = 0;
+			Cache.bValid = true;
+		}
+		else if (bHit)
+		{
+			INC_DWORD_STAT(STAT_PodGroundCacheUncacheable);
+		}
+	}
+
+	bool LineTrace(const UWorld* World, FPodGroundContactCache& Cache, FHitResult& OutHit, const FVector& Start,
+		const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params)
+	{
+		if (ReadCachedContact(Cache, Start, End, OutHit))
+		{
+			return true;
+		}
+
+		const bool bHit = LineTrace(World, OutHit, Start, End, Channel, Params);
+		StoreContact(Cache, bHit, OutHit, Start, End);
+		return bHit;
+	}
+
+	bool LineTrace(UWorld* World, FPodGroundContactCache& Cache, FPodAsyncGroundProbe& AsyncProbe, FHitResult& OutHit,
+		const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params)
+	{
+		if (!GAsyncProbes || !World)
+		{
+			AsyncProbe.Reset();
+			return LineTrace(World, Cache, OutHit, Start, End, Channel, Params);
+		}
+
+		// No scene query at all unless occluders are on, and then a short one that rarely hits, cheaper than a full query
+		// a frame late
+		const ECollisionChannel SceneChannel = GetSceneChannel(Channel, HasGroundProxies(World));
+		if (TraceAnalytic(World, OutHit, Start, End, Channel, SceneChannel, Params))
+		{
+			AsyncProbe.Reset();
+			return true;
+		}
+
+		// A hit the current ray no longer reaches, or no query at all (first frame, or the probe skipped a tick and its
+		// query expired) is traced now
+		bool bHit = false;
+		bool bAnswered = false;
+		FTraceDatum Datum;
+		if (AsyncProbe.Handle.IsValid() && World->QueryTraceData(AsyncProbe.Handle, Datum))
+		{
+			const FHitResult* QueryHit = Datum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+			if (QueryHit)
+			{
+				bHit = IntersectHitPlane(*QueryHit, Start, End, OutHit);
+				bAnswered = bHit;
+			}
+			else
+			{
+				// Levels without hover proxies still need the WorldStatic fallback, which only the sync path does
+				OutHit = FHitResult(Start, End);
+				bAnswered = !(SceneChannel == ECC_PodGround && GPodGroundFallback);
+			}
+		}
+
+		if (bAnswered)
+		{
+			INC_DWORD_STAT(STAT_PodGroundAsyncResults);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_PodGroundAsyncSyncTraces);
+			bHit = TraceScene(World, OutHit, Start, End, SceneChannel, Params);
+		}
+
+		AsyncProbe.Handle = PodQueryStats::AsyncLineTraceByChannel(World, Start, End, SceneChannel, Params);
+		return bHit;
+	}
+
+#if !UE_BUILD_SHIPPING
+	static void CacheStatsCommand(const TArray<FString>& Args)
+	{
+		const uint64 Hits = GTotalCacheHits;
+		const uint64 Misses = GTotalCacheMisses;
+		const uint64 Total = Hits + Misses;
+		UE_LOG(LogTemp, Display, TEXT("Pod.GroundProbe.CacheStats: %llu hits, %llu misses, %.1f%% hit rate"),
+			Hits, Misses, Total > 0 ? 100.0 * Hits / Total : 0.0);
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			GTotalCacheHits = 0;
+			GTotalCacheMisses = 0;
+		}
+	}
+
+	static FAutoConsoleCommand CacheStatsCmd(
+		TEXT("Pod.GroundProbe.CacheStats"),
+		TEXT("Log the ground contact cache hit rate since startup or the last 'reset'"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&CacheStatsCommand));
+
+	// Average scene trace cost for the same downward rays around the player on each ground setup. Goes straight to the
+	// scene so track surfaces, grids and the fallback don't hide the difference
+	static void ChannelBenchCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 RaysPerSide = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 256) : 64;
+		const float Spacing = 100.0f;
+		const float RayStartHeight = 300.0f;
+		const float RayLength = 2000.0f;
+
+		FVector Center = FVector::ZeroVector;
+		const APlayerController* PlayerController = World->GetFirstPlayerController();
+		if (PlayerController && PlayerController->GetPawn())
+		{
+			Center = PlayerController->GetPawn()->GetActorLocation();
+		}
+
+		TArray<TPair<FVector, FVector>> Rays;
+		const float HalfExtent = 0.5f * (RaysPerSide - 1) * Spacing;
+		for (int32 Y = 0; Y < RaysPerSide; ++Y)
+		{
+			for (int32 X = 0; X < RaysPerSide; ++X)
+			{
+				const FVector Start = Center + FVector(X * Spacing - HalfExtent, Y * Spacing - HalfExtent, RayStartHeight);
+				Rays.Emplace(Start, Start - FVector::UpVector * RayLength);
+			}
+		}
+
+		struct FSetup
+		{
+			const TCHAR* Name;
+			ECollisionChannel Channel;
+			bool bTraceComplex;
+		};
+		const FSetup Setups[] = {
+			{ TEXT("Visibility complex"), ECC_Visibility, true },
+			{ TEXT("WorldStatic simple"), ECC_WorldStatic, false },
+			{ TEXT("PodGround simple"), ECC_PodGround, false },
+		};
+
+		const int32 Iterations = 10;
+		for (const FSetup& Setup : Setups)
+		{
+			FCollisionQueryParams Params(SCENE_QUERY_STAT(PodGroundChannelBench), Setup.bTraceComplex);
+			if (PlayerController && PlayerController->GetPawn())
+			{
+				Params.AddIgnoredActor(PlayerController->GetPawn());
+			}
+
+			int32 Hits = 0;
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (const TPair<FVector, FVector>& Ray : Rays)
+				{
+					FHitResult Hit;
+					Hits += World->LineTraceSingleByChannel(Hit, Ray.Key, Ray.Value, Setup.Channel, Params) ? 1 : 0;
+				}
+			}
+			const double Seconds = FPlatformTime::Seconds() - Start;
+			const int32 Traces = Rays.Num() * Iterations;
+
+			UE_LOG(LogTemp, Display, TEXT("Pod.GroundProbe.ChannelBench: %s %.3f us/trace over %d traces (%d%% hit)"),
+				Setup.Name, Seconds * 1.0e6 / Traces, Traces, 100 * Hits / Traces);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs ChannelBenchCmd(
+		TEXT("Pod.GroundProbe.ChannelBench"),
+		TEXT("Time ground traces around the player on Visibility (complex), WorldStatic (simple) and PodGround (simple) (arg: rays per side, default 64)"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ChannelBenchCommand));
+#endif
+}
+
+int32 FPodGroundRayBatch::AddQueryParams(const FCollisionQueryParams& Params)
+{
+	return QueryParams.Add(Params);
+}
+
+int32 FPodGroundRayBatch::AddRay(const FVector& Start, const FVector& End, ECollisionChannel Channel, int32 ParamsIndex, FPodGroundContactCache* Cache)
+{
+	check(QueryParams.IsValidIndex(ParamsIndex));
+	return Rays.Add({ Start, End, Cache, ParamsIndex, Channel });
+}
+
+void FPodGroundRayBatch::Reset()
+{
+	Rays.Reset();
+	QueryParams.Reset();
+	Hits.Reset();
+	HitFlags.Reset();
+	SceneRays.Reset();
+}
+
+void FPodGroundRayBatch::Run(const UWorld* World, bool bParallel)
+{
+	check(IsInGameThread());
+	Hits.SetNum(Rays.Num(), EAllowShrinking::No);
+	HitFlags.SetNumZeroed(Rays.Num(), EAllowShrinking::No);
+	SceneRays.Reset();
+	if (!World)
+	{
+		return;
+	}
+
+	// Contact caches, track surfaces and ground grids hold weak pointers and read components, so they are answered
+	// here. What is left for the scene is queued: rays with no answer yet, and analytic hits that still look for
+	// occluders
+	const bool bWantsOccluders = PodGroundProbe::WantsOccluders();
+	for (int32 Index = 0; Index < Rays.Num(); ++Index)
+	{
+		const FRay& Ray = Rays[Index];
+		if (Ray.Cache && PodGroundProbe::ReadCachedContact(*Ray.Cache, Ray.Start, Ray.End, Hits[Index]))
+		{
+			HitFlags[Index] = 1;
+		}
+		else if (PodGroundProbe::TraceStaticGround(World, Hits[Index], Ray.Start, Ray.End, Ray.Channel))
+		{
+			HitFlags[Index] = 1;
+			if (bWantsOccluders)
+			{
+				SceneRays.Add(Index);
+			}
+		}
+		else
+		{
+			SceneRays.Add(Index);
+		}
+	}
+
+	// Only scene queries run on the workers, each writing its own slot. They take the physics scene read lock
+	// themselves, so workers can trace side by side
+	const bool bGroundProxies = PodGroundProbe::HasGroundProxies(World);
+	ParallelFor(TEXT("PodGroundRayBatch"), SceneRays.Num(), 4, [this, World, bGroundProxies](int32 SceneIndex)
+	{
+		const int32 Index = SceneRays[SceneIndex];
+		const FRay& Ray = Rays[Index];
+		const FCollisionQueryParams& Params = QueryParams[Ray.ParamsIndex];
+		const ECollisionChannel SceneChannel = PodGroundProbe::GetSceneChannel(Ray.Channel, bGroundProxies);
+		if (HitFlags[Index])
+		{
+			PodGroundProbe::TraceOccluders(World, Hits[Index], Ray.Start, Ray.End, SceneChannel, Params);
+		}
+		else
+		{
+			HitFlags[Index] = PodGroundProbe::TraceScene(World, Hits[Index], Ray.Start, Ray.End, SceneChannel, Params);
+		}
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	// Caches that missed take the new contact, which needs the hit component's mobility
+	for (int32 Index = 0; Index < Rays.Num(); ++Index)
+	{
+		const FRay& Ray = Rays[Index];
+		if (Ray.Cache && !Ray.Cache->bValid)
+		{
+			PodGroundProbe::StoreContact(*Ray.Cache, HitFlags[Index] != 0, Hits[Index], Ray.Start, Ray.End);
+		}
+	}
+}
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/HitResult.h"
+#include "WorldCollision.h"
+#include "PodQueryStats.h"
+#include "ProjectPodracer.h"
+class UPrimitiveComponent;
+
+DECLARE_STATS_GROUP(TEXT("PodGround"), STATGROUP_PodGround, STATCAT_Advanced);
+
+/**
+ * Last ground contact of one hover probe. A pod usually stays on the same triangle for several ticks, so while the
+ * probe ray still meets the cached plane close to the last impact on the same static primitive, the ground is taken
+ * from the plane instead of a new query. The plane is re-traced when the ray leaves that area or every few ticks.
+ */
+struct FPodGroundContactCache
+{
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+	FHitResult LastHit;
+	FVector RayDirection = FVector::ZeroVector;
+	int32 TicksSinceTrace = 0;
+	bool bValid = false;
+
+	void Invalidate() { bValid = false; }
+};
+
+/**
+ * Scene query of one hover probe issued a frame ahead (Pod.GroundProbe.Async). The trace requested on frame N runs with
+ * the engine's async traces at the end of that frame and is read back on frame N+1, so the game thread never waits on
+ * the physics scene. By then the pod has moved, so the probe ray of frame N+1 is intersected with the plane of the
+ * frame N hit instead of using the hit as is.
+ *
+ * Accuracy: on flat or evenly sloped ground the corrected hit is exact. Error only comes from a change of slope the
+ * pod crossed since the query. At 150 m/s a pod covers 2.5 m per frame at 60 Hz (5 m at 30 Hz), so a 5 degree crest or
+ * dip inside that span puts the hover height off by up to 22 cm (44 cm at 30 Hz), 10 degrees by up to 44 cm (88 cm).
+ * A ray that missed on frame N reports a miss on N+1, so landings and the start of ground are seen one frame late.
+ */
+struct FPodAsyncGroundProbe
+{
+	FTraceHandle Handle;
+
+	void Reset() { Handle = FTraceHandle(); }
+};
+
+/**
+ * Ground rays from many probes run in one go, optionally with their scene queries spread across worker threads. Rays
+ * share query params by index so a pod builds its params once for all of its points. Results are read back by the
+ * index AddRay returned.
+ */
+struct PROJECTPODRACER_API FPodGroundRayBatch
+{
+	int32 AddQueryParams(const FCollisionQueryParams& Params);
+	// Cache, when given, must stay alive and untouched by anything else until Run returns
+	int32 AddRay(const FVector& Start, const FVector& End, ECollisionChannel Channel, int32 ParamsIndex, FPodGroundContactCache* Cache = nullptr);
+
+	// Game thread only. Contact caches, track surfaces and ground grids are answered on it, only scene queries go wide
+	void Run(const UWorld* World, bool bParallel);
+	void Reset();
+
+	int32 Num() const { return Rays.Num(); }
+	bool HasHit(int32 RayIndex) const { return HitFlags.IsValidIndex(RayIndex) && HitFlags[RayIndex] != 0; }
+	const FHitResult& GetHit(int32 RayIndex) const { return Hits[RayIndex]; }
+
+private:
+	struct FRay
+	{
+		FVector Start;
+		FVector End;
+		FPodGroundContactCache* Cache;
+		int32 ParamsIndex;
+		ECollisionChannel Channel;
+	};
+
+	TArray<FRay> Rays;
+	TArray<FCollisionQueryParams> QueryParams;
+	TArray<FHitResult> Hits;
+	// Non-zero where the ray hit
+	TArray<uint8> HitFlags;
+	// Rays Run still has to query the scene for
+	TArray<int32> SceneRays;
+};
+
+namespace PodGroundProbe
+{
+	// Downward ground trace shared by the hover code, same contract as UWorld::LineTraceSingleByChannel. Rays over a
+	// generated track are answered from its spline by UPodTrackSurfaceSubsystem, then baked ground grids are tried,
+	// and only what neither covers traces the scene. Those answers only know the static ground. With
+	// Pod.GroundProbe.AnalyticOccluders on, a short scene query down to just above them finds pods and debris lying on it
+	PROJECTPODRACER_API bool LineTrace(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End,
+		ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	// Same, answering from the probe's cached contact plane while it is still valid
+	PROJECTPODRACER_API bool LineTrace(const UWorld* World, FPodGroundContactCache& Cache, FHitResult& OutHit, const FVector& Start,
+		const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	// Same, except that in async mode scene traces are answered from the query this probe issued last frame. Game
+	// thread only
+	PROJECTPODRACER_API bool LineTrace(UWorld* World, FPodGroundContactCache& Cache, FPodAsyncGroundProbe& AsyncProbe, FHitResult& OutHit,
+		const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	// Owners of hover ground proxies (generated tracks, UPodGroundProxyComponent) register while they are in play. In a
+	// world with none, PodGround scene traces go straight to the Pod.GroundProbe.PodGroundFallback WorldStatic trace
+	// instead of missing first. Game thread only
+	PROJECTPODRACER_API void RegisterGroundProxyOwner(const UObject* Owner);
+	PROJECTPODRACER_API void UnregisterGroundProxyOwner(const UObject* Owner);
+	PROJECTPODRACER_API bool HasGroundProxies(const UWorld* World);
+}
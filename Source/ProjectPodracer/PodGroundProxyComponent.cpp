@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodGroundProxyComponent.h"
+
+#include "PodGroundProbe.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+
+static const FName NAME_PodGroundProxyProfile(TEXT("PodGroundProxy"));
+
+void UPodGroundProxyComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AActor* Owner = GetOwner();
+	if (!Owner || !Owner->GetRootComponent())
+	{
+		return;
+	}
+
+	if (ProxyMesh)
+	{
+		AddProxy(ProxyMesh, Owner->GetRootComponent());
+		PodGroundProbe::RegisterGroundProxyOwner(this);
+		return;
+	}
+
+	TArray<UStaticMeshComponent*> MeshComponents;
+	Owner->GetComponents(MeshComponents);
+	for (UStaticMeshComponent* MeshComponent : MeshComponents)
+	{
+		UStaticMesh* Mesh = MeshComponent->GetStaticMesh();
+		if (!Mesh)
+		{
+			continue;
+		}
+
+		// Probes trace simple collision, a mesh without any (or cooked complex as simple) defeats the point
+		const UBodySetup* BodySetup = Mesh->GetBodySetup();
+		if (!BodySetup || BodySetup->AggGeom.GetElementCount() == 0 || BodySetup->GetCollisionTraceFlag() == CTF_UseComplexAsSimple)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: %s has no simple collision for hover probes, give it some or set ProxyMesh"),
+				*Owner->GetName(), *Mesh->GetName());
+			continue;
+		}
+
+		AddProxy(Mesh, MeshComponent);
+	}
+
+	if (Proxies.Num() > 0)
+	{
+		PodGroundProbe::RegisterGroundProxyOwner(this);
+	}
+}
+
+void UPodGroundProxyComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (UStaticMeshComponent* Proxy : Proxies)
+	{
+		if (Proxy)
+		{
+			Proxy->DestroyComponent();
+		}
+	}
+	Proxies.Reset();
+	PodGroundProbe::UnregisterGroundProxyOwner(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UStaticMeshComponent* UPodGroundProxyComponent::AddProxy(UStaticMesh* Mesh, USceneComponent* AttachTo)
+{
+	UStaticMeshComponent* Proxy = NewObject<UStaticMeshComponent>(GetOwner());
+	Proxy->SetMobility(AttachTo->Mobility);
+	Proxy->SetStaticMesh(Mesh);
+	Proxy->SetCollisionProfileName(NAME_PodGroundProxyProfile);
+	Proxy->SetVisibility(false);
+	Proxy->SetHiddenInGame(true);
+	Proxy->SetCastShadow(false);
+	Proxy->SetCanEverAffectNavigation(false);
+	Proxy->SetupAttachment(AttachTo);
+	Proxy->RegisterComponent();
+
+	Proxies.Add(Proxy);
+	return Proxy;
+}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "PodGroundProxyComponent.generated.h"
+
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/**
+ * Hover ground for authored track pieces. When play starts it adds hidden, query-only copies of the owner's static
+ * meshes (or ProxyMesh) on the PodGroundProxy collision profile, so hover probes on the PodGround channel hit the
+ * meshes' simple collision and never the render geometry. Generated tracks build their own proxy instead.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class PROJECTPODRACER_API UPodGroundProxyComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Low-poly stand-in for the whole actor, attached to its root. When unset every static mesh on the owner is mirrored
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hover Ground Proxy")
+	TObjectPtr<UStaticMesh> ProxyMesh;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UStaticMeshComponent* AddProxy(UStaticMesh* Mesh, USceneComponent* AttachTo);
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UStaticMeshComponent>> Proxies;
+};
@@ -0,0 +1,185 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodGroundProxyComponent.h"
+#include "PodGroundProbe.h"
+#include "ProjectPodracer.h"
+#include "PodTestWorld.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PodGroundProxyTests
+{
+	// Centre of every Stride-th surface row, raised off the road to trace down from
+	TArray<FVector> GetRoadProbeStarts(const AProceduralTrackGenerator* Track, int32 Stride, float Height)
+	{
+		TArray<float> Distances;
+		TArray<FVector> LeftEdges, RightEdges;
+		Track->GetSurfaceSamples(Distances, LeftEdges, RightEdges);
+		TArray<FVector> Starts;
+		for (int32 Row = 0; Row < LeftEdges.Num(); Row += Stride)
+		{
+			Starts.Add((LeftEdges[Row] + RightEdges[Row]) * 0.5f + FVector(0.f, 0.f, Height));
+		}
+		return Starts;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodGroundProxyTrackTest, "ProjectPodracer.GroundProxy.GeneratedTrack",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Hover probes on PodGround must land on the generated track's slab proxy, and nothing else may. Reports what a trace
+// down onto the road costs on the render mesh against the proxy
+bool FPodGroundProxyTrackTest::RunTest(const FString& Parameters)
+{
+	FPodScopedConsoleVariable NoCache(TEXT("Pod.Track.Cache"), 0);
+	FPodTestWorld TestWorld;
+	AProceduralTrackGenerator* Track = TestWorld.SpawnTrack();
+	if (!TestNotNull(TEXT("Track spawned"), Track))
+	{
+		return false;
+	}
+	Track->Generate();
+
+	const TArray<FVector> Starts = PodGroundProxyTests::GetRoadProbeStarts(Track, 8, 300.f);
+	if (!TestTrue(TEXT("Track has a surface"), Starts.Num() > 0))
+	{
+		return false;
+	}
+
+	struct FChannelCase
+	{
+		const TCHAR* Name;
+		ECollisionChannel Channel;
+		bool bTraceComplex;
+		bool bExpectProxy;
+	};
+	const FChannelCase Cases[] = {
+		{ TEXT("Visibility complex"), ECC_Visibility, true, false },
+		{ TEXT("WorldStatic simple"), ECC_WorldStatic, false, false },
+		{ TEXT("PodGround simple"), ECC_PodGround, false, true },
+	};
+	const FVector Down(0.f, 0.f, -600.f);
+	for (const FChannelCase& Case : Cases)
+	{
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(PodGroundProxyTest), Case.bTraceComplex);
+		int32 Hits = 0;
+		int32 ProxyHits = 0;
+		const double Start = FPlatformTime::Seconds();
+		for (const FVector& ProbeStart : Starts)
+		{
+			FHitResult Hit;
+			if (TestWorld.World->LineTraceSingleByChannel(Hit, ProbeStart, ProbeStart + Down, Case.Channel, Params))
+			{
+				++Hits;
+				ProxyHits += Hit.GetComponent() == Track->GroundProxyMesh;
+			}
+		}
+		const double Seconds = FPlatformTime::Seconds() - Start;
+
+		TestEqual(FString::Printf(TEXT("%s traces hitting the road"), Case.Name), Hits, Starts.Num());
+		TestEqual(FString::Printf(TEXT("%s traces hitting the proxy"), Case.Name), ProxyHits, Case.bExpectProxy ? Starts.Num() : 0);
+		AddInfo(FString::Printf(TEXT("%s: %.3f us/trace over %d traces"), Case.Name, Seconds * 1.0e6 / Starts.Num(), Starts.Num()));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodGroundProxyComponentTest, "ProjectPodracer.GroundProxy.AuthoredPiece",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// An authored piece with UPodGroundProxyComponent answers PodGround with its hidden proxy and everything else with its
+// own mesh
+bool FPodGroundProxyComponentTest::RunTest(const FString& Parameters)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Cube mesh loaded"), Cube))
+	{
+		return false;
+	}
+
+	FPodTestWorld TestWorld;
+	AActor* Piece = TestWorld.World->SpawnActor<AActor>();
+	UStaticMeshComponent* Mesh = NewObject<UStaticMeshComponent>(Piece);
+	Mesh->SetMobility(EComponentMobility::Static);
+	Mesh->SetStaticMesh(Cube);
+	Mesh->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Piece->SetRootComponent(Mesh);
+	Mesh->SetWorldScale3D(FVector(10.f, 10.f, 1.f));
+	Mesh->RegisterComponent();
+
+	// Registering in a world that is playing begins play, which adds the proxy
+	UPodGroundProxyComponent* GroundProxy = NewObject<UPodGroundProxyComponent>(Piece);
+	GroundProxy->RegisterComponent();
+
+	const FVector Start(0.f, 0.f, 500.f);
+	const FVector End(0.f, 0.f, -500.f);
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(PodGroundProxyTest), false);
+	FHitResult PodGroundHit;
+	if (TestTrue(TEXT("PodGround hits the piece"), TestWorld.World->LineTraceSingleByChannel(PodGroundHit, Start, End, ECC_PodGround, Params)))
+	{
+		const UPrimitiveComponent* Proxy = PodGroundHit.GetComponent();
+		TestTrue(TEXT("PodGround hits the proxy, not the mesh"), Proxy && Proxy != Mesh && Proxy->GetOwner() == Piece);
+		TestTrue(TEXT("The proxy is hidden"), Proxy && !Proxy->IsVisible());
+		TestNearlyEqual(TEXT("The proxy is the mesh's shape"), float(PodGroundHit.ImpactPoint.Z), 50.f, 1.f);
+	}
+
+	FHitResult VisibilityHit;
+	if (TestTrue(TEXT("Visibility hits the piece"), TestWorld.World->LineTraceSingleByChannel(VisibilityHit, Start, End, ECC_Visibility, Params)))
+	{
+		TestTrue(TEXT("Visibility hits the mesh"), VisibilityHit.GetComponent() == Mesh);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodGroundProxyFallbackTest, "ProjectPodracer.GroundProxy.WorldWithoutProxies",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// In a world without hover ground proxies a PodGround probe lands on WorldStatic with a single scene query. Once a
+// proxy is in play, PodGround is traced first again
+bool FPodGroundProxyFallbackTest::RunTest(const FString& Parameters)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Cube mesh loaded"), Cube))
+	{
+		return false;
+	}
+
+	FPodScopedConsoleVariable Fallback(TEXT("Pod.GroundProbe.PodGroundFallback"), 1);
+	FPodTestWorld TestWorld;
+	TestWorld.AddStaticBox(FVector(0.f, 0.f, -50.f), FVector(5000.f, 5000.f, 50.f));
+	TestFalse(TEXT("A world with only level geometry has no proxies"), PodGroundProbe::HasGroundProxies(TestWorld.World));
+
+	const FVector Start(0.f, 0.f, 300.f);
+	const FVector End(0.f, 0.f, -300.f);
+	const FCollisionQueryParams Params(PodQueryStats::Tag(EPodQueryClass::PodVehicle), false);
+	auto CountQueries = [](EPodQueryClass QueryClass) { return int32(PodQueryStats::GetFrameQueryCount(QueryClass)); };
+
+	FHitResult Hit;
+	int32 Before = CountQueries(EPodQueryClass::PodVehicle);
+	TestTrue(TEXT("PodGround probe lands on the floor"), PodGroundProbe::LineTrace(TestWorld.World, Hit, Start, End, ECC_PodGround, Params));
+	TestEqual(TEXT("Scene queries without proxies"), CountQueries(EPodQueryClass::PodVehicle) - Before, 1);
+
+	// Registering in a world that is playing begins play, which adds the proxy
+	AActor* Piece = TestWorld.World->SpawnActor<AActor>(FVector(10000.f, 0.f, 0.f), FRotator::ZeroRotator);
+	UStaticMeshComponent* Mesh = NewObject<UStaticMeshComponent>(Piece);
+	Mesh->SetMobility(EComponentMobility::Static);
+	Mesh->SetStaticMesh(Cube);
+	Piece->SetRootComponent(Mesh);
+	Mesh->RegisterComponent();
+	UPodGroundProxyComponent* GroundProxy = NewObject<UPodGroundProxyComponent>(Piece);
+	GroundProxy->RegisterComponent();
+	TestTrue(TEXT("A proxy in play is registered"), PodGroundProbe::HasGroundProxies(TestWorld.World));
+
+	Before = CountQueries(EPodQueryClass::PodVehicle);
+	TestTrue(TEXT("PodGround probe still lands on the floor"), PodGroundProbe::LineTrace(TestWorld.World, Hit, Start, End, ECC_PodGround, Params));
+	TestEqual(TEXT("Scene queries with a proxy elsewhere: PodGround, then the fallback"), CountQueries(EPodQueryClass::PodVehicle) - Before, 2);
+
+	Piece->Destroy();
+	TestFalse(TEXT("The proxy is unregistered with its owner"), PodGroundProbe::HasGroundProxies(TestWorld.World));
+	return true;
+}
+
+#endif
@@ -0,0 +1,198 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodHoverQuerySubsystem.h"
+
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hover ray batch"), STAT_PodHoverRayBatch, STATGROUP_PodGround);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched hover rays"), STAT_PodHoverBatchedRays, STATGROUP_PodGround);
+
+namespace PodHoverQuery
+{
+	static int32 GEnableBatch = 1;
+	static FAutoConsoleVariableRef CVarEnableBatch(
+		TEXT("Pod.HoverBatch.Enable"),
+		GEnableBatch,
+		TEXT("Trace registered pods' hover rays in one batch before they tick (0 = each pod traces its own points)"));
+
+	static int32 GParallelBatch = 1;
+	static FAutoConsoleVariableRef CVarParallelBatch(
+		TEXT("Pod.HoverBatch.Parallel"),
+		GParallelBatch,
+		TEXT("Spread the hover ray batch across worker threads"));
+}
+
+void FPodHoverQueryTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->RunBatch();
+	}
+}
+
+FString FPodHoverQueryTickFunction::DiagnosticMessage()
+{
+	return TEXT("UPodHoverQuerySubsystem::RunBatch");
+}
+
+UPodHoverQuerySubsystem* UPodHoverQuerySubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UPodHoverQuerySubsystem>() : nullptr;
+}
+
+bool UPodHoverQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPodHoverQuerySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	TickFunction.Subsystem = this;
+	TickFunction.TickGroup = TG_PrePhysics;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UPodHoverQuerySubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+	TickFunction.Subsystem = nullptr;
+	Sources.Reset();
+	Batch.Reset();
+
+	Super::Deinitialize();
+}
+
+void UPodHoverQuerySubsystem::RegisterSource(IPodHoverRaySource* Source, FTickFunction& SourceTickFunction)
+{
+	if (Source)
+	{
+		Sources.AddUnique(Source);
+		SourceTickFunction.AddPrerequisite(this, TickFunction);
+	}
+}
+
+void UPodHoverQuerySubsystem::UnregisterSource(IPodHoverRaySource* Source, FTickFunction& SourceTickFunction)
+{
+	Sources.Remove(Source);
+	SourceTickFunction.RemovePrerequisite(this, TickFunction);
+}
+
+void UPodHoverQuerySubsystem::RunBatch()
+{
+	if (!PodHoverQuery::GEnableBatch || Sources.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PodHoverRayBatch);
+
+	Batch.Reset();
+	for (IPodHoverRaySource* Source : Sources)
+	{
+		Source->GatherHoverRays(Batch);
+	}
+	Batch.Run(GetWorld(), PodHoverQuery::GParallelBatch != 0);
+	ResultsFrame = GFrameCounter;
+
+	INC_DWORD_STAT_BY(STAT_PodHoverBatchedRays, Batch.Num());
+}
+
+#if !UE_BUILD_SHIPPING
+namespace PodHoverQuery
+{
+	// Per pod trace cost for a grid of synthetic pods: one fresh params and trace per point (the old AHoverRacerPawn
+	// loop) against the batch run serially and across workers
+	static void BenchCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumPods = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 12;
+		const int32 Iterations = 20;
+		const float PodSpacing = 600.0f;
+		const float PointRadius = 150.0f;
+		const float HoverHeight = 150.0f;
+
+		FVector Center = FVector::ZeroVector;
+		const APlayerController* PlayerController = World->GetFirstPlayerController();
+		if (PlayerController && PlayerController->GetPawn())
+		{
+			Center = PlayerController->GetPawn()->GetActorLocation();
+		}
+
+		for (const int32 PointsPerPod : { 4, 8, 16 })
+		{
+			TArray<TPair<FVector, FVector>> Rays;
+			const int32 PodsPerRow = FMath::CeilToInt(FMath::Sqrt(float(NumPods)));
+			for (int32 Pod = 0; Pod < NumPods; ++Pod)
+			{
+				const FVector PodLocation = Center + FVector((Pod % PodsPerRow) * PodSpacing, (Pod / PodsPerRow) * PodSpacing, 0.0f);
+				for (int32 Point = 0; Point < PointsPerPod; ++Point)
+				{
+					const float Angle = 2.0f * PI * Point / PointsPerPod;
+					const FVector Start = PodLocation + FVector(FMath::Cos(Angle) * PointRadius, FMath::Sin(Angle) * PointRadius, 0.0f);
+					Rays.Emplace(Start, Start - FVector::UpVector * HoverHeight * 2.0f);
+				}
+			}
+
+			double PerPointSeconds = 0.0;
+			int32 PerPointHits = 0;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const double Start = FPlatformTime::Seconds();
+				for (const TPair<FVector, FVector>& Ray : Rays)
+				{
+					FHitResult Hit;
+					FCollisionQueryParams CollisionParams;
+					PerPointHits += World->LineTraceSingleByChannel(Hit, Ray.Key, Ray.Value, ECC_PodGround, CollisionParams) ? 1 : 0;
+				}
+				PerPointSeconds += FPlatformTime::Seconds() - Start;
+			}
+
+			auto TimeBatch = [&](bool bParallel)
+			{
+				FPodGroundRayBatch BenchBatch;
+				double Seconds = 0.0;
+				for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+				{
+					const double Start = FPlatformTime::Seconds();
+					BenchBatch.Reset();
+					for (int32 Pod = 0; Pod < NumPods; ++Pod)
+					{
+						const int32 ParamsIndex = BenchBatch.AddQueryParams(FCollisionQueryParams(SCENE_QUERY_STAT(PodHoverBatchBench), false));
+						for (int32 Point = 0; Point < PointsPerPod; ++Point)
+						{
+							const TPair<FVector, FVector>& Ray = Rays[Pod * PointsPerPod + Point];
+							BenchBatch.AddRay(Ray.Key, Ray.Value, ECC_PodGround, ParamsIndex);
+						}
+					}
+					BenchBatch.Run(World, bParallel);
+					Seconds += FPlatformTime::Seconds() - Start;
+				}
+				return Seconds;
+			};
+			const double SerialSeconds = TimeBatch(false);
+			const double ParallelSeconds = TimeBatch(true);
+
+			const double ToMicrosPerPod = 1.0e6 / (double(Iterations) * NumPods);
+			UE_LOG(LogTemp, Display, TEXT("Pod.HoverBatch.Bench: %d pods x %d points: per point %.2f us/pod, batch %.2f us/pod, parallel batch %.2f us/pod (%d%% of rays hit)"),
+				NumPods, PointsPerPod, PerPointSeconds * ToMicrosPerPod, SerialSeconds * ToMicrosPerPod, ParallelSeconds * ToMicrosPerPod,
+				Rays.Num() > 0 ? 100 * PerPointHits / (Rays.Num() * Iterations) : 0);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs BenchCmd(
+		TEXT("Pod.HoverBatch.Bench"),
+		TEXT("Time hover traces per pod for 4, 8 and 16 points, per point vs batched vs batched on workers, around the player (arg: pod count, default 12)"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchCommand));
+}
+#endif
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "PodGroundProbe.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PodHoverQuerySubsystem.generated.h"
+
+class UPodHoverQuerySubsystem;
+
+// Anything that wants its hover rays run in the shared batch. Rays are gathered from the current transforms before
+// the source ticks, so the source must not move its probes between gathering and reading the results
+class IPodHoverRaySource
+{
+public:
+	virtual ~IPodHoverRaySource() = default;
+	virtual void GatherHoverRays(FPodGroundRayBatch& Batch) = 0;
+};
+
+// Runs the batch in TG_PrePhysics, ahead of the sources that registered as its dependents
+USTRUCT()
+struct FPodHoverQueryTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UPodHoverQuerySubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FPodHoverQueryTickFunction> : public TStructOpsTypeTraitsBase2<FPodHoverQueryTickFunction>
+{
+	enum { WithCopy = false };
+};
+
+/**
+ * Gathers every registered pod's hover rays once per frame and traces them together. Pods read their slice of the
+ * results in their own tick instead of tracing point by point.
+ */
+UCLASS()
+class PROJECTPODRACER_API UPodHoverQuerySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UPodHoverQuerySubsystem* Get(const UWorld* World);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Also makes TickFunction a prerequisite of the source's tick so results are ready when it runs
+	void RegisterSource(IPodHoverRaySource* Source, FTickFunction& SourceTickFunction);
+	void UnregisterSource(IPodHoverRaySource* Source, FTickFunction& SourceTickFunction);
+
+	// True once this frame's batch has run
+	bool HasResultsForFrame(uint64 Frame) const { return ResultsFrame == Frame; }
+	const FPodGroundRayBatch& GetBatch() const { return Batch; }
+
+	void RunBatch();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FPodHoverQueryTickFunction TickFunction;
+	TArray<IPodHoverRaySource*> Sources;
+	FPodGroundRayBatch Batch;
+	uint64 ResultsFrame = MAX_uint64;
+};
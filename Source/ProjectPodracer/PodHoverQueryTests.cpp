@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodGroundProbe.h"
+#include "PodTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodHoverBatchTest, "ProjectPodracer.HoverBatch.MatchesPerPointTraces",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Twelve pods over a floor and a tilted slab, with 4, 8 and 16 hover points each. The batch, run serially and across
+// workers, must hit exactly what tracing point by point hits, and the cost of each per pod is reported
+bool FPodHoverBatchTest::RunTest(const FString& Parameters)
+{
+	FPodTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+	TestWorld.AddStaticBox(FVector(0.f, 0.f, -50.f), FVector(5000.f, 5000.f, 50.f));
+	TestWorld.AddStaticBox(FVector(900.f, 900.f, 0.f), FVector(800.f, 800.f, 40.f), FRotator(10.f, 0.f, 5.f));
+
+	constexpr int32 NumPods = 12;
+	constexpr int32 PodsPerRow = 4;
+	constexpr int32 Iterations = 20;
+	constexpr float PodSpacing = 600.f;
+	constexpr float PointRadius = 150.f;
+	constexpr float HoverHeight = 300.f;
+	const ECollisionChannel Channel = ECC_WorldStatic;
+
+	for (const int32 PointsPerPod : { 4, 8, 16 })
+	{
+		TArray<TPair<FVector, FVector>> Rays;
+		for (int32 Pod = 0; Pod < NumPods; ++Pod)
+		{
+			const FVector PodLocation((Pod % PodsPerRow) * PodSpacing, (Pod / PodsPerRow) * PodSpacing, HoverHeight);
+			for (int32 Point = 0; Point < PointsPerPod; ++Point)
+			{
+				const float Angle = 2.f * PI * Point / PointsPerPod;
+				const FVector Start = PodLocation + FVector(FMath::Cos(Angle) * PointRadius, FMath::Sin(Angle) * PointRadius, 0.f);
+				Rays.Emplace(Start, Start - FVector::UpVector * HoverHeight * 2.f);
+			}
+		}
+
+		// A fresh params and trace per point, the way AHoverRacerPawn used to
+		TArray<FHitResult> PerPointHits;
+		TBitArray<> PerPointHit(false, Rays.Num());
+		PerPointHits.SetNum(Rays.Num());
+		double PerPointSeconds = 0.0;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < Rays.Num(); ++Index)
+			{
+				FCollisionQueryParams Params(SCENE_QUERY_STAT(PodHoverBatchTest), false);
+				PerPointHit[Index] = PodGroundProbe::LineTrace(World, PerPointHits[Index], Rays[Index].Key, Rays[Index].Value, Channel, Params);
+			}
+			PerPointSeconds += FPlatformTime::Seconds() - Start;
+		}
+
+		for (const bool bParallel : { false, true })
+		{
+			FPodGroundRayBatch Batch;
+			double BatchSeconds = 0.0;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const double Start = FPlatformTime::Seconds();
+				Batch.Reset();
+				for (int32 Pod = 0; Pod < NumPods; ++Pod)
+				{
+					const int32 ParamsIndex = Batch.AddQueryParams(FCollisionQueryParams(SCENE_QUERY_STAT(PodHoverBatchTest), false));
+					for (int32 Point = 0; Point < PointsPerPod; ++Point)
+					{
+						const TPair<FVector, FVector>& Ray = Rays[Pod * PointsPerPod + Point];
+						Batch.AddRay(Ray.Key, Ray.Value, Channel, ParamsIndex);
+					}
+				}
+				Batch.Run(World, bParallel);
+				BatchSeconds += FPlatformTime::Seconds() - Start;
+			}
+
+			const FString Case = FString::Printf(TEXT("%d points, %s batch"), PointsPerPod, bParallel ? TEXT("parallel") : TEXT("serial"));
+			if (!TestEqual(FString::Printf(TEXT("%s ray count"), *Case), Batch.Num(), Rays.Num()))
+			{
+				continue;
+			}
+			int32 Mismatches = 0;
+			int32 Hits = 0;
+			for (int32 Index = 0; Index < Rays.Num(); ++Index)
+			{
+				Hits += Batch.HasHit(Index);
+				Mismatches += Batch.HasHit(Index) != PerPointHit[Index]
+					|| (PerPointHit[Index] && !Batch.GetHit(Index).ImpactPoint.Equals(PerPointHits[Index].ImpactPoint, 0.01));
+			}
+			TestEqual(FString::Printf(TEXT("%s rays differing from per point traces"), *Case), Mismatches, 0);
+			TestEqual(FString::Printf(TEXT("%s rays hitting the ground"), *Case), Hits, Rays.Num());
+
+			const double ToMicrosPerPod = 1.0e6 / (double(Iterations) * NumPods);
+			AddInfo(FString::Printf(TEXT("%s: per point %.2f us/pod, batch %.2f us/pod"), *Case, PerPointSeconds * ToMicrosPerPod, BatchSeconds * ToMicrosPerPod));
+		}
+	}
+	return true;
+}
+
+#endif
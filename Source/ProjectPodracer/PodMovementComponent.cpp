@@ -6,6 +6,8 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Net/Core/PushModel/PushModel.h"
+#include "PodDeterminismHarness.h"
+#include "PodGroundProbe.h"
 
 UPodMovementComponent::UPodMovementComponent()
 {
@@ -21,6 +23,14 @@ UPodMovementComponent::UPodMovementComponent()
     StartupDelayTimer = 1.0f;
 }
 
+void UPodMovementComponent::PostLoad()
+{
+    Super::PostLoad();
+#if WITH_EDITORONLY_DATA
+    UPodTuningDataAsset::MigrateDeprecatedTuning(this, &ThisClass::TuningAsset, &UPodTuningDataAsset::Movement);
+#endif
+}
+
 void UPodMovementComponent::BeginPlay()
 {
     Super::BeginPlay();
@@ -30,6 +40,7 @@ void UPodMovementComponent::BeginPlay()
     {
         Engines = PodRacer->GetEngines();
     }
+    RefreshRoleTick();
     if (bEnableDebugLogging)
     {
         UBoxComponent* PhysicsBody = GetPhysicsBody();
@@ -47,20 +58,58 @@ void UPodMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType,
     {
         StartupDelayTimer -= DeltaTime; return;
     }
-    if (!PawnOwner || !UpdatedComponent || ShouldSkipUpdate(DeltaTime)) return;
+    if (!PawnOwner || !UpdatedComponent || ShouldSkipUpdate(DeltaTime) || !RoleTick) return;
 
-    UpdateMoveSendInterval(DeltaTime);
-    UBoxComponent* PhysicsBody = GetPhysicsBody();
-    if (PhysicsBody)
+    (this->*RoleTick)(DeltaTime);
+}
+
+void UPodMovementComponent::RefreshRoleTick()
+{
+    if (!PawnOwner)
+    {
+        RoleTick = nullptr;
+        return;
+    }
+    const EPodTickRole Role = PodTickRole::Resolve(PawnOwner);
+    RoleTick = TPodRoleTickSelector<UPodMovementComponent>::Select(Role, bEnableDebugLogging);
+    if (bEnableDebugLogging)
+    {
+        UE_LOG(LogTemp, Log, TEXT("PodMovement RoleTick bound: Role=%d, NetRole=%d"), (int32)Role, (int32)PawnOwner->GetLocalRole());
+    }
+}
+
+#if WITH_EDITOR
+void UPodMovementComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UPodMovementComponent, bEnableDebugLogging) && RoleTick)
+    {
+        RefreshRoleTick();
+    }
+}
+#endif
+
+template<EPodTickRole Role, bool bDebug>
+void UPodMovementComponent::TickRole(float DeltaTime)
+{
+    constexpr bool bLocallyControlled = Role == EPodTickRole::LocalAuthority || Role == EPodTickRole::AutonomousProxy;
+    constexpr bool bAuthority = Role == EPodTickRole::LocalAuthority || Role == EPodTickRole::Authority;
+
+    if constexpr (bLocallyControlled)
     {
-        // Only apply hover for locally controlled or server-authoritative vehicles
-        if (PawnOwner->IsLocallyControlled() || PawnOwner->HasAuthority())
+        UpdateMoveSendInterval(DeltaTime);
+    }
+
+    // Only apply hover for locally controlled or server-authoritative vehicles, simulated proxies follow ServerState
+    if constexpr (bLocallyControlled || bAuthority)
+    {
+        if (UBoxComponent* PhysicsBody = GetPhysicsBody())
         {
             ApplyHover(DeltaTime, PhysicsBody);
         }
     }
 
-    if (PawnOwner->IsLocallyControlled())
+    if constexpr (bLocallyControlled)
     {
         // Smooth rudder input
         SmoothedRudderInput = FMath::FInterpTo(SmoothedRudderInput, RawRudderInput, DeltaTime, 5.0f);
@@ -71,7 +120,7 @@ void UPodMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType,
         {
             UnacknowledgedMoves.Add(LastCreatedMove);
             Server_SendMove(LastCreatedMove);
-            if (bEnableDebugLogging)
+            if constexpr (bDebug)
             {
                 UE_LOG(LogTemp, Log, TEXT("Sending Move: MoveNumber=%d, Timestamp=%.3f, Pos=%s, Thruster=%.3f, Rudder=%.3f"),
                 LastCreatedMove.MoveNumber, LastCreatedMove.Timestamp, *GetPhysicsBody()->GetComponentLocation().ToString(),
@@ -79,7 +128,7 @@ void UPodMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType,
             }
             MoveSendTimer = MoveSendInterval;
         }
-        else if (PawnOwner->HasAuthority())
+        else if constexpr (bAuthority)
         {
             // Handle server-controlled vehicles
             SmoothedRudderInput = FMath::FInterpTo(SmoothedRudderInput, RawRudderInput, DeltaTime, 5.0f);
@@ -88,7 +137,7 @@ void UPodMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType,
             UpdateServerState(DeltaTime);
             // TODO: Force replication
             GetOwner()->ForceNetUpdate();
-            if (bEnableDebugLogging)
+            if constexpr (bDebug)
             {
                 UE_LOG(LogTemp, Log, TEXT("Server Vehicle Move: MoveNumber=%d, Timestamp=%.3f, Pos=%s, Thruster=%.3f, Rudder=%.3f"),
                     LastCreatedMove.MoveNumber, LastCreatedMove.Timestamp, *GetPhysicsBody()->GetComponentLocation().ToString(),
@@ -100,32 +149,34 @@ void UPodMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 
 void UPodMovementComponent::UpdateMoveSendInterval(float DeltaTime)
 {
-    if (PawnOwner->IsLocallyControlled())
+    // Only called from the locally controlled role ticks
+    float LastMoveAckTime = ServerState.LastMove.IsValid() ? ServerState.LastMove.Timestamp : GetWorld()->GetTimeSeconds();
+    float CurrentTime = GetWorld()->GetTimeSeconds();
+    EstimatedLatency = FMath::Lerp(EstimatedLatency, CurrentTime - LastMoveAckTime, 0.2f);
+    MoveSendInterval = FMath::Clamp(0.05f + EstimatedLatency * 2.0f, 0.05f, 0.5f);
+    /*
+    if (bEnableDebugLogging)
     {
-        float LastMoveAckTime = ServerState.LastMove.IsValid() ? ServerState.LastMove.Timestamp : GetWorld()->GetTimeSeconds();
-        float CurrentTime = GetWorld()->GetTimeSeconds();
-        EstimatedLatency = FMath::Lerp(EstimatedLatency, CurrentTime - LastMoveAckTime, 0.2f);
-        MoveSendInterval = FMath::Clamp(0.05f + EstimatedLatency * 2.0f, 0.05f, 0.5f);
-        /*
-        if (bEnableDebugLogging)
-        {
-            UE_LOG(LogTemp, Log, TEXT("Updated MoveSendInterval: Latency=%.3f, Interval=%.3f, MovesBuffered=%d"), EstimatedLatency, MoveSendInterval, UnacknowledgedMoves.Num());
-        }
-        */
+        UE_LOG(LogTemp, Log, TEXT("Updated MoveSendInterval: Latency=%.3f, Interval=%.3f, MovesBuffered=%d"), EstimatedLatency, MoveSendInterval, UnacknowledgedMoves.Num());
     }
+    */
 }
 
-void UPodMovementComponent::ApplyHover(float DeltaTime, UBoxComponent* PhysicsBody)
+void UPodMovementComponent::ApplyHover(float DeltaTime, UBoxComponent* PhysicsBody, bool bLiveStep)
 {
+    const FPodMovementTuning& Tuning = GetTuning();
     if (!PhysicsBody) return;
     FVector Start = PhysicsBody->GetComponentLocation();
-    FVector End = Start - FVector::UpVector * MaxGroundDist;
+    FVector End = Start - FVector::UpVector * Tuning.MaxGroundDist;
     FHitResult HitResult;
-    FCollisionQueryParams QueryParams;
+    FCollisionQueryParams QueryParams(PodQueryStats::Tag(EPodQueryClass::PodMovement));
     QueryParams.AddIgnoredActor(PawnOwner);
-    Height = MaxGroundDist;
+    Height = Tuning.MaxGroundDist;
 
-    if (GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, GroundCollisionChannel, QueryParams))
+    const bool bHit = bLiveStep
+        ? PodGroundProbe::LineTrace(GetWorld(), GroundContactCache, AsyncGroundProbe, HitResult, Start, End, Tuning.GroundCollisionChannel, QueryParams)
+        : PodGroundProbe::LineTrace(GetWorld(), HitResult, Start, End, Tuning.GroundCollisionChannel, QueryParams);
+    if (bHit)
     {
         bIsOnGround = true;
         Height = HitResult.Distance;
@@ -135,23 +186,23 @@ void UPodMovementComponent::ApplyHover(float DeltaTime, UBoxComponent* PhysicsBo
             GroundNormal = FVector::UpVector;
         }
         // Set position at HoverHeight above ground
-        FVector TargetLocation = HitResult.Location + GroundNormal * HoverHeight;
+        FVector TargetLocation = HitResult.Location + GroundNormal * Tuning.HoverHeight;
         PhysicsBody->SetWorldLocation(TargetLocation, false, nullptr, ETeleportType::TeleportPhysics);
         // Align rotation to ground normal
         FVector Projection = UKismetMathLibrary::ProjectVectorOnToPlane(PhysicsBody->GetForwardVector(), GroundNormal);
         if (!Projection.IsNearlyZero() && !GroundNormal.IsNearlyZero())
         {
             FRotator TargetRotation = UKismetMathLibrary::MakeRotFromZX(GroundNormal, Projection);
-            FRotator NewRotation = FMath::RInterpTo(PhysicsBody->GetComponentRotation(), TargetRotation, DeltaTime, RotationInterpSpeed);
+            FRotator NewRotation = FMath::RInterpTo(PhysicsBody->GetComponentRotation(), TargetRotation, DeltaTime, Tuning.RotationInterpSpeed);
             PhysicsBody->SetWorldRotation(NewRotation);
         }
 
         // Preserve XY velocity, clear Z
         FVector CurrentVelocity = PhysicsBody->GetPhysicsLinearVelocity();
         CurrentVelocity = FVector::VectorPlaneProject(CurrentVelocity, GroundNormal);
-        if (CurrentVelocity.SizeSquared() > FMath::Square(MaxVelocity))
+        if (CurrentVelocity.SizeSquared() > FMath::Square(Tuning.MaxVelocity))
         {
-            CurrentVelocity = CurrentVelocity.GetSafeNormal() * MaxVelocity;
+            CurrentVelocity = CurrentVelocity.GetSafeNormal() * Tuning.MaxVelocity;
         }
         PhysicsBody->SetPhysicsLinearVelocity(CurrentVelocity, false);
         /*
@@ -167,11 +218,11 @@ void UPodMovementComponent::ApplyHover(float DeltaTime, UBoxComponent* PhysicsBo
         bIsOnGround = false;
         GroundNormal = FVector::UpVector;
         // Apply gravity when airborne
-        PhysicsBody->AddForce(FVector(0.0f, 0.0f, -FallGravity * Mass));
+        PhysicsBody->AddForce(FVector(0.0f, 0.0f, -Tuning.FallGravity * Tuning.Mass));
         FVector CurrentVelocity = PhysicsBody->GetPhysicsLinearVelocity();
-        if (CurrentVelocity.SizeSquared() > FMath::Square(MaxVelocity))
+        if (CurrentVelocity.SizeSquared() > FMath::Square(Tuning.MaxVelocity))
         {
-            CurrentVelocity = CurrentVelocity.GetSafeNormal() * MaxVelocity;
+            CurrentVelocity = CurrentVelocity.GetSafeNormal() * Tuning.MaxVelocity;
             PhysicsBody->SetPhysicsLinearVelocity(CurrentVelocity, false);
         }
         if (bEnableDebugLogging)
@@ -182,7 +233,10 @@ void UPodMovementComponent::ApplyHover(float DeltaTime, UBoxComponent* PhysicsBo
 
     if (PawnOwner->HasAuthority())
     {
-        ServerState.GroundNormal = GroundNormal;
+        if (bLiveStep)
+        {
+            ServerState.GroundNormal = GroundNormal;
+        }
     }
     else if (!ServerState.GroundNormal.IsNormalized())
     {
@@ -191,7 +245,10 @@ void UPodMovementComponent::ApplyHover(float DeltaTime, UBoxComponent* PhysicsBo
 
     if (bWasOnGroundLastFrame != bIsOnGround)
     {
-        OnGroundStateChanged.Broadcast(bIsOnGround);
+        if (bLiveStep)
+        {
+            OnGroundStateChanged.Broadcast(bIsOnGround);
+        }
         bWasOnGroundLastFrame = bIsOnGround;
     }
 }
@@ -235,13 +292,18 @@ void UPodMovementComponent::SimulateMove(const FPodRacerMoveStruct& Move) {
     float DeltaTime = Move.DeltaTime;
     if (DeltaTime <= 0.0f) return;
 
+#if WITH_POD_DETERMINISM_HARNESS
+    FPodDeterminismHarness::NotifySimulateMove(this, Move);
+#endif
+
+    const FPodMovementTuning& Tuning = GetTuning();
     FVector ForwardVector = PhysicsBody->GetForwardVector();
     FVector CurrentVelocity = PhysicsBody->GetPhysicsLinearVelocity();
-    float ControlMultiplier = bIsOnGround ? 1.0f : AirControlMultiplier;
-    float EffectiveMaxSpeed = MaxSpeed * (Move.bIsBoosting ? BoostSpeedMultiplier : 1.0f);
+    float ControlMultiplier = bIsOnGround ? 1.0f : Tuning.AirControlMultiplier;
+    float EffectiveMaxSpeed = Tuning.MaxSpeed * (Move.bIsBoosting ? Tuning.BoostSpeedMultiplier : 1.0f);
 
     // Apply rotation (yaw) from RudderInput
-    float EffectiveTurnRate = TurnRate * ControlMultiplier * (Move.bIsDrifting ? DriftTurnRateMultiplier : 1.0f);
+    float EffectiveTurnRate = Tuning.TurnRate * ControlMultiplier * (Move.bIsDrifting ? Tuning.DriftTurnRateMultiplier : 1.0f);
     float YawDelta = Move.RudderInput * EffectiveTurnRate * DeltaTime;
     FRotator CurrentRotation = PhysicsBody->GetComponentRotation();
     FRotator NewRotation = FRotator(CurrentRotation.Pitch, CurrentRotation.Yaw + YawDelta, CurrentRotation.Roll);
@@ -255,14 +317,14 @@ void UPodMovementComponent::SimulateMove(const FPodRacerMoveStruct& Move) {
         float Speed = CurrentVelocity.Size();
         if (Speed > 0.0f)
         {
-            float NewSpeed = FMath::Max(0.0f, Speed - BrakeDeceleration * DeltaTime);
+            float NewSpeed = FMath::Max(0.0f, Speed - Tuning.BrakeDeceleration * DeltaTime);
             CurrentVelocity = VelocityDir * NewSpeed;
         }
     }
     else
     {
         // Accelerate
-        FVector AccelerationVector = ForwardVector * Move.ThrusterInput * Acceleration * ControlMultiplier;
+        FVector AccelerationVector = ForwardVector * Move.ThrusterInput * Tuning.Acceleration * ControlMultiplier;
         CurrentVelocity += AccelerationVector * DeltaTime;
     }
 
@@ -337,6 +399,7 @@ bool UPodMovementComponent::Server_SendMove_Validate(const FPodRacerMoveStruct&
 
 void UPodMovementComponent::UpdateServerState(float DeltaTime)
 {
+    const FPodMovementTuning& Tuning = GetTuning();
     UBoxComponent* PhysicsBody = GetPhysicsBody();
     if (!PhysicsBody || !PawnOwner->HasAuthority()) return;
     // Always update ServerState to ensure DOREPLIFETIME detects changes
@@ -349,7 +412,7 @@ void UPodMovementComponent::UpdateServerState(float DeltaTime)
     
 
     ServerStateUpdateTimer -= DeltaTime;
-    bool bNeedsUpdate = FVector::Dist(PhysicsBody->GetComponentLocation(), LastServerPosition) > ServerStateUpdateThreshold ||
+    bool bNeedsUpdate = FVector::Dist(PhysicsBody->GetComponentLocation(), LastServerPosition) > Tuning.ServerStateUpdateThreshold ||
                         ServerState.LinearVelocity != PhysicsBody->GetPhysicsLinearVelocity() ||
                         ServerState.GroundNormal != GroundNormal ||
                         ServerStateUpdateTimer <= 0.0f;
@@ -357,7 +420,7 @@ void UPodMovementComponent::UpdateServerState(float DeltaTime)
     if (bNeedsUpdate)
     {
         LastServerPosition = PhysicsBody->GetComponentLocation();
-        ServerStateUpdateTimer = ServerStateForceUpdateInterval;
+        ServerStateUpdateTimer = Tuning.ServerStateForceUpdateInterval;
         GetOwner()->ForceNetUpdate();
 
         if (bEnableDebugLogging)
@@ -378,6 +441,7 @@ void UPodMovementComponent::UpdateServerState(float DeltaTime)
 
 void UPodMovementComponent::OnRep_ServerState()
 {
+    const FPodMovementTuning& Tuning = GetTuning();
     // Implement state reconciliation logic here
     // // Example: Correct client position based on ServerState
     UBoxComponent* PhysicsBody = GetPhysicsBody();
@@ -396,12 +460,12 @@ void UPodMovementComponent::OnRep_ServerState()
         FVector ClientPos = PhysicsBody->GetComponentLocation();
         FVector ServerPos = ServerState.Transform.GetLocation();
         float PosDiff = FVector::Dist(ClientPos, ServerPos);
-        bool bNeedsCorrection = PosDiff > CorrectionThreshold;
+        bool bNeedsCorrection = PosDiff > Tuning.CorrectionThreshold;
 
         if (bNeedsCorrection)
         {
             // Interpolate position
-            FVector NewPos = FMath::VInterpTo(ClientPos, ServerPos, GetWorld()->GetDeltaSeconds(), CorrectionInterpSpeed);
+            FVector NewPos = FMath::VInterpTo(ClientPos, ServerPos, GetWorld()->GetDeltaSeconds(), Tuning.CorrectionInterpSpeed);
             PhysicsBody->SetWorldLocation(NewPos, false, nullptr, ETeleportType::TeleportPhysics);
 
             // Update velocity
@@ -415,7 +479,7 @@ void UPodMovementComponent::OnRep_ServerState()
             // Interpolate rotation
             FRotator ClientRot = PhysicsBody->GetComponentRotation();
             FRotator ServerRot = ServerState.Transform.Rotator();
-            FRotator NewRot = FMath::RInterpTo(ClientRot, ServerRot, GetWorld()->GetDeltaSeconds(), CorrectionInterpSpeed);
+            FRotator NewRot = FMath::RInterpTo(ClientRot, ServerRot, GetWorld()->GetDeltaSeconds(), Tuning.CorrectionInterpSpeed);
             PhysicsBody->SetWorldRotation(NewRot);
 
             // Replay unacknowledged moves
@@ -427,9 +491,14 @@ void UPodMovementComponent::OnRep_ServerState()
                     MovesToReplay.Add(UnackedMove);
                 }
             }
-            for (const FPodRacerMoveStruct& Move : MovesToReplay)
             {
-                SimulateMove(Move);
+#if WITH_POD_DETERMINISM_HARNESS
+                FPodDeterminismHarness::FScopedCorrectionReplay CorrectionReplay;
+#endif
+                for (const FPodRacerMoveStruct& Move : MovesToReplay)
+                {
+                    SimulateMove(Move);
+                }
             }
 
             if (bEnableDebugLogging)
@@ -452,7 +521,7 @@ void UPodMovementComponent::OnRep_ServerState()
         float PosDiff = FVector::Dist(CurrentPos, ServerPos);
 
         // Interpolate position
-        FVector NewPos = FMath::VInterpTo(CurrentPos, ServerPos, GetWorld()->GetDeltaSeconds(), CorrectionInterpSpeed);
+        FVector NewPos = FMath::VInterpTo(CurrentPos, ServerPos, GetWorld()->GetDeltaSeconds(), Tuning.CorrectionInterpSpeed);
         PhysicsBody->SetWorldLocation(NewPos, false, nullptr, ETeleportType::TeleportPhysics);
 
         // Update velocity
@@ -461,7 +530,7 @@ void UPodMovementComponent::OnRep_ServerState()
         // Interpolate rotation
         FRotator CurrentRot = PhysicsBody->GetComponentRotation();
         FRotator ServerRot = ServerState.Transform.Rotator();
-        FRotator NewRot = FMath::RInterpTo(CurrentRot, ServerRot, GetWorld()->GetDeltaSeconds(), CorrectionInterpSpeed);
+        FRotator NewRot = FMath::RInterpTo(CurrentRot, ServerRot, GetWorld()->GetDeltaSeconds(), Tuning.CorrectionInterpSpeed);
         PhysicsBody->SetWorldRotation(NewRot);
 
         // Update ground normal for consistency
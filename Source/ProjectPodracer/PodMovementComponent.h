@@ -7,6 +7,9 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PawnMovementComponent.h"
 #include "EngineComponent.h"
+#include "PodGroundProbe.h"
+#include "PodTickRole.h"
+#include "PodTuningDataAsset.h"
 #include "PodMovementComponent.generated.h"
 
 class UBoxComponent;
@@ -60,8 +63,15 @@ class PROJECTPODRACER_API UPodMovementComponent : public UPawnMovementComponent
 public:
     UPodMovementComponent();
     virtual void BeginPlay() override;
+    virtual void PostLoad() override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+    // Binds the tick path for the owner's current role, called by the pawn when its controller or net role changes
+    void RefreshRoleTick();
 
     void SetThrusterInput(float Input) { RawThrusterInput = Input; }
     void SetRudderInput(float Input) { RawRudderInput = Input; }
@@ -85,42 +95,31 @@ protected:
     void OnRep_ServerState();
     UPROPERTY(Replicated, EditAnywhere, Category = "PodRacer")
     bool bWasOnGroundLastFrame;
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Hover")
-    float HoverHeight = 100.0f;
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Hover")
-    float MaxGroundDist = 500.0f;
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Hover")
-    float RotationInterpSpeed = 10.0f; // Degrees per second
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float Mass = 1000.0f;
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float FallGravity = 4905.0f;
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float MaxVelocity = 2000.0f; // 20m/s
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float MaxSpeed = 1500.0f; // 15m/s
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float Acceleration = 2000.0f; // cm/s^2
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float TurnRate = 90.0f; // Degrees/s
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float BrakeDeceleration = 3000.0f; // cm/s^2
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float DriftTurnRateMultiplier = 1.5f;
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float BoostSpeedMultiplier = 1.5f;
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float AirControlMultiplier = 0.3f;
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float CorrectionThreshold = 10.0f; // cm
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float CorrectionInterpSpeed = 10.0f; // Units/s
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float ServerStateUpdateThreshold = 5.0f; // cm, for triggering ForceNetUpdate
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    float ServerStateForceUpdateInterval = 0.1f; // Seconds, for periodic updates
-    UPROPERTY(EditAnywhere, Category = "PodRacer|Physics")
-    TEnumAsByte<ECollisionChannel> GroundCollisionChannel = ECC_WorldStatic;
+    // Shared tuning asset, pods of the same class should all reference one. Defaults are used when unset
+    UPROPERTY(EditAnywhere, Category = "PodRacer")
+    TObjectPtr<UPodTuningDataAsset> TuningAsset;
+    const FPodMovementTuning& GetTuning() const { return UPodTuningDataAsset::GetMovementTuning(TuningAsset); }
+#if WITH_EDITORONLY_DATA
+    // Tuning saved per instance before TuningAsset, checked against the class default asset by PostLoad
+    UPROPERTY() float HoverHeight_DEPRECATED = 100.0f;
+    UPROPERTY() float MaxGroundDist_DEPRECATED = 500.0f;
+    UPROPERTY() float RotationInterpSpeed_DEPRECATED = 10.0f;
+    UPROPERTY() float Mass_DEPRECATED = 1000.0f;
+    UPROPERTY() float FallGravity_DEPRECATED = 4905.0f;
+    UPROPERTY() float MaxVelocity_DEPRECATED = 2000.0f;
+    UPROPERTY() float MaxSpeed_DEPRECATED = 1500.0f;
+    UPROPERTY() float Acceleration_DEPRECATED = 2000.0f;
+    UPROPERTY() float TurnRate_DEPRECATED = 90.0f;
+    UPROPERTY() float BrakeDeceleration_DEPRECATED = 3000.0f;
+    UPROPERTY() float DriftTurnRateMultiplier_DEPRECATED = 1.5f;
+    UPROPERTY() float BoostSpeedMultiplier_DEPRECATED = 1.5f;
+    UPROPERTY() float AirControlMultiplier_DEPRECATED = 0.3f;
+    UPROPERTY() float CorrectionThreshold_DEPRECATED = 10.0f;
+    UPROPERTY() float CorrectionInterpSpeed_DEPRECATED = 10.0f;
+    UPROPERTY() float ServerStateUpdateThreshold_DEPRECATED = 5.0f;
+    UPROPERTY() float ServerStateForceUpdateInterval_DEPRECATED = 0.1f;
+    UPROPERTY() TEnumAsByte<ECollisionChannel> GroundCollisionChannel_DEPRECATED = ECC_WorldStatic;
+#endif
     UPROPERTY(EditAnywhere, Category = "Debug")
     bool bEnableDebugLogging = true;
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGroundStateChanged, bool, bIsOnGround);
@@ -131,6 +130,10 @@ private:
     UPROPERTY()
     TArray<UEngineComponent*> Engines;
     TArray<FPodRacerMoveStruct> UnacknowledgedMoves;
+    // Ground plane reused between hover traces while the pod stays on it
+    FPodGroundContactCache GroundContactCache;
+    // Last frame's hover query when Pod.GroundProbe.Async is on
+    FPodAsyncGroundProbe AsyncGroundProbe;
 
     // --- State & Input ---
     FPodRacerMoveStruct LastCreatedMove;
@@ -155,11 +158,23 @@ private:
     int32 ServerStateReplicationCounter = 0; // Debug counter for server
 
     void UpdateMoveSendInterval(float DeltaTime);
-    void ApplyHover(float DeltaTime, UBoxComponent* PhysicsBody);
+    // Determinism replays pass bLiveStep false: the probe skips the contact cache and async probe, and ServerState
+    // and OnGroundStateChanged are left alone
+    void ApplyHover(float DeltaTime, UBoxComponent* PhysicsBody, bool bLiveStep = true);
     void UpdateServerState(float DeltaTime);
 
     UBoxComponent* GetPhysicsBody() const;
     class AReplicatedPodRacer* GetPodRacerOwner() const;
+
+    // --- Role Tick ---
+    using FRoleTickFunction = void (UPodMovementComponent::*)(float DeltaTime);
+    FRoleTickFunction RoleTick = nullptr;
+
+    template<EPodTickRole Role, bool bDebug>
+    void TickRole(float DeltaTime);
+
+    friend struct TPodRoleTickSelector<UPodMovementComponent>;
+    friend class FPodDeterminismHarness;
 };
 
 /*
@@ -0,0 +1,199 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodQueryStats.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include <atomic>
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line traces"), STAT_PodQueryLines, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sweeps"), STAT_PodQuerySweeps, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Complex queries"), STAT_PodQueryComplex, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Total us"), STAT_PodQueryMicros, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cosmetic queries skipped"), STAT_PodQueryCosmeticSkipped, STATGROUP_PodQueries);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("PodVehicle queries"), STAT_PodQueryCountPodVehicle, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PodVehicle us"), STAT_PodQueryMicrosPodVehicle, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PodMovement queries"), STAT_PodQueryCountPodMovement, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PodMovement us"), STAT_PodQueryMicrosPodMovement, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PodracerMovement queries"), STAT_PodQueryCountPodracerMovement, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PodracerMovement us"), STAT_PodQueryMicrosPodracerMovement, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EngineController queries"), STAT_PodQueryCountEngineController, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EngineController us"), STAT_PodQueryMicrosEngineController, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HoverJetEngine queries"), STAT_PodQueryCountHoverJetEngine, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HoverJetEngine us"), STAT_PodQueryMicrosHoverJetEngine, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HoverRacer queries"), STAT_PodQueryCountHoverRacer, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HoverRacer us"), STAT_PodQueryMicrosHoverRacer, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HoverRacerPawn queries"), STAT_PodQueryCountHoverRacerPawn, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HoverRacerPawn us"), STAT_PodQueryMicrosHoverRacerPawn, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RayCastVehicle queries"), STAT_PodQueryCountRayCastVehicle, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RayCastVehicle us"), STAT_PodQueryMicrosRayCastVehicle, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SimulatedRayCastVehicle queries"), STAT_PodQueryCountSimulatedRayCastVehicle, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SimulatedRayCastVehicle us"), STAT_PodQueryMicrosSimulatedRayCastVehicle, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Other queries"), STAT_PodQueryCountOther, STATGROUP_PodQueries);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Other us"), STAT_PodQueryMicrosOther, STATGROUP_PodQueries);
+
+CSV_DEFINE_CATEGORY(PodQueries, true);
+
+namespace PodQueryStats
+{
+	static float GBudgetMs = 0.0f;
+	static FAutoConsoleVariableRef CVarBudgetMs(
+		TEXT("Pod.Queries.BudgetMs"),
+		GBudgetMs,
+		TEXT("Scene query time per frame after which cosmetic pod queries (visual pitch) are skipped (0 = no budget)"));
+
+	constexpr int32 NumClasses = static_cast<int32>(EPodQueryClass::Num);
+
+	struct FClassInfo
+	{
+		FName Tag;
+		FName CsvCount;
+		FName CsvMs;
+#if STATS
+		FName CountStat;
+		FName MicrosStat;
+#endif
+	};
+
+	static const FClassInfo& GetClassInfo(EPodQueryClass QueryClass)
+	{
+#if STATS
+		#define POD_QUERY_CLASS(Name) { FName(TEXT(#Name)), FName(TEXT(#Name "_Count")), FName(TEXT(#Name "_Ms")), GET_STATFNAME(STAT_PodQueryCount##Name), GET_STATFNAME(STAT_PodQueryMicros##Name) }
+#else
+		#define POD_QUERY_CLASS(Name) { FName(TEXT(#Name)), FName(TEXT(#Name "_Count")), FName(TEXT(#Name "_Ms")) }
+#endif
+		static const FClassInfo Classes[NumClasses] = {
+			POD_QUERY_CLASS(PodVehicle),
+			POD_QUERY_CLASS(PodMovement),
+			POD_QUERY_CLASS(PodracerMovement),
+			POD_QUERY_CLASS(EngineController),
+			POD_QUERY_CLASS(HoverJetEngine),
+			POD_QUERY_CLASS(HoverRacer),
+			POD_QUERY_CLASS(HoverRacerPawn),
+			POD_QUERY_CLASS(RayCastVehicle),
+			POD_QUERY_CLASS(SimulatedRayCastVehicle),
+			POD_QUERY_CLASS(Other),
+		};
+		#undef POD_QUERY_CLASS
+		return Classes[static_cast<int32>(QueryClass)];
+	}
+
+	static EPodQueryClass FindClass(FName TraceTag)
+	{
+		for (int32 Index = 0; Index < NumClasses - 1; ++Index)
+		{
+			if (GetClassInfo(static_cast<EPodQueryClass>(Index)).Tag == TraceTag)
+			{
+				return static_cast<EPodQueryClass>(Index);
+			}
+		}
+		return EPodQueryClass::Other;
+	}
+
+	// This frame's totals for the budget and the CSV columns, reset at the end of every frame. Batched hover rays are
+	// recorded from worker threads
+	static std::atomic<uint64> GFrameCycles = 0;
+	static std::atomic<uint32> GFrameCount[NumClasses] = {};
+	static std::atomic<uint64> GFrameClassCycles[NumClasses] = {};
+
+	static void EndFrame()
+	{
+#if CSV_PROFILER
+		if (FCsvProfiler::Get()->IsCapturing())
+		{
+			for (int32 Index = 0; Index < NumClasses; ++Index)
+			{
+				const FClassInfo& Info = GetClassInfo(static_cast<EPodQueryClass>(Index));
+				FCsvProfiler::RecordCustomStat(Info.CsvCount, CSV_CATEGORY_INDEX(PodQueries), int32(GFrameCount[Index].load()), ECsvCustomStatOp::Set);
+				FCsvProfiler::RecordCustomStat(Info.CsvMs, CSV_CATEGORY_INDEX(PodQueries), float(FPlatformTime::ToMilliseconds64(GFrameClassCycles[Index].load())), ECsvCustomStatOp::Set);
+			}
+		}
+#endif
+
+		GFrameCycles = 0;
+		for (int32 Index = 0; Index < NumClasses; ++Index)
+		{
+			GFrameCount[Index] = 0;
+			GFrameClassCycles[Index] = 0;
+		}
+	}
+
+	static FDelayedAutoRegisterHelper GRegisterEndFrame(EDelayedRegisterRunPhase::EndOfEngineInit, []
+	{
+		FCoreDelegates::OnEndFrame.AddStatic(&EndFrame);
+	});
+
+	FName Tag(EPodQueryClass QueryClass)
+	{
+		return GetClassInfo(QueryClass).Tag;
+	}
+
+	void Record(const FCollisionQueryParams& Params, EPodQueryType Type, uint64 Cycles)
+	{
+		const int32 ClassIndex = static_cast<int32>(FindClass(Params.TraceTag));
+		GFrameCycles += Cycles;
+		++GFrameCount[ClassIndex];
+		GFrameClassCycles[ClassIndex] += Cycles;
+
+#if STATS
+		const uint32 Micros = uint32(FPlatformTime::ToMilliseconds64(Cycles) * 1000.0);
+		const FClassInfo& Info = GetClassInfo(static_cast<EPodQueryClass>(ClassIndex));
+		INC_DWORD_STAT_FNAME_BY(Info.CountStat, 1);
+		INC_DWORD_STAT_FNAME_BY(Info.MicrosStat, Micros);
+		INC_DWORD_STAT_BY(STAT_PodQueryMicros, Micros);
+		switch (Type)
+		{
+		case EPodQueryType::Line:		INC_DWORD_STAT(STAT_PodQueryLines); break;
+		case EPodQueryType::Sweep:		INC_DWORD_STAT(STAT_PodQuerySweeps); break;
+		case EPodQueryType::Complex:	INC_DWORD_STAT(STAT_PodQueryComplex); break;
+		default: break;
+		}
+#endif
+	}
+
+	uint32 GetFrameQueryCount(EPodQueryClass QueryClass)
+	{
+		return GFrameCount[static_cast<int32>(QueryClass)].load();
+	}
+
+	bool LineTraceSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End,
+		ECollisionChannel Channel, const FCollisionQueryParams& Params)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const bool bHit = World->LineTraceSingleByChannel(OutHit, Start, End, Channel, Params);
+		Record(Params, Params.bTraceComplex ? EPodQueryType::Complex : EPodQueryType::Line, FPlatformTime::Cycles64() - StartCycles);
+		return bHit;
+	}
+
+	bool SweepSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End,
+		const FQuat& Rotation, ECollisionChannel Channel, const FCollisionShape& Shape, const FCollisionQueryParams& Params)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const bool bHit = World->SweepSingleByChannel(OutHit, Start, End, Rotation, Channel, Shape, Params);
+		Record(Params, Params.bTraceComplex ? EPodQueryType::Complex : EPodQueryType::Sweep, FPlatformTime::Cycles64() - StartCycles);
+		return bHit;
+	}
+
+	FTraceHandle AsyncLineTraceByChannel(UWorld* World, const FVector& Start, const FVector& End,
+		ECollisionChannel Channel, const FCollisionQueryParams& Params)
+	{
+		Record(Params, Params.bTraceComplex ? EPodQueryType::Complex : EPodQueryType::Line, 0);
+		return World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, Channel, Params);
+	}
+
+	bool HasBudgetForCosmetic()
+	{
+		if (GBudgetMs <= 0.0f || FPlatformTime::ToMilliseconds64(GFrameCycles.load()) < GBudgetMs)
+		{
+			return true;
+		}
+
+		INC_DWORD_STAT(STAT_PodQueryCosmeticSkipped);
+		return false;
+	}
+}
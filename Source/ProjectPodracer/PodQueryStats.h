@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/HitResult.h"
+#include "WorldCollision.h"
+
+DECLARE_STATS_GROUP(TEXT("PodQueries"), STATGROUP_PodQueries, STATCAT_Advanced);
+
+// Pod classes whose scene queries are counted separately. A query is assigned by the TraceTag of its params
+enum class EPodQueryClass : uint8
+{
+	PodVehicle,					// UPodVehicleMovementComponent
+	PodMovement,				// UPodMovementComponent
+	PodracerMovement,			// UPodracerMovementComponent
+	EngineController,			// AEngineControllerPodRacer
+	HoverJetEngine,				// UHoverJetEngineComp
+	HoverRacer,					// AHoverRacer
+	HoverRacerPawn,				// AHoverRacerPawn
+	RayCastVehicle,				// URayCastVehicleMovementComponent
+	SimulatedRayCastVehicle,	// ASimulatedRayCastVehicle
+	Other,						// Any other TraceTag
+	Num
+};
+
+enum class EPodQueryType : uint8
+{
+	Line,
+	Sweep,
+	// Line or sweep against complex collision
+	Complex,
+	Num
+};
+
+/**
+ * Accounting for the scene queries pod movement issues: count, type and time per pod class, shown by `stat PodQueries`
+ * and written as PodQueries columns of CSV profiles. Movement code tags its query params with Tag() and goes through
+ * the wrappers below (PodGroundProbe already does). Pod.Queries.BudgetMs optionally caps a frame's query time, past it
+ * cosmetic queries are skipped.
+ */
+namespace PodQueryStats
+{
+	// TraceTag for a class's query params, e.g. FCollisionQueryParams(PodQueryStats::Tag(EPodQueryClass::HoverRacer), false, this)
+	PROJECTPODRACER_API FName Tag(EPodQueryClass QueryClass);
+
+	// Accounts one finished scene query. Safe from any thread
+	PROJECTPODRACER_API void Record(const FCollisionQueryParams& Params, EPodQueryType Type, uint64 Cycles);
+
+	// Queries accounted to QueryClass so far this frame
+	PROJECTPODRACER_API uint32 GetFrameQueryCount(EPodQueryClass QueryClass);
+
+	PROJECTPODRACER_API bool LineTraceSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End,
+		ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	PROJECTPODRACER_API bool SweepSingleByChannel(const UWorld* World, FHitResult& OutHit, const FVector& Start, const FVector& End,
+		const FQuat& Rotation, ECollisionChannel Channel, const FCollisionShape& Shape, const FCollisionQueryParams& Params);
+
+	// Counted when issued. The trace itself runs on the async trace task, so no time is charged to the class
+	PROJECTPODRACER_API FTraceHandle AsyncLineTraceByChannel(UWorld* World, const FVector& Start, const FVector& End,
+		ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	// False once this frame's pod queries have used up Pod.Queries.BudgetMs. Cosmetic queries check it first and keep
+	// their previous result when it fails
+	PROJECTPODRACER_API bool HasBudgetForCosmetic();
+}
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodQueryStats.h"
+#include "PodTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodQueryStatsCountTest, "ProjectPodracer.QueryStats.CountsByClass",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Wrapped queries are charged to the class their TraceTag names and hit what the plain world query hits. Reports what
+// the accounting adds to a trace
+bool FPodQueryStatsCountTest::RunTest(const FString& Parameters)
+{
+	FPodTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+	TestWorld.AddStaticBox(FVector(0.f, 0.f, -50.f), FVector(5000.f, 5000.f, 50.f));
+
+	for (int32 Index = 0; Index < static_cast<int32>(EPodQueryClass::Num) - 1; ++Index)
+	{
+		const EPodQueryClass QueryClass = static_cast<EPodQueryClass>(Index);
+		TestTrue(FString::Printf(TEXT("Class %d has its own tag"), Index), PodQueryStats::Tag(QueryClass) != PodQueryStats::Tag(EPodQueryClass::Other));
+	}
+
+	const FVector Start(0.f, 0.f, 300.f);
+	const FVector End(0.f, 0.f, -300.f);
+	auto GetCount = [](EPodQueryClass QueryClass) { return int32(PodQueryStats::GetFrameQueryCount(QueryClass)); };
+	const int32 HoverRacerBefore = GetCount(EPodQueryClass::HoverRacer);
+	const int32 PodVehicleBefore = GetCount(EPodQueryClass::PodVehicle);
+	const int32 OtherBefore = GetCount(EPodQueryClass::Other);
+
+	FHitResult Hit;
+	const FCollisionQueryParams HoverRacerParams(PodQueryStats::Tag(EPodQueryClass::HoverRacer), false);
+	TestTrue(TEXT("Wrapped line trace hits"), PodQueryStats::LineTraceSingleByChannel(World, Hit, Start, End, ECC_WorldStatic, HoverRacerParams));
+	TestNearlyEqual(TEXT("Wrapped line trace lands on the floor"), float(Hit.ImpactPoint.Z), 0.f, 0.1f);
+
+	const FCollisionQueryParams PodVehicleParams(PodQueryStats::Tag(EPodQueryClass::PodVehicle), false);
+	TestTrue(TEXT("Wrapped sweep hits"), PodQueryStats::SweepSingleByChannel(World, Hit, Start, End, FQuat::Identity, ECC_WorldStatic,
+		FCollisionShape::MakeSphere(20.f), PodVehicleParams));
+	TestTrue(TEXT("Wrapped complex line trace hits"), PodQueryStats::LineTraceSingleByChannel(World, Hit, Start, End, ECC_WorldStatic,
+		FCollisionQueryParams(SCENE_QUERY_STAT(PodQueryStatsTest), true)));
+
+	TestEqual(TEXT("HoverRacer queries"), GetCount(EPodQueryClass::HoverRacer) - HoverRacerBefore, 1);
+	TestEqual(TEXT("PodVehicle queries"), GetCount(EPodQueryClass::PodVehicle) - PodVehicleBefore, 1);
+	TestEqual(TEXT("Untagged queries"), GetCount(EPodQueryClass::Other) - OtherBefore, 1);
+
+	constexpr int32 Iterations = 1000;
+	double PlainSeconds = 0.0;
+	double WrappedSeconds = 0.0;
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		double IterationStart = FPlatformTime::Seconds();
+		World->LineTraceSingleByChannel(Hit, Start, End, ECC_WorldStatic, HoverRacerParams);
+		PlainSeconds += FPlatformTime::Seconds() - IterationStart;
+		IterationStart = FPlatformTime::Seconds();
+		PodQueryStats::LineTraceSingleByChannel(World, Hit, Start, End, ECC_WorldStatic, HoverRacerParams);
+		WrappedSeconds += FPlatformTime::Seconds() - IterationStart;
+	}
+	AddInfo(FString::Printf(TEXT("Line trace: plain %.3f us, wrapped %.3f us"), PlainSeconds * 1.0e6 / Iterations, WrappedSeconds * 1.0e6 / Iterations));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodQueryStatsBudgetTest, "ProjectPodracer.QueryStats.CosmeticBudget",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Cosmetic queries always run without a budget, and stop for the rest of the frame once queries have used it up
+bool FPodQueryStatsBudgetTest::RunTest(const FString& Parameters)
+{
+	{
+		FPodScopedConsoleVariable NoBudget(TEXT("Pod.Queries.BudgetMs"), 0.f);
+		TestTrue(TEXT("No budget always has room"), PodQueryStats::HasBudgetForCosmetic());
+	}
+
+	// Far more than the frame has spent so far, then charge it all at once
+	constexpr float BudgetMs = 1000.f;
+	FPodScopedConsoleVariable Budget(TEXT("Pod.Queries.BudgetMs"), BudgetMs);
+	TestTrue(TEXT("Room before the budget is spent"), PodQueryStats::HasBudgetForCosmetic());
+
+	const uint64 BudgetCycles = uint64(BudgetMs * 0.001 / FPlatformTime::GetSecondsPerCycle64());
+	PodQueryStats::Record(FCollisionQueryParams(SCENE_QUERY_STAT(PodQueryStatsTest), false), EPodQueryType::Line, BudgetCycles);
+	TestFalse(TEXT("No room once the budget is spent"), PodQueryStats::HasBudgetForCosmetic());
+	return true;
+}
+
+#endif
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "ProceduralMeshComponent.h"
+#include "ProceduralTrackGenerator.h"
+
+/**
+ * An empty game world for automation tests, playing from construction and destroyed with this. Actors spawned in it
+ * begin play, and scene queries see whatever has been registered
+ */
+struct FPodTestWorld
+{
+	UWorld* World = nullptr;
+
+	FPodTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	~FPodTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	FPodTestWorld(const FPodTestWorld&) = delete;
+	FPodTestWorld& operator=(const FPodTestWorld&) = delete;
+
+	// A static BlockAll box (WorldStatic), like level geometry
+	UBoxComponent* AddStaticBox(const FVector& Center, const FVector& Extent, const FRotator& Rotation = FRotator::ZeroRotator) const
+	{
+		AActor* Actor = World->SpawnActor<AActor>(Center, Rotation);
+		UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+		Box->SetMobility(EComponentMobility::Static);
+		Box->SetBoxExtent(Extent, false);
+		Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		Actor->SetRootComponent(Box);
+		Box->SetWorldLocationAndRotation(Center, Rotation);
+		Box->RegisterComponent();
+		return Box;
+	}
+
+	// A generated track's actor at the origin, not generated yet. Collision is cooked as soon as it is built, so
+	// queries can run straight after generating
+	AProceduralTrackGenerator* SpawnTrack(int32 NumberOfControlPoints = 10) const
+	{
+		AProceduralTrackGenerator* Track = World->SpawnActor<AProceduralTrackGenerator>();
+		if (Track)
+		{
+			Track->NumberOfControlPoints = NumberOfControlPoints;
+			Track->TrackMesh->bUseAsyncCooking = false;
+			Track->GroundProxyMesh->bUseAsyncCooking = false;
+		}
+		return Track;
+	}
+};
+
+// Sets a console variable for the rest of the scope, e.g. to take Pod.Track.Cache out of a test
+struct FPodScopedConsoleVariable
+{
+	// Value is anything IConsoleVariable::Set takes: int32, float or a string
+	template <typename ValueType>
+	FPodScopedConsoleVariable(const TCHAR* Name, ValueType Value)
+		: Variable(IConsoleManager::Get().FindConsoleVariable(Name))
+	{
+		if (Variable)
+		{
+			SavedValue = Variable->GetString();
+			Variable->Set(Value, ECVF_SetByCode);
+		}
+	}
+
+	~FPodScopedConsoleVariable()
+	{
+		if (Variable)
+		{
+			Variable->Set(*SavedValue, ECVF_SetByCode);
+		}
+	}
+
+	FPodScopedConsoleVariable(const FPodScopedConsoleVariable&) = delete;
+	FPodScopedConsoleVariable& operator=(const FPodScopedConsoleVariable&) = delete;
+
+	IConsoleVariable* Variable = nullptr;
+	FString SavedValue;
+};
+
+#endif
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Pawn.h"
+
+// Debug instrumentation inside the role ticks is a template parameter, shipping builds never instantiate the debug variants
+#ifndef POD_TICK_DEBUG
+#define POD_TICK_DEBUG (!UE_BUILD_SHIPPING)
+#endif
+
+// Which tick path a pod movement component runs. Resolved when the pawn's controller or net role changes instead of every frame
+enum class EPodTickRole : uint8
+{
+	// Server pawn controlled on this machine (listen host player or server AI)
+	LocalAuthority,
+	// Server pawn driven by a remote client
+	Authority,
+	// Owning client predicting its own pawn
+	AutonomousProxy,
+	// Someone else's pawn on a client
+	SimulatedProxy,
+};
+
+namespace PodTickRole
+{
+	inline EPodTickRole Resolve(const APawn* Pawn)
+	{
+		const bool bLocal = Pawn->IsLocallyControlled();
+		if (Pawn->HasAuthority())
+		{
+			return bLocal ? EPodTickRole::LocalAuthority : EPodTickRole::Authority;
+		}
+		return bLocal ? EPodTickRole::AutonomousProxy : EPodTickRole::SimulatedProxy;
+	}
+}
+
+/**
+ * Picks ComponentType::TickRole<Role, bDebug> for a runtime role and debug flag. The component declares
+ * FRoleTickFunction and the TickRole template, and befriends this selector.
+ */
+template<typename ComponentType>
+struct TPodRoleTickSelector
+{
+	using FFunction = typename ComponentType::FRoleTickFunction;
+
+	static FFunction Select(EPodTickRole Role, bool bDebug)
+	{
+		switch (Role)
+		{
+		case EPodTickRole::LocalAuthority:	return SelectForRole<EPodTickRole::LocalAuthority>(bDebug);
+		case EPodTickRole::Authority:		return SelectForRole<EPodTickRole::Authority>(bDebug);
+		case EPodTickRole::AutonomousProxy:	return SelectForRole<EPodTickRole::AutonomousProxy>(bDebug);
+		case EPodTickRole::SimulatedProxy:	return SelectForRole<EPodTickRole::SimulatedProxy>(bDebug);
+		}
+		return nullptr;
+	}
+
+private:
+	template<EPodTickRole Role>
+	static FFunction SelectForRole(bool bDebug)
+	{
+#if POD_TICK_DEBUG
+		if (bDebug)
+		{
+			return &ComponentType::template TickRole<Role, true>;
+		}
+#endif
+		return &ComponentType::template TickRole<Role, false>;
+	}
+};
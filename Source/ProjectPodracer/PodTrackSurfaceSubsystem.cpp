@@ -0,0 +1,553 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodTrackSurfaceSubsystem.h"
+
+#include "ProceduralTrackGenerator.h"
+#include "ProceduralMeshComponent.h"
+#include "Components/SplineComponent.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+	// Keeps the grid bounded on very long circuits, cells grow instead
+	constexpr int32 MaxCellsPerAxis = 256;
+	constexpr float MinCellSize = 100.f;
+
+	// Segments are tens of metres long, a pod crosses at most one per frame
+	constexpr int32 MaxWalkSteps = 4;
+
+	// Moller-Trumbore against the unnormalized ray, OutTime is in [0, 1] along Start-End
+	bool IntersectTriangle(const FVector& Start, const FVector& Ray, const FVector& A, const FVector& B, const FVector& C, double& OutTime)
+	{
+		const FVector EdgeAB = B - A;
+		const FVector EdgeAC = C - A;
+		const FVector P = FVector::CrossProduct(Ray, EdgeAC);
+		const double Det = FVector::DotProduct(EdgeAB, P);
+		if (FMath::Abs(Det) < UE_KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const double InvDet = 1.0 / Det;
+		const FVector ToStart = Start - A;
+		const double U = FVector::DotProduct(ToStart, P) * InvDet;
+		if (U < 0.0 || U > 1.0)
+		{
+			return false;
+		}
+
+		const FVector Q = FVector::CrossProduct(ToStart, EdgeAB);
+		const double V = FVector::DotProduct(Ray, Q) * InvDet;
+		if (V < 0.0 || U + V > 1.0)
+		{
+			return false;
+		}
+
+		OutTime = FVector::DotProduct(EdgeAC, Q) * InvDet;
+		return OutTime >= 0.0 && OutTime <= 1.0;
+	}
+}
+
+void FPodTrackSurface::Build(AProceduralTrackGenerator& InTrack)
+{
+	Track = &InTrack;
+	SurfaceChunks.Reset(InTrack.TrackChunks.Num());
+	for (UProceduralMeshComponent* Chunk : InTrack.TrackChunks)
+	{
+		SurfaceChunks.Add(Chunk);
+	}
+	ChunkFirstSegments = InTrack.TrackChunkFirstRows;
+	SurfaceComponent = SurfaceChunks.Num() > 0 ? SurfaceChunks[0] : nullptr;
+	ProxyComponent = InTrack.GroundProxyMesh;
+	ShoulderWidth = InTrack.ShoulderWidth;
+	bClosedLoop = InTrack.TrackSpline && InTrack.TrackSpline->IsClosedLoop();
+	InTrack.GetSurfaceSamples(Distances, LeftEdges, RightEdges);
+
+	Bounds = FBox(ForceInit);
+	CellStart.Reset();
+	CellSegments.Reset();
+	CellsX = CellsY = 0;
+
+	const int32 SegmentCount = NumSegments();
+	if (SegmentCount == 0)
+	{
+		return;
+	}
+
+	for (int32 Row = 0; Row < Distances.Num(); ++Row)
+	{
+		Bounds += LeftEdges[Row];
+		Bounds += RightEdges[Row];
+	}
+
+	// Cells about one road width across keep the per-cell lists to a handful of segments
+	const FVector Size = Bounds.GetSize();
+	const float RoadWidth = FVector::Dist(LeftEdges[0], RightEdges[0]);
+	CellSize = FMath::Max3(RoadWidth, float(Size.X) / MaxCellsPerAxis, float(Size.Y) / MaxCellsPerAxis);
+	CellSize = FMath::Max(CellSize, MinCellSize);
+	CellsX = FMath::Max(1, FMath::CeilToInt(Size.X / CellSize));
+	CellsY = FMath::Max(1, FMath::CeilToInt(Size.Y / CellSize));
+
+	auto SegmentBounds = [this](int32 Segment)
+	{
+		FBox Box(ForceInit);
+		Box += LeftEdges[Segment];
+		Box += RightEdges[Segment];
+		Box += LeftEdges[Segment + 1];
+		Box += RightEdges[Segment + 1];
+		return Box;
+	};
+	auto CellRange = [this](const FBox& Box, int32& MinX, int32& MinY, int32& MaxX, int32& MaxY)
+	{
+		MinX = FMath::Clamp(FMath::FloorToInt((Box.Min.X - Bounds.Min.X) / CellSize), 0, CellsX - 1);
+		MinY = FMath::Clamp(FMath::FloorToInt((Box.Min.Y - Bounds.Min.Y) / CellSize), 0, CellsY - 1);
+		MaxX = FMath::Clamp(FMath::FloorToInt((Box.Max.X - Bounds.Min.X) / CellSize), 0, CellsX - 1);
+		MaxY = FMath::Clamp(FMath::FloorToInt((Box.Max.Y - Bounds.Min.Y) / CellSize), 0, CellsY - 1);
+	};
+
+	// Count per cell, prefix sum, then fill
+	const int32 NumCells = CellsX * CellsY;
+	CellStart.SetNumZeroed(NumCells + 1);
+	for (int32 Segment = 0; Segment < SegmentCount; ++Segment)
+	{
+		int32 MinX, MinY, MaxX, MaxY;
+		CellRange(SegmentBounds(Segment), MinX, MinY, MaxX, MaxY);
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				++CellStart[Y * CellsX + X + 1];
+			}
+		}
+	}
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		CellStart[Cell + 1] += CellStart[Cell];
+	}
+
+	CellSegments.SetNumUninitialized(CellStart[NumCells]);
+	TArray<int32> Cursor(CellStart.GetData(), NumCells);
+	for (int32 Segment = 0; Segment < SegmentCount; ++Segment)
+	{
+		int32 MinX, MinY, MaxX, MaxY;
+		CellRange(SegmentBounds(Segment), MinX, MinY, MaxX, MaxY);
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				CellSegments[Cursor[Y * CellsX + X]++] = Segment;
+			}
+		}
+	}
+}
+
+template<typename VisitorType>
+void FPodTrackSurface::ForEachCandidateSegment(const FBox& QueryBounds, VisitorType&& Visitor) const
+{
+	if (CellsX == 0 || !QueryBounds.Intersect(Bounds))
+	{
+		return;
+	}
+
+	const int32 MinX = FMath::Clamp(FMath::FloorToInt((QueryBounds.Min.X - Bounds.Min.X) / CellSize), 0, CellsX - 1);
+	const int32 MinY = FMath::Clamp(FMath::FloorToInt((QueryBounds.Min.Y - Bounds.Min.Y) / CellSize), 0, CellsY - 1);
+	const int32 MaxX = FMath::Clamp(FMath::FloorToInt((QueryBounds.Max.X - Bounds.Min.X) / CellSize), 0, CellsX - 1);
+	const int32 MaxY = FMath::Clamp(FMath::FloorToInt((QueryBounds.Max.Y - Bounds.Min.Y) / CellSize), 0, CellsY - 1);
+
+	// Hover rays are short and mostly vertical, so this is usually a single cell
+	TArray<int32, TInlineAllocator<32>> Candidates;
+	for (int32 Y = MinY; Y <= MaxY; ++Y)
+	{
+		for (int32 X = MinX; X <= MaxX; ++X)
+		{
+			const int32 Cell = Y * CellsX + X;
+			for (int32 Index = CellStart[Cell]; Index < CellStart[Cell + 1]; ++Index)
+			{
+				Candidates.AddUnique(CellSegments[Index]);
+			}
+		}
+	}
+
+	for (const int32 Segment : Candidates)
+	{
+		Visitor(Segment);
+	}
+}
+
+UPrimitiveComponent* FPodTrackSurface::GetBlockingComponent(ECollisionChannel Channel) const
+{
+	for (UPrimitiveComponent* Component : { SurfaceComponent.Get(), ProxyComponent.Get() })
+	{
+		if (Component && Component->IsQueryCollisionEnabled() && Component->GetCollisionResponseToChannel(Channel) == ECR_Block)
+		{
+			return Component;
+		}
+	}
+	return nullptr;
+}
+
+UPrimitiveComponent* FPodTrackSurface::GetSurfaceChunk(int32 Segment, int32& OutFirstSegment) const
+{
+	const int32 Chunk = Algo::UpperBound(ChunkFirstSegments, Segment) - 1;
+	if (!SurfaceChunks.IsValidIndex(Chunk) || !ChunkFirstSegments.IsValidIndex(Chunk))
+	{
+		OutFirstSegment = 0;
+		return SurfaceComponent.Get();
+	}
+	OutFirstSegment = ChunkFirstSegments[Chunk];
+	return SurfaceChunks[Chunk].Get();
+}
+
+bool FPodTrackSurface::Raycast(const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	const FVector Ray = End - Start;
+	double BestTime = TNumericLimits<double>::Max();
+	int32 BestFace = INDEX_NONE;
+	FVector BestNormal = FVector::UpVector;
+
+	FBox QueryBounds(ForceInit);
+	QueryBounds += Start;
+	QueryBounds += End;
+	ForEachCandidateSegment(QueryBounds, [&](int32 Segment)
+	{
+		// Same winding as the generated mesh: (L0, L1, R0) then (R0, L1, R1)
+		const FVector& L0 = LeftEdges[Segment];
+		const FVector& R0 = RightEdges[Segment];
+		const FVector& L1 = LeftEdges[Segment + 1];
+		const FVector& R1 = RightEdges[Segment + 1];
+
+		double Time;
+		if (IntersectTriangle(Start, Ray, L0, L1, R0, Time) && Time < BestTime)
+		{
+			BestTime = Time;
+			BestFace = Segment * 2;
+			BestNormal = FVector::CrossProduct(L1 - L0, R0 - L0);
+		}
+		if (IntersectTriangle(Start, Ray, R0, L1, R1, Time) && Time < BestTime)
+		{
+			BestTime = Time;
+			BestFace = Segment * 2 + 1;
+			BestNormal = FVector::CrossProduct(L1 - R0, R1 - R0);
+		}
+	});
+
+	if (BestFace == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Query collision on the mesh is two sided, face the normal back along the ray like the scene trace does
+	BestNormal = BestNormal.GetSafeNormal();
+	if (FVector::DotProduct(BestNormal, Ray) > 0.0)
+	{
+		BestNormal = -BestNormal;
+	}
+
+	OutHit = FHitResult(Start, End);
+	OutHit.bBlockingHit = true;
+	OutHit.Time = BestTime;
+	OutHit.Distance = BestTime * Ray.Size();
+	OutHit.Location = Start + Ray * BestTime;
+	OutHit.ImpactPoint = OutHit.Location;
+	OutHit.Normal = BestNormal;
+	OutHit.ImpactNormal = BestNormal;
+	// Face indices count from the start of the chunk, like a trace against its mesh section
+	int32 FirstSegment;
+	OutHit.Component = GetSurfaceChunk(BestFace / 2, FirstSegment);
+	OutHit.FaceIndex = BestFace - FirstSegment * 2;
+	OutHit.HitObjectHandle = FActorInstanceHandle(Track.Get());
+	return true;
+}
+
+bool FPodTrackSurface::Project(const FVector& Position, FPodTrackSurfacePoint& OutPoint) const
+{
+	// Pad by a cell so positions above banked road still find the segment under them
+	const FBox QueryBounds(FVector(Position.X - CellSize, Position.Y - CellSize, Bounds.Min.Z),
+		FVector(Position.X + CellSize, Position.Y + CellSize, Bounds.Max.Z));
+
+	bool bFound = false;
+	double BestHeight = TNumericLimits<double>::Max();
+	ForEachCandidateSegment(QueryBounds, [&](int32 Segment)
+	{
+		double Alpha, HalfWidth;
+		FPodTrackSurfacePoint Point;
+		if (!ProjectOnSegment(Position, Segment, Alpha, HalfWidth, Point)
+			|| Alpha < 0.0 || Alpha > 1.0 || FMath::Abs(Point.LateralOffset) > HalfWidth || FMath::Abs(Point.Height) >= FMath::Abs(BestHeight))
+		{
+			return;
+		}
+
+		bFound = true;
+		BestHeight = Point.Height;
+		OutPoint = Point;
+	});
+
+	return bFound;
+}
+
+bool FPodTrackSurface::ProjectOnSegment(const FVector& Position, int32 Segment, double& OutAlpha, double& OutHalfWidth, FPodTrackSurfacePoint& OutPoint) const
+{
+	const FVector Center0 = (LeftEdges[Segment] + RightEdges[Segment]) * 0.5;
+	const FVector Center1 = (LeftEdges[Segment + 1] + RightEdges[Segment + 1]) * 0.5;
+	const FVector Axis = Center1 - Center0;
+	const double AxisSizeSquared = Axis.SizeSquared();
+	if (AxisSizeSquared < UE_KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	OutAlpha = FVector::DotProduct(Position - Center0, Axis) / AxisSizeSquared;
+	const double Alpha = FMath::Clamp(OutAlpha, 0.0, 1.0);
+
+	const FVector Center = FMath::Lerp(Center0, Center1, Alpha);
+	const FVector Across = FMath::Lerp(RightEdges[Segment] - LeftEdges[Segment], RightEdges[Segment + 1] - LeftEdges[Segment + 1], Alpha);
+	OutHalfWidth = Across.Size() * 0.5;
+	if (OutHalfWidth < UE_KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	const FVector Right = Across / (OutHalfWidth * 2.0);
+	const FVector Offset = Position - Center;
+	const double Lateral = FVector::DotProduct(Offset, Right);
+
+	// Right x Direction is the spline up vector the mesh builder used
+	const FVector Normal = FVector::CrossProduct(Right, Axis).GetSafeNormal();
+
+	OutPoint.Distance = FMath::Lerp(Distances[Segment], Distances[Segment + 1], float(Alpha));
+	OutPoint.LateralOffset = Lateral;
+	OutPoint.Height = FVector::DotProduct(Offset, Normal);
+	OutPoint.SurfacePoint = Center + Right * Lateral;
+	OutPoint.Normal = Normal;
+	return true;
+}
+
+int32 FPodTrackSurface::FindNearestSegment(const FVector& Position) const
+{
+	// A cell is about a road width, so one more plus the shoulder reaches anything that still counts as on the track
+	const double Reach = CellSize + ShoulderWidth;
+	const FBox QueryBounds(FVector(Position.X - Reach, Position.Y - Reach, Bounds.Min.Z),
+		FVector(Position.X + Reach, Position.Y + Reach, Bounds.Max.Z));
+
+	int32 BestSegment = INDEX_NONE;
+	double BestDistanceSquared = TNumericLimits<double>::Max();
+	ForEachCandidateSegment(QueryBounds, [&](int32 Segment)
+	{
+		double Alpha, HalfWidth;
+		FPodTrackSurfacePoint Point;
+		if (!ProjectOnSegment(Position, Segment, Alpha, HalfWidth, Point))
+		{
+			return;
+		}
+
+		// Distance to the road ribbon, so the deck a pod is on wins over the one it is above. The last term is how far
+		// past the segment's ends Position lies
+		const double Outside = FMath::Max(FMath::Abs(Point.LateralOffset) - HalfWidth, 0.0);
+		const double Beyond = FVector::DistSquared(Position, Point.SurfacePoint + Point.Normal * Point.Height);
+		const double DistanceSquared = FMath::Square(Outside) + FMath::Square(Point.Height) + Beyond;
+		if (DistanceSquared < BestDistanceSquared)
+		{
+			BestDistanceSquared = DistanceSquared;
+			BestSegment = Segment;
+		}
+	});
+	return BestSegment;
+}
+
+int32 FPodTrackSurface::WalkToSegment(const FVector& Position, int32 Segment) const
+{
+	if (!Distances.IsValidIndex(Segment + 1))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 LastSegment = NumSegments() - 1;
+	for (int32 Step = 0; Step <= MaxWalkSteps; ++Step)
+	{
+		double Alpha, HalfWidth;
+		FPodTrackSurfacePoint Point;
+		if (!ProjectOnSegment(Position, Segment, Alpha, HalfWidth, Point))
+		{
+			return INDEX_NONE;
+		}
+
+		if (Alpha >= 0.0 && Alpha <= 1.0)
+		{
+			return Segment;
+		}
+
+		// Crossing the start/finish line of a circuit, or off an open track's end where the nearest search decides
+		if (Alpha < 0.0)
+		{
+			if (Segment == 0 && !bClosedLoop)
+			{
+				return INDEX_NONE;
+			}
+			Segment = Segment > 0 ? Segment - 1 : LastSegment;
+		}
+		else
+		{
+			if (Segment == LastSegment && !bClosedLoop)
+			{
+				return INDEX_NONE;
+			}
+			Segment = Segment < LastSegment ? Segment + 1 : 0;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FPodTrackSurface::MakeCoordinate(const FVector& Position, int32 Segment, FPodTrackCoordinate& OutCoordinate) const
+{
+	double Alpha, HalfWidth;
+	FPodTrackSurfacePoint Point;
+	OutCoordinate.Track = Track;
+	OutCoordinate.Segment = Segment;
+	if (!ProjectOnSegment(Position, Segment, Alpha, HalfWidth, Point))
+	{
+		OutCoordinate.Zone = EPodTrackZone::OffTrack;
+		return;
+	}
+
+	OutCoordinate.Distance = Point.Distance;
+	OutCoordinate.LateralOffset = Point.LateralOffset;
+	OutCoordinate.Height = Point.Height;
+	OutCoordinate.HalfWidth = HalfWidth;
+
+	const bool bPastEnd = !bClosedLoop && ((Alpha < 0.0 && Segment == 0) || (Alpha > 1.0 && Segment == NumSegments() - 1));
+	const double Lateral = FMath::Abs(Point.LateralOffset);
+	OutCoordinate.Zone = bPastEnd ? EPodTrackZone::OffTrack
+		: Lateral <= HalfWidth ? EPodTrackZone::Road
+		: Lateral <= HalfWidth + ShoulderWidth ? EPodTrackZone::Shoulder
+		: EPodTrackZone::OffTrack;
+}
+
+UPodTrackSurfaceSubsystem* UPodTrackSurfaceSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UPodTrackSurfaceSubsystem>() : nullptr;
+}
+
+bool UPodTrackSurfaceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPodTrackSurfaceSubsystem::RegisterTrack(AProceduralTrackGenerator* Track)
+{
+	if (!Track)
+	{
+		return;
+	}
+
+	Surfaces.RemoveAllSwap([](const FPodTrackSurface& Surface) { return !Surface.Track.IsValid(); });
+
+	FPodTrackSurface* Surface = Surfaces.FindByPredicate([Track](const FPodTrackSurface& Existing) { return Existing.Track.Get() == Track; });
+	if (!Surface)
+	{
+		Surface = &Surfaces.AddDefaulted_GetRef();
+	}
+	Surface->Build(*Track);
+
+	UE_LOG(LogTemp, Log, TEXT("PodTrackSurface: %s registered with %d segments in a %dx%d grid"),
+		*Track->GetName(), Surface->NumSegments(), Surface->CellsX, Surface->CellsY);
+}
+
+void UPodTrackSurfaceSubsystem::UnregisterTrack(AProceduralTrackGenerator* Track)
+{
+	Surfaces.RemoveAllSwap([Track](const FPodTrackSurface& Surface) { return !Surface.Track.IsValid() || Surface.Track.Get() == Track; });
+}
+
+bool UPodTrackSurfaceSubsystem::LineTrace(const FVector& Start, const FVector& End, ECollisionChannel Channel, FHitResult& OutHit) const
+{
+	bool bHit = false;
+	FHitResult SurfaceHit;
+	for (const FPodTrackSurface& Surface : Surfaces)
+	{
+		UPrimitiveComponent* Component = Surface.GetBlockingComponent(Channel);
+		if (!Component)
+		{
+			continue;
+		}
+
+		if (Surface.Raycast(Start, End, SurfaceHit) && (!bHit || SurfaceHit.Time < OutHit.Time))
+		{
+			OutHit = SurfaceHit;
+			if (Component == Surface.ProxyComponent.Get())
+			{
+				OutHit.Component = Component;
+			}
+			bHit = true;
+		}
+	}
+	return bHit;
+}
+
+bool UPodTrackSurfaceSubsystem::GetTrackCoordinate(const FVector& Position, FPodTrackCoordinate& OutCoordinate) const
+{
+	OutCoordinate = FPodTrackCoordinate();
+
+	bool bFound = false;
+	double BestDistanceSquared = TNumericLimits<double>::Max();
+	FPodTrackCoordinate Candidate;
+	for (const FPodTrackSurface& Surface : Surfaces)
+	{
+		const int32 Segment = Surface.FindNearestSegment(Position);
+		if (Segment == INDEX_NONE)
+		{
+			continue;
+		}
+
+		Surface.MakeCoordinate(Position, Segment, Candidate);
+		const double Outside = FMath::Max(FMath::Abs(Candidate.LateralOffset) - Candidate.HalfWidth, 0.f);
+		const double DistanceSquared = FMath::Square(Outside) + FMath::Square(Candidate.Height);
+		if (DistanceSquared < BestDistanceSquared)
+		{
+			BestDistanceSquared = DistanceSquared;
+			OutCoordinate = Candidate;
+			bFound = true;
+		}
+	}
+	return bFound;
+}
+
+bool UPodTrackSurfaceSubsystem::UpdateTrackCoordinate(const FVector& Position, FPodTrackCoordinate& Coordinate) const
+{
+	const AProceduralTrackGenerator* LastTrack = Coordinate.Track.Get();
+	const FPodTrackSurface* Surface = LastTrack
+		? Surfaces.FindByPredicate([LastTrack](const FPodTrackSurface& Existing) { return Existing.Track.Get() == LastTrack; })
+		: nullptr;
+
+	const int32 Segment = Surface ? Surface->WalkToSegment(Position, Coordinate.Segment) : INDEX_NONE;
+	if (Segment == INDEX_NONE)
+	{
+		return GetTrackCoordinate(Position, Coordinate);
+	}
+
+	Surface->MakeCoordinate(Position, Segment, Coordinate);
+	if (Coordinate.Zone == EPodTrackZone::OffTrack)
+	{
+		// Off this stretch of road, another part of the circuit may be under the pod instead
+		FPodTrackCoordinate Nearest;
+		if (GetTrackCoordinate(Position, Nearest) && Nearest.Zone != EPodTrackZone::OffTrack)
+		{
+			Coordinate = Nearest;
+		}
+	}
+	return true;
+}
+
+bool UPodTrackSurfaceSubsystem::ProjectToSurface(const FVector& Position, FPodTrackSurfacePoint& OutPoint) const
+{
+	bool bFound = false;
+	FPodTrackSurfacePoint Point;
+	for (const FPodTrackSurface& Surface : Surfaces)
+	{
+		if (Surface.Project(Position, Point) && (!bFound || FMath::Abs(Point.Height) < FMath::Abs(OutPoint.Height)))
+		{
+			OutPoint = Point;
+			bFound = true;
+		}
+	}
+	return bFound;
+}
@@ -0,0 +1,182 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PodTrackSurfaceSubsystem.generated.h"
+
+class AProceduralTrackGenerator;
+class UPrimitiveComponent;
+
+// Where a world position sits relative to a generated track's road surface
+struct FPodTrackSurfacePoint
+{
+	// Distance along the track spline
+	float Distance = 0.f;
+	// Signed offset from the centre line towards the right edge
+	float LateralOffset = 0.f;
+	// Height above the road along Normal (negative below it)
+	float Height = 0.f;
+	FVector SurfacePoint = FVector::ZeroVector;
+	FVector Normal = FVector::UpVector;
+};
+
+UENUM(BlueprintType)
+enum class EPodTrackZone : uint8
+{
+	Road,
+	// Within the track's ShoulderWidth of a road edge
+	Shoulder,
+	OffTrack
+};
+
+// Track-space position of a pod, kept between frames so the next update starts from the same segment
+USTRUCT(BlueprintType)
+struct PROJECTPODRACER_API FPodTrackCoordinate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Track")
+	TWeakObjectPtr<AProceduralTrackGenerator> Track;
+
+	// Distance along the track spline
+	UPROPERTY(BlueprintReadOnly, Category = "Track")
+	float Distance = 0.f;
+
+	// Signed offset from the centre line towards the right edge
+	UPROPERTY(BlueprintReadOnly, Category = "Track")
+	float LateralOffset = 0.f;
+
+	// Height above the road plane (negative below it)
+	UPROPERTY(BlueprintReadOnly, Category = "Track")
+	float Height = 0.f;
+
+	// Half the road width at Distance
+	UPROPERTY(BlueprintReadOnly, Category = "Track")
+	float HalfWidth = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Track")
+	EPodTrackZone Zone = EPodTrackZone::OffTrack;
+
+	// Segment of the arc-length table the position was found on
+	UPROPERTY()
+	int32 Segment = INDEX_NONE;
+};
+
+/**
+ * Road surface of one AProceduralTrackGenerator track. Rows of the arc-length table are the samples the mesh builder
+ * turned into LOD 0 vertices, so segment i between rows i and i+1 is exactly triangles 2(i - f) and 2(i - f) + 1 of the
+ * mesh chunk starting at row f (LOD 0 is the only section with collision).
+ * A uniform XY grid lists the segments overlapping each cell, so a query only looks at the few segments under it.
+ */
+struct FPodTrackSurface
+{
+	TWeakObjectPtr<AProceduralTrackGenerator> Track;
+	// First road chunk, whose collision responses every chunk shares
+	TWeakObjectPtr<UPrimitiveComponent> SurfaceComponent;
+	// Road chunks and the segment each starts at. The chunk under a hit is reported as the hit component so callers
+	// can't tell an analytic hit from a scene trace
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> SurfaceChunks;
+	TArray<int32> ChunkFirstSegments;
+	// Hover ground proxy over the same road, reported instead for channels only it blocks (PodGround)
+	TWeakObjectPtr<UPrimitiveComponent> ProxyComponent;
+
+	// Beyond the road edges, further out is off the track
+	float ShoulderWidth = 0.f;
+
+	// The last row of a closed circuit is its first again, so walking off either end carries on from the other
+	bool bClosedLoop = false;
+
+	// Arc-length table in world space
+	TArray<float> Distances;
+	TArray<FVector> LeftEdges;
+	TArray<FVector> RightEdges;
+
+	// Segment index
+	FBox Bounds = FBox(ForceInit);
+	float CellSize = 0.f;
+	int32 CellsX = 0;
+	int32 CellsY = 0;
+	// Segments of cell c are CellSegments[CellStart[c] .. CellStart[c + 1])
+	TArray<int32> CellStart;
+	TArray<int32> CellSegments;
+
+	void Build(AProceduralTrackGenerator& InTrack);
+
+	int32 NumSegments() const { return FMath::Max(Distances.Num() - 1, 0); }
+
+	// Whichever of the road and its proxy a scene trace on Channel would hit, null if neither blocks it
+	UPrimitiveComponent* GetBlockingComponent(ECollisionChannel Channel) const;
+
+	// Road chunk holding Segment and the segment it starts at
+	UPrimitiveComponent* GetSurfaceChunk(int32 Segment, int32& OutFirstSegment) const;
+
+	// First crossing of the segment Start-End with the road ribbon
+	bool Raycast(const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+
+	// Projects Position onto the road below or above it. Fails when it isn't over the road
+	bool Project(const FVector& Position, FPodTrackSurfacePoint& OutPoint) const;
+
+	// Segment whose centre line passes closest to Position among those the grid lists near it, INDEX_NONE when the
+	// track is nowhere near
+	int32 FindNearestSegment(const FVector& Position) const;
+
+	// Steps from Segment towards Position along the table, for a pod that moved a little since Segment was found.
+	// INDEX_NONE when it hasn't settled within a few steps, or ran off the start or finish of an open track
+	int32 WalkToSegment(const FVector& Position, int32 Segment) const;
+
+	// Position against Segment. Before the start or past the finish of an open track is off the track
+	void MakeCoordinate(const FVector& Position, int32 Segment, FPodTrackCoordinate& OutCoordinate) const;
+
+private:
+	// Position against the centre line of Segment. OutAlpha is where along the segment it falls (unclamped), the point
+	// is taken at OutAlpha clamped to the segment
+	bool ProjectOnSegment(const FVector& Position, int32 Segment, double& OutAlpha, double& OutHalfWidth, FPodTrackSurfacePoint& OutPoint) const;
+
+	template<typename VisitorType>
+	void ForEachCandidateSegment(const FBox& QueryBounds, VisitorType&& Visitor) const;
+};
+
+/**
+ * Answers ground queries against generated tracks from their spline instead of the physics scene. Tracks register
+ * themselves when they begin play or regenerate; hover code reaches this through PodGroundProbe.
+ */
+UCLASS()
+class PROJECTPODRACER_API UPodTrackSurfaceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UPodTrackSurfaceSubsystem* Get(const UWorld* World);
+
+	// Rebuilds the track's table if it is already registered
+	void RegisterTrack(AProceduralTrackGenerator* Track);
+	void UnregisterTrack(AProceduralTrackGenerator* Track);
+
+	bool HasTracks() const { return Surfaces.Num() > 0; }
+
+	// Nearest road crossing of Start-End on any registered track whose mesh blocks Channel. Returns false when the ray
+	// misses every track, the caller should then trace the scene
+	bool LineTrace(const FVector& Start, const FVector& End, ECollisionChannel Channel, FHitResult& OutHit) const;
+
+	// Road point nearest in height to Position over any registered track
+	bool ProjectToSurface(const FVector& Position, FPodTrackSurfacePoint& OutPoint) const;
+
+	// Distance along, offset across and height above the nearest registered track, found through the segment grid
+	// without any trace. Fails (Zone OffTrack) when no track is near
+	UFUNCTION(BlueprintCallable, Category = "Track")
+	bool GetTrackCoordinate(const FVector& Position, FPodTrackCoordinate& OutCoordinate) const;
+
+	// Same, starting from the coordinate found last frame and stepping to a neighbouring segment, constant time while
+	// the pod keeps moving along the track. Falls back to GetTrackCoordinate when the walk doesn't settle
+	UFUNCTION(BlueprintCallable, Category = "Track")
+	bool UpdateTrackCoordinate(const FVector& Position, UPARAM(ref) FPodTrackCoordinate& Coordinate) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TArray<FPodTrackSurface> Surfaces;
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodTuningDataAsset.h"
+
+const FPodVehicleTuning UPodTuningDataAsset::DefaultVehicleTuning;
+const FPodMovementTuning UPodTuningDataAsset::DefaultMovementTuning;
+const FPodControllerTuning UPodTuningDataAsset::DefaultControllerTuning;
+
+FPrimaryAssetId UPodTuningDataAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(TEXT("PodTuning"), GetFName());
+}
+
+#if WITH_EDITORONLY_DATA
+bool UPodTuningDataAsset::ApplyDeprecatedTuning(const UObject* Owner, const UScriptStruct* TuningStruct, void* Tuning)
+{
+	const UObject* Archetype = Owner->GetArchetype();
+	bool bApplied = false;
+	for (TFieldIterator<FProperty> It(TuningStruct); It; ++It)
+	{
+		const FProperty* Field = *It;
+		const FProperty* Deprecated = FindFProperty<FProperty>(Owner->GetClass(), *(Field->GetName() + TEXT("_DEPRECATED")));
+		// The native CDO's archetype is the parent class's CDO, which never had these properties
+		if (!Deprecated || !Deprecated->SameType(Field) || !Archetype || !Archetype->IsA(Deprecated->GetOwnerClass()))
+		{
+			continue;
+		}
+
+		const void* Value = Deprecated->ContainerPtrToValuePtr<void>(Owner);
+		if (!Deprecated->Identical(Value, Deprecated->ContainerPtrToValuePtr<void>(Archetype)))
+		{
+			Field->CopyCompleteValue(Field->ContainerPtrToValuePtr<void>(Tuning), Value);
+			bApplied = true;
+		}
+	}
+	return bApplied;
+}
+
+void UPodTuningDataAsset::LogTuningMismatch(const UObject* Owner, const UPodTuningDataAsset* DefaultAsset, const UScriptStruct* TuningStruct,
+	const void* Tuning, const void* DefaultTuning)
+{
+	TArray<FString> Fields;
+	for (TFieldIterator<FProperty> It(TuningStruct); It; ++It)
+	{
+		const FProperty* Field = *It;
+		const void* Value = Field->ContainerPtrToValuePtr<void>(Tuning);
+		const void* DefaultValue = Field->ContainerPtrToValuePtr<void>(DefaultTuning);
+		if (!Field->Identical(Value, DefaultValue))
+		{
+			FString ValueText, DefaultText;
+			Field->ExportTextItem_Direct(ValueText, Value, nullptr, nullptr, PPF_None);
+			Field->ExportTextItem_Direct(DefaultText, DefaultValue, nullptr, nullptr, PPF_None);
+			Fields.Add(FString::Printf(TEXT("%s=%s (default %s)"), *Field->GetName(), *ValueText, *DefaultText));
+		}
+	}
+	UE_LOG(LogTemp, Warning, TEXT("%s: deprecated %s overrides differ from %s and were not migrated, move them into a tuning asset: %s"),
+		*Owner->GetPathName(), *TuningStruct->GetName(), DefaultAsset ? *DefaultAsset->GetPathName() : TEXT("the default tuning"),
+		*FString::Join(Fields, TEXT(", ")));
+}
+#endif
@@ -0,0 +1,306 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/EngineTypes.h"
+#include "ProjectPodracer.h"
+#include "PodTuningDataAsset.generated.h"
+
+// Tuning read by UPodVehicleMovementComponent every move. Floats are grouped in the order ApplyMovementLogic reads them
+USTRUCT(BlueprintType)
+struct FPodVehicleTuning
+{
+	GENERATED_BODY()
+
+	// Max linear speed (cm/s)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement")
+	float MaxSpeed = 15000.0f;
+	// Linear acceleration rate (cm/s^2)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement")
+	float Acceleration = 2000.0f;
+	// Deceleration rate when no forward input is applied (cm/s^2)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement")
+	float Deceleration = 3000.0f;
+	// Linear damping (0-1, 1 means instant stop)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement")
+	float LinearDamping = 0.05f;
+	// Interpolation speed for air resistance
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement")
+	float DragCoefficient = 10.0f;
+	// Gravity applied when airborne (cm/s^2)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement")
+	float GravityScale = 980.0f;
+
+	// Max target angular velocity for turning (degrees/s)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Steering")
+	float MaxTurnRate = 200.0f;
+	// How quickly the yaw velocity reaches its target (degrees/s^2)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Steering")
+	float TurnAcceleration = 1000.0f;
+	// Angular damping for turning (0-1, 1 means instant stop)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Steering")
+	float AngularDamping = 10.0f;
+	// Multiplier for steering at MaxSpeed (0 to 1, lower = less turn)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Steering")
+	float HighSpeedSteeringDampFactor = 0.3f;
+	// Speed for interpolating keyboard input to smoothed input
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Steering")
+	float KeyboardSteeringInterpSpeed = 15.0f;
+	// Speed for returning smoothed input to 0
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Steering")
+	float KeyboardSteeringReturnSpeed = 30.0f;
+
+	// Additional acceleration when boosting (cm/s^2)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Boost")
+	float BoostAcceleration = 15000.0f;
+	// Max speed multiplier when boosting
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Boost")
+	float BoostMaxSpeedMultiplier = 1.8f;
+	// Deceleration rate when braking (cm/s^2)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Brake")
+	float BrakeDeceleration = 20000.0f;
+
+	// How much turn speed is multiplied when drifting
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Drift")
+	float DriftTurnSpeedMultiplier = 1.5f;
+	// Multiplier for linear damping when drifting (lower = more slide)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Drift")
+	float DriftLinearDampingMultiplier = 0.05f;
+	// Multiplier for angular damping when drifting (lower = sustains spin more)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Drift")
+	float DriftAngularDampingMultiplier = 0.2f;
+	// How much lateral velocity is retained when drifting (0-1, 1 means no lateral friction)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Drift")
+	float DriftLateralSlideFactor = 0.9f;
+	// Minimum slide factor for indefinite drift
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Drift")
+	float DriftMinSlideFactor = 0.3f;
+	// How quickly the lateral momentum decays during drift (lower = longer slide)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Drift")
+	float DriftMomentumDecayRate = 0.05f;
+	// Scales how much lateral momentum adds to the velocity
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Drift")
+	float DriftLateralContributionScale = 0.05f;
+	// Maximum magnitude for lateral momentum
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Drift")
+	float DriftLateralMomentumMax = 5000.0f;
+
+	// How much turn input affects yaw when airborne
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|AirControl")
+	float AirControlTurnFactor = 0.4f;
+	// How much forward/backward input affects pitch when airborne
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|AirControl")
+	float AirControlPitchFactor = 0.6f;
+	// How much turn input affects roll when airborne
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|AirControl")
+	float AirControlRollFactor = 0.7f;
+
+	// How far down to trace for ground
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|GroundDetection")
+	float GroundTraceDistance = 50.0f;
+	// Radius for ground detection trace
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|GroundDetection")
+	float GroundDetectionRadius = 60.0f;
+
+	// Position difference before a client correction occurs (cm)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Networking")
+	float CorrectionThreshold = 10.0f;
+
+	// Max angle of engine turn roll rotation
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|Visuals")
+	float AngleOfRoll = 30.0f;
+
+	// Collision channel for ground trace
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement|GroundDetection")
+	TEnumAsByte<ECollisionChannel> GroundCollisionChannel = ECC_PodGround;
+};
+
+// Tuning read by UPodMovementComponent every move
+USTRUCT(BlueprintType)
+struct FPodMovementTuning
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Hover")
+	float HoverHeight = 100.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Hover")
+	float MaxGroundDist = 500.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Hover")
+	float RotationInterpSpeed = 10.0f; // Degrees per second
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float Mass = 1000.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float FallGravity = 4905.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float MaxVelocity = 2000.0f; // 20m/s
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float MaxSpeed = 1500.0f; // 15m/s
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float Acceleration = 2000.0f; // cm/s^2
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float TurnRate = 90.0f; // Degrees/s
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float BrakeDeceleration = 3000.0f; // cm/s^2
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float DriftTurnRateMultiplier = 1.5f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float BoostSpeedMultiplier = 1.5f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float AirControlMultiplier = 0.3f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float CorrectionThreshold = 10.0f; // cm
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float CorrectionInterpSpeed = 10.0f; // Units/s
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float ServerStateUpdateThreshold = 5.0f; // cm, for triggering ForceNetUpdate
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	float ServerStateForceUpdateInterval = 0.1f; // Seconds, for periodic updates
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodRacer|Physics")
+	TEnumAsByte<ECollisionChannel> GroundCollisionChannel = ECC_PodGround;
+};
+
+// Tuning read by AEngineControllerPodRacer every tick. The hover PID stays on the pawn, it carries per-pod state
+USTRUCT(BlueprintType)
+struct FPodControllerTuning
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|DriveSettings")
+	float SlowingVelFactor = 0.99f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|DriveSettings")
+	float BrakingVelFactor = 0.98f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|DriveSettings")
+	float AngleOfRoll = 30.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|HoverSettings")
+	float HoverHeight = 100.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|HoverSettings")
+	float MaxGroundDist = 500.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float TerminalVelocity = 30000.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float HoverGravity = 2000.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float FallGravity = 9810.0f;
+	// Max turn rate in radians/sec at full stick input
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float MaxTurnRate = 2.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float SteeringMultiplier = 600.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float SidewaysGripFactor = 100.0f;
+	// At max speed, steering is 40% as effective
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float HighSpeedSteeringDampFactor = 0.4f;
+	// How fast the steering ramps up when a key is pressed
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float KeyboardSteeringInterpSpeed = 5.0f;
+	// How fast the steering returns to center when released
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float KeyboardSteeringReturnSpeed = 8.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float DriftMultiplier = 1.5f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float BoostMultiplier = 3.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|PhysicsSettings")
+	float Mass = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics")
+	float LinearDamping = 0.5f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics")
+	float AngularDamping = 3.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ConfigData|HoverSettings")
+	TEnumAsByte<ECollisionChannel> GroundCollisionChannel = ECC_PodGround;
+};
+
+/**
+ * Movement tuning shared by every pod that references it. Components keep only a pointer and read through a const
+ * reference, so a grid of pods doesn't carry its own copy of every tuning value. Components without an asset use the
+ * struct defaults, which match the old per-component defaults.
+ */
+UCLASS(BlueprintType)
+class PROJECTPODRACER_API UPodTuningDataAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Used by UPodVehicleMovementComponent
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (ShowOnlyInnerProperties))
+	FPodVehicleTuning Vehicle;
+
+	// Used by UPodMovementComponent
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (ShowOnlyInnerProperties))
+	FPodMovementTuning Movement;
+
+	// Used by AEngineControllerPodRacer
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (ShowOnlyInnerProperties))
+	FPodControllerTuning Controller;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	static const FPodVehicleTuning& GetVehicleTuning(const UPodTuningDataAsset* Asset)
+	{
+		return Asset ? Asset->Vehicle : DefaultVehicleTuning;
+	}
+	static const FPodMovementTuning& GetMovementTuning(const UPodTuningDataAsset* Asset)
+	{
+		return Asset ? Asset->Movement : DefaultMovementTuning;
+	}
+	static const FPodControllerTuning& GetControllerTuning(const UPodTuningDataAsset* Asset)
+	{
+		return Asset ? Asset->Controller : DefaultControllerTuning;
+	}
+
+#if WITH_EDITORONLY_DATA
+	// PostLoad migration for tuning that used to be per-instance UPROPERTYs on Owner. The old values load into Owner's
+	// <Field>_DEPRECATED properties through the CoreRedirects in DefaultEngine.ini. The ones that differ from Owner's
+	// archetype were overrides saved with Owner: written over Asset's tuning, they're compared with DefaultAsset, the
+	// asset Owner's class defaults use. If they match Asset is pointed at DefaultAsset, otherwise Owner is logged with
+	// the differing fields so its overrides can be moved into a shared asset by hand. Values inherited from the
+	// archetype are left to the archetype's own migration
+	template<typename TuningType>
+	static void MigrateDeprecatedTuning(UObject* Owner, TObjectPtr<UPodTuningDataAsset>& Asset, UPodTuningDataAsset* DefaultAsset,
+		TuningType UPodTuningDataAsset::*Member)
+	{
+		TuningType Tuning = Asset ? Asset->*Member : TuningType();
+		if (!ApplyDeprecatedTuning(Owner, TuningType::StaticStruct(), &Tuning))
+		{
+			return;
+		}
+
+		const TuningType DefaultTuning = DefaultAsset ? DefaultAsset->*Member : TuningType();
+		if (TuningType::StaticStruct()->CompareScriptStruct(&Tuning, &DefaultTuning, PPF_None))
+		{
+			Asset = DefaultAsset;
+		}
+		else
+		{
+			LogTuningMismatch(Owner, DefaultAsset, TuningType::StaticStruct(), &Tuning, &DefaultTuning);
+		}
+	}
+
+	// Same, with DefaultAsset read from the same property on Owner's archetype
+	template<typename OwnerType, typename TuningType>
+	static void MigrateDeprecatedTuning(OwnerType* Owner, TObjectPtr<UPodTuningDataAsset> OwnerType::*AssetMember, TuningType UPodTuningDataAsset::*Member)
+	{
+		const OwnerType* Archetype = Cast<OwnerType>(Owner->GetArchetype());
+		MigrateDeprecatedTuning(Owner, Owner->*AssetMember, Archetype ? (Archetype->*AssetMember).Get() : nullptr, Member);
+	}
+#endif
+
+private:
+#if WITH_EDITORONLY_DATA
+	// Copies Owner's <Field>_DEPRECATED overrides into the matching fields of Tuning, returns whether there were any
+	static bool ApplyDeprecatedTuning(const UObject* Owner, const UScriptStruct* TuningStruct, void* Tuning);
+	static void LogTuningMismatch(const UObject* Owner, const UPodTuningDataAsset* DefaultAsset, const UScriptStruct* TuningStruct,
+		const void* Tuning, const void* DefaultTuning);
+#endif
+
+	static const FPodVehicleTuning DefaultVehicleTuning;
+	static const FPodMovementTuning DefaultMovementTuning;
+	static const FPodControllerTuning DefaultControllerTuning;
+};
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PodTuningDataAsset.h"
+#include "EngineControllerPodRacer.h"
+#include "PodMovementComponent.h"
+#include "PodVehicleMovementComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodTuningFootprintTest, "ProjectPodracer.Tuning.SharedAssetFootprint",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Reports what each pod no longer carries now that its tuning is read from one shared asset, and checks that pods
+// without an asset read the same defaults the per-instance properties had
+bool FPodTuningFootprintTest::RunTest(const FString& Parameters)
+{
+	struct FFootprint
+	{
+		const TCHAR* Owner;
+		SIZE_T TuningBytes;
+	};
+	// Each owner swaps its tuning for an 8 byte asset pointer
+	const FFootprint Footprints[] = {
+		{ TEXT("UPodVehicleMovementComponent"), sizeof(FPodVehicleTuning) },
+		{ TEXT("UPodMovementComponent"), sizeof(FPodMovementTuning) },
+		{ TEXT("AEngineControllerPodRacer"), sizeof(FPodControllerTuning) },
+	};
+	constexpr int32 PodCount = 64;
+	for (const FFootprint& Footprint : Footprints)
+	{
+		const int64 SavedPerPod = int64(Footprint.TuningBytes) - int64(sizeof(TObjectPtr<UPodTuningDataAsset>));
+		AddInfo(FString::Printf(TEXT("%s: %d bytes of tuning per pod moved into the asset, %lld saved per pod, %lld for %d pods sharing one asset"),
+			Footprint.Owner, int32(Footprint.TuningBytes), SavedPerPod, SavedPerPod * PodCount - int64(Footprint.TuningBytes), PodCount));
+		TestTrue(FString::Printf(TEXT("%s tuning is larger than the pointer replacing it"), Footprint.Owner), SavedPerPod > 0);
+	}
+
+	TestEqual(TEXT("Default vehicle MaxSpeed"), UPodTuningDataAsset::GetVehicleTuning(nullptr).MaxSpeed, 15000.0f);
+	TestEqual(TEXT("Default movement HoverHeight"), UPodTuningDataAsset::GetMovementTuning(nullptr).HoverHeight, 100.0f);
+	TestEqual(TEXT("Default controller TerminalVelocity"), UPodTuningDataAsset::GetControllerTuning(nullptr).TerminalVelocity, 30000.0f);
+	return true;
+}
+
+#if WITH_EDITORONLY_DATA
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPodTuningMigrationTest, "ProjectPodracer.Tuning.DeprecatedPropertyMigration",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Values loaded into _DEPRECATED properties that differ from the archetype are checked against the class default asset:
+// matching ones point the pod at it, others are logged and leave the pod's asset alone. Pods that only inherited the
+// archetype's values keep their asset
+bool FPodTuningMigrationTest::RunTest(const FString& Parameters)
+{
+	auto SetDeprecated = [this](UObject* Owner, const TCHAR* Name, float Value)
+	{
+		const FFloatProperty* Property = FindFProperty<FFloatProperty>(Owner->GetClass(), Name);
+		if (TestNotNull(FString::Printf(TEXT("%s exists"), Name), Property))
+		{
+			Property->SetPropertyValue_InContainer(Owner, Value);
+		}
+	};
+
+	UPodTuningDataAsset* Shared = NewObject<UPodTuningDataAsset>(GetTransientPackage());
+	Shared->Vehicle.Acceleration = 1234.0f;
+
+	UPodVehicleMovementComponent* Untouched = NewObject<UPodVehicleMovementComponent>(GetTransientPackage());
+	TObjectPtr<UPodTuningDataAsset> UntouchedAsset = Shared;
+	UPodTuningDataAsset::MigrateDeprecatedTuning(Untouched, UntouchedAsset, Shared, &UPodTuningDataAsset::Vehicle);
+	TestTrue(TEXT("A pod without overrides keeps the shared asset"), UntouchedAsset == Shared);
+
+	UPodVehicleMovementComponent* Matching = NewObject<UPodVehicleMovementComponent>(GetTransientPackage());
+	SetDeprecated(Matching, TEXT("Acceleration_DEPRECATED"), 1234.0f);
+	TObjectPtr<UPodTuningDataAsset> MatchingAsset;
+	UPodTuningDataAsset::MigrateDeprecatedTuning(Matching, MatchingAsset, Shared, &UPodTuningDataAsset::Vehicle);
+	TestTrue(TEXT("A pod whose overrides match the class default asset is pointed at it"), MatchingAsset == Shared);
+
+	AddExpectedMessage(TEXT("MaxSpeed=9000"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+	UPodVehicleMovementComponent* Overridden = NewObject<UPodVehicleMovementComponent>(GetTransientPackage());
+	SetDeprecated(Overridden, TEXT("MaxSpeed_DEPRECATED"), 9000.0f);
+	TObjectPtr<UPodTuningDataAsset> OverriddenAsset = Shared;
+	UPodTuningDataAsset::MigrateDeprecatedTuning(Overridden, OverriddenAsset, Shared, &UPodTuningDataAsset::Vehicle);
+	TestTrue(TEXT("A pod with differing overrides keeps its asset"), OverriddenAsset == Shared);
+	TestEqual(TEXT("The shared asset is untouched"), Shared->Vehicle.MaxSpeed, 15000.0f);
+
+	// Actors need a world to be created in, it never begins play
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	AEngineControllerPodRacer* Controller = World->SpawnActor<AEngineControllerPodRacer>();
+	if (TestNotNull(TEXT("Controller spawned"), Controller))
+	{
+		AddExpectedMessage(TEXT("HoverHeight=250"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+		SetDeprecated(Controller, TEXT("HoverHeight_DEPRECATED"), 250.0f);
+		TObjectPtr<UPodTuningDataAsset> ControllerAsset;
+		UPodTuningDataAsset::MigrateDeprecatedTuning(Controller, ControllerAsset, nullptr, &UPodTuningDataAsset::Controller);
+		TestNull(TEXT("A controller with differing overrides and no class default asset gets no asset"), ControllerAsset.Get());
+	}
+	World->DestroyWorld(false);
+
+	Shared->Movement.Mass = 1500.0f;
+	UPodMovementComponent* Movement = NewObject<UPodMovementComponent>(GetTransientPackage());
+	SetDeprecated(Movement, TEXT("Mass_DEPRECATED"), 1500.0f);
+	TObjectPtr<UPodTuningDataAsset> MovementAsset;
+	UPodTuningDataAsset::MigrateDeprecatedTuning(Movement, MovementAsset, Shared, &UPodTuningDataAsset::Movement);
+	TestTrue(TEXT("A movement component whose overrides match the class default asset is pointed at it"), MovementAsset == Shared);
+	return true;
+}
+
+#endif
+
+#endif
@@ -81,6 +81,24 @@ void APodVehicle::BeginPlay()
 
 }
 
+void APodVehicle::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+	if (PodMovementComponent)
+	{
+		PodMovementComponent->RefreshRoleTick();
+	}
+}
+
+void APodVehicle::PostNetReceiveRole()
+{
+	Super::PostNetReceiveRole();
+	if (PodMovementComponent)
+	{
+		PodMovementComponent->RefreshRoleTick();
+	}
+}
+
 // Called every frame
 void APodVehicle::Tick(float DeltaTime)
 {
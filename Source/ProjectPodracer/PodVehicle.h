@@ -46,6 +46,9 @@ public:
 	// --- Replication ---
 	// Overrides to specify which properties are replicated.
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	// Rebind the movement component's role tick when possession or the net role changes.
+	virtual void NotifyControllerChanged() override;
+	virtual void PostNetReceiveRole() override;
 
 protected:
 	// Called when the game starts or when spawned
@@ -9,6 +9,8 @@
 #include "Components/CapsuleComponent.h" // For ground detection
 #include "DrawDebugHelpers.h" // For visualizing ground trace
 #include "Kismet/KismetMathLibrary.h" // For FMath::GetMappedRangeValueClamped
+#include "PodDeterminismHarness.h"
+#include "PodGroundProbe.h"
 
 // Constructor: Set default values for movement parameters
 UPodVehicleMovementComponent::UPodVehicleMovementComponent()
@@ -20,50 +22,8 @@ UPodVehicleMovementComponent::UPodVehicleMovementComponent()
 	// Crucial for multiplayer prediction and synchronization.
 	SetIsReplicatedByDefault(true);
 
-	// Physics Parameters - Tuned for custom velocity-based movement
-	MaxSpeed = 15000.0f; // 150 m/s, very fast
-	Acceleration = 2000.0f; // cm/s^2, rapid acceleration
-	Deceleration = 3000.0f; // cm/s^2, natural slowdown
-	LinearDamping = 0.05f; // Small linear damping
-
-	MaxTurnRate = 200.0f; // Max degrees/s target angular velocity for steering
-	TurnAcceleration = 1000.0f; // degrees/s^2, how quickly it reaches MaxTurnRate
-	AngularDamping = 10.0f; // High angular damping for tight turns (stops rotation quickly when not turning)
-	HighSpeedSteeringDampFactor = 0.3f; // At max speed, 30% of normal turn rate
-	KeyboardSteeringInterpSpeed = 15.0f; // Very fast interpolation for keyboard input
-	KeyboardSteeringReturnSpeed = 30.0f; // Very fast return to zero for keyboard
-
-	BoostAcceleration = 15000.0f; // Strong additional acceleration from boost
-	BoostMaxSpeedMultiplier = 1.8f; // 80% increase in max speed when boosting
-
-	BrakeDeceleration = 20000.0f; // Very strong braking deceleration
-
-	DriftTurnSpeedMultiplier = 1.5f; // Double turn speed while drifting
-	DriftLinearDampingMultiplier = 0.05f; // Very low linear damping for max slide
-	DriftAngularDampingMultiplier = 0.2f; // Very low angular damping, sustains spin much more
-	DriftLateralSlideFactor = 0.9f; // Retain 90% of lateral velocity (very slippery)
-	DriftMinSlideFactor = 0.3f; // Ensures a minimum amount of slide even at low speed
-
-	// Simplified Mario Kart style drifting parameters
-	DriftMomentumDecayRate = 0.05f; // Low decay for sustained slide
-	DriftLateralContributionScale = 0.05f; // Contribution of lateral momentum to velocity
-	DriftLateralMomentumMax = 5000.0f; // Max lateral momentum magnitude
-
-	AirControlTurnFactor = 0.4f; // Weaker turn in air
-	AirControlPitchFactor = 0.6f; // Good pitch responsiveness in air
-	AirControlRollFactor = 0.7f; // Decent roll control in air
-
-	GroundTraceDistance = 50.0f; // How far below to check for ground
-	GroundDetectionRadius = 60.0f; // Radius for ground trace (slightly less than capsule radius)
-	GroundCollisionChannel = ECC_Visibility; // Default, consider custom Trace Channel
-
-	DragCoefficient = 10.0f; // Interpolation speed for air resistance
-
-	CorrectionThreshold = 10.0f; // Correct if discrepancy > 10cm
-	GravityScale = 980.0f; // Approx. 1G in cm/s^2
-
-	// Visual config
-	AngleOfRoll = 30.0f;
+	// Movement tuning lives in TuningAsset (FPodVehicleTuning defaults when unset)
+	bShowHoverTraceMessages = true;
 
 	MoveForwardInput = 0.0f;
 	TurnRightInput = 0.0f;
@@ -75,10 +35,19 @@ UPodVehicleMovementComponent::UPodVehicleMovementComponent()
 	SmoothedRudderInput = 0.0f;
 }
 
+void UPodVehicleMovementComponent::PostLoad()
+{
+	Super::PostLoad();
+#if WITH_EDITORONLY_DATA
+	UPodTuningDataAsset::MigrateDeprecatedTuning(this, &ThisClass::TuningAsset, &UPodTuningDataAsset::Vehicle);
+#endif
+}
+
 void UPodVehicleMovementComponent::BeginPlay()
 {
 	Super::BeginPlay();
 	OwningPodVehicle = Cast<APodVehicle>(GetOwner());
+	RefreshRoleTick();
 }
 
 // Core tick function for movement and network handling
@@ -86,32 +55,51 @@ void UPodVehicleMovementComponent::TickComponent(float DeltaTime, ELevelTick Tic
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (!IsValid(UpdatedComponent) || ShouldSkipUpdate(DeltaTime))
+	if (!IsValid(UpdatedComponent) || ShouldSkipUpdate(DeltaTime) || !RoleTick)
 	{
 		return;
 	}
 
-	APawn* OwnerPawn = Cast<APawn>(GetOwner());
-	if (!OwnerPawn)
+	(this->*RoleTick)(DeltaTime);
+}
+
+void UPodVehicleMovementComponent::RefreshRoleTick()
+{
+	RoleTick = PawnOwner ? TPodRoleTickSelector<UPodVehicleMovementComponent>::Select(PodTickRole::Resolve(PawnOwner), bShowHoverTraceMessages) : nullptr;
+}
+
+#if WITH_EDITOR
+void UPodVehicleMovementComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UPodVehicleMovementComponent, bShowHoverTraceMessages) && RoleTick)
 	{
-		return;
+		RefreshRoleTick();
 	}
+}
+#endif
+
+template<EPodTickRole Role, bool bDebug>
+void UPodVehicleMovementComponent::TickRole(float DeltaTime)
+{
+	constexpr bool bLocallyControlled = Role == EPodTickRole::LocalAuthority || Role == EPodTickRole::AutonomousProxy;
 
 	// Input smoothing for local client (keyboard friendliness)
-	if (OwnerPawn->IsLocallyControlled())
+	if constexpr (bLocallyControlled)
 	{
-		float InterpSpeed = FMath::IsNearlyZero(TurnRightInput) ? KeyboardSteeringReturnSpeed : KeyboardSteeringInterpSpeed;
+		const FPodVehicleTuning& Tuning = GetTuning();
+		float InterpSpeed = FMath::IsNearlyZero(TurnRightInput) ? Tuning.KeyboardSteeringReturnSpeed : Tuning.KeyboardSteeringInterpSpeed;
 		SmoothedRudderInput = FMath::FInterpTo(SmoothedRudderInput, TurnRightInput, DeltaTime, InterpSpeed);
 	}
 
 	// Determine movement application based on role
-	if (GetOwnerRole() == ROLE_Authority) // Server authoritative
+	if constexpr (Role == EPodTickRole::LocalAuthority || Role == EPodTickRole::Authority) // Server authoritative
 	{
 		FRotator NewRotation = UpdatedComponent->GetComponentRotation();
 		ApplyMovementLogic(MoveForwardInput, TurnRightInput, bIsBoosting, bIsBraking, bIsDrifting, DeltaTime, Velocity, NewRotation, CurrentAngularYawVelocity);
 		Client_AcknowledgeMove(CurrentMoveID, UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetComponentRotation(), Velocity, CurrentAngularYawVelocity);
 	}
-	else if (OwnerPawn->IsLocallyControlled()) // Client prediction
+	else if constexpr (Role == EPodTickRole::AutonomousProxy) // Client prediction
 	{
 		CurrentMoveID++;
 		FClientMoveData CurrentMove(MoveForwardInput, SmoothedRudderInput, bIsBoosting, bIsBraking, bIsDrifting, CurrentMoveID, DeltaTime);
@@ -124,8 +112,8 @@ void UPodVehicleMovementComponent::TickComponent(float DeltaTime, ELevelTick Tic
 	}
 
 	// Visuals for all roles - use appropriate input
-	float VisualTurnInput = OwnerPawn->IsLocallyControlled() ? SmoothedRudderInput : TurnRightInput;
-	HandleEngineHoveringVisuals(VisualTurnInput, DeltaTime);
+	float VisualTurnInput = bLocallyControlled ? SmoothedRudderInput : TurnRightInput;
+	HandleEngineHoveringVisuals<bDebug>(VisualTurnInput, DeltaTime);
 }
 
 // Input setters (called by PodVehicle)
@@ -159,13 +147,19 @@ void UPodVehicleMovementComponent::ApplyMovementLogic(float InMoveForwardInput,
 {
 	if (InDeltaTime <= 0.0f) return;
 
+#if WITH_POD_DETERMINISM_HARNESS
+	FPodDeterminismHarness::NotifyApplyMovementLogic(this, InMoveForwardInput, InTurnRightInput, InIsBoosting, InIsBraking, InIsDrifting, InDeltaTime, OutVelocity, OutRotation, OutAngularYawVelocity);
+#endif
+
+	const FPodVehicleTuning& Tuning = GetTuning();
+
 	// Ground detection and normal
 	FHitResult GroundHit;
 	FVector GroundNormal = GetGroundNormal(GroundHit);
 
 	bool bGrounded = IsGrounded();
-	float ControlMultiplier = bGrounded ? 1.0f : AirControlTurnFactor;
-	float EffectiveMaxSpeed = MaxSpeed * (InIsBoosting ? BoostMaxSpeedMultiplier : 1.0f);
+	float ControlMultiplier = bGrounded ? 1.0f : Tuning.AirControlTurnFactor;
+	float EffectiveMaxSpeed = Tuning.MaxSpeed * (InIsBoosting ? Tuning.BoostMaxSpeedMultiplier : 1.0f);
 
 	FVector ForwardVector = UpdatedComponent->GetForwardVector();
 	FVector RightVector = UpdatedComponent->GetRightVector();
@@ -191,7 +185,7 @@ void UPodVehicleMovementComponent::ApplyMovementLogic(float InMoveForwardInput,
 	// Apply gravity if airborne
 	if (!bGrounded)
 	{
-		OutVelocity.Z -= GravityScale * InDeltaTime;
+		OutVelocity.Z -= Tuning.GravityScale * InDeltaTime;
 	}
 
 	// Move the component
@@ -230,10 +224,11 @@ void UPodVehicleMovementComponent::HandleDriftState(bool InIsDrifting, float Del
 // Sub-function: Apply damping (linear and air resistance)
 void UPodVehicleMovementComponent::ApplyDamping(float DeltaTime, bool InIsDrifting, bool bGrounded, FVector& OutVelocity, const FVector& GroundNormal)
 {
-	float CurrentLinearDamping = LinearDamping;
+	const FPodVehicleTuning& Tuning = GetTuning();
+	float CurrentLinearDamping = Tuning.LinearDamping;
 	if (InIsDrifting && bGrounded)
 	{
-		CurrentLinearDamping *= DriftLinearDampingMultiplier;
+		CurrentLinearDamping *= Tuning.DriftLinearDampingMultiplier;
 	}
 	OutVelocity *= FMath::Clamp(1.0f - CurrentLinearDamping * DeltaTime, 0.0f, 1.0f);
 
@@ -241,7 +236,7 @@ void UPodVehicleMovementComponent::ApplyDamping(float DeltaTime, bool InIsDrifti
 	FVector Forward = UpdatedComponent->GetForwardVector();
 	FVector ForwardVel = FVector::DotProduct(OutVelocity, Forward) * Forward;
 	FVector PerpVel = OutVelocity - ForwardVel;
-	float DragInterp = DragCoefficient * (bGrounded ? 1.0f : 0.25f);
+	float DragInterp = Tuning.DragCoefficient * (bGrounded ? 1.0f : 0.25f);
 	PerpVel = FMath::VInterpTo(PerpVel, FVector::ZeroVector, DeltaTime, DragInterp);
 	if (bGrounded)
 	{
@@ -253,11 +248,12 @@ void UPodVehicleMovementComponent::ApplyDamping(float DeltaTime, bool InIsDrifti
 // Sub-function: Apply lateral friction for drifting/sliding
 void UPodVehicleMovementComponent::ApplyLateralFriction(float DeltaTime, bool InIsDrifting, bool bGrounded, FVector& OutVelocity, const FVector& RightVector)
 {
+	const FPodVehicleTuning& Tuning = GetTuning();
 	if (bGrounded)
 	{
 		FVector LateralVel = FVector::DotProduct(OutVelocity, RightVector) * RightVector;
 		float LateralDamping = InIsDrifting ? 0.02f : 20.0f;
-		float SlideFactor = InIsDrifting ? DriftLateralSlideFactor : 0.0f;
+		float SlideFactor = InIsDrifting ? Tuning.DriftLateralSlideFactor : 0.0f;
 		OutVelocity -= LateralVel * (1.0f - SlideFactor) * FMath::Clamp(LateralDamping * DeltaTime, 0.0f, 1.0f);
 
 		if (!InIsDrifting && LateralVel.SizeSquared() > KINDA_SMALL_NUMBER)
@@ -270,6 +266,7 @@ void UPodVehicleMovementComponent::ApplyLateralFriction(float DeltaTime, bool In
 // Sub-function: Cap speed to max
 FVector UPodVehicleMovementComponent::CapSpeed(const FVector& InVelocity, float Max, bool bGrounded) const
 {
+	const FPodVehicleTuning& Tuning = GetTuning();
 	FVector Vel = InVelocity;
 	if (Vel.SizeSquared() > FMath::Square(Max))
 	{
@@ -277,7 +274,7 @@ FVector UPodVehicleMovementComponent::CapSpeed(const FVector& InVelocity, float
 	}
 	if (!bGrounded)
 	{
-		Vel.Z = FMath::Clamp(Vel.Z, -GravityScale, 0.0f);
+		Vel.Z = FMath::Clamp(Vel.Z, -Tuning.GravityScale, 0.0f);
 	}
 	return Vel;
 }
@@ -285,19 +282,20 @@ FVector UPodVehicleMovementComponent::CapSpeed(const FVector& InVelocity, float
 // Sub-function: Apply acceleration or braking
 void UPodVehicleMovementComponent::ApplyAcceleration(float DeltaTime, float InForwardInput, bool InBoosting, bool InBraking, float ControlMul, const FVector& Forward, FVector& OutVelocity)
 {
+	const FPodVehicleTuning& Tuning = GetTuning();
 	if (InBraking)
 	{
 		float Speed2D = OutVelocity.Size2D();
 		if (Speed2D > 0.0f)
 		{
 			FVector Dir = OutVelocity.GetSafeNormal2D();
-			float NewSpeed = FMath::Max(0.0f, Speed2D - BrakeDeceleration * DeltaTime);
+			float NewSpeed = FMath::Max(0.0f, Speed2D - Tuning.BrakeDeceleration * DeltaTime);
 			OutVelocity = Dir * NewSpeed;
 		}
 	}
 	else
 	{
-		float Accel = Acceleration + (InBoosting ? BoostAcceleration : 0.0f);
+		float Accel = Tuning.Acceleration + (InBoosting ? Tuning.BoostAcceleration : 0.0f);
 		FVector AccelVec = Forward * InForwardInput * Accel * ControlMul;
 		OutVelocity += AccelVec * DeltaTime;
 	}
@@ -306,17 +304,18 @@ void UPodVehicleMovementComponent::ApplyAcceleration(float DeltaTime, float InFo
 // Sub-function: Apply steering and angular velocity
 void UPodVehicleMovementComponent::ApplySteering(float DeltaTime, float InTurnInput, bool InDrifting, bool bGrounded, float EffectiveMaxSpeed, FRotator& OutRotation, float& OutAngularYawVelocity)
 {
+	const FPodVehicleTuning& Tuning = GetTuning();
 	if (bGrounded)
 	{
-		float SpeedMul = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, MaxSpeed), FVector2D(1.0f, HighSpeedSteeringDampFactor), Velocity.Size());
-		float CurrentTurnRate = MaxTurnRate * SpeedMul;
-		float CurrentAngularAccel = TurnAcceleration;
-		float CurrentAngularDamp = AngularDamping;
+		float SpeedMul = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, Tuning.MaxSpeed), FVector2D(1.0f, Tuning.HighSpeedSteeringDampFactor), Velocity.Size());
+		float CurrentTurnRate = Tuning.MaxTurnRate * SpeedMul;
+		float CurrentAngularAccel = Tuning.TurnAcceleration;
+		float CurrentAngularDamp = Tuning.AngularDamping;
 
 		if (InDrifting)
 		{
-			CurrentTurnRate *= DriftTurnSpeedMultiplier;
-			CurrentAngularDamp *= DriftAngularDampingMultiplier;
+			CurrentTurnRate *= Tuning.DriftTurnSpeedMultiplier;
+			CurrentAngularDamp *= Tuning.DriftAngularDampingMultiplier;
 			CurrentAngularAccel *= 0.9f;
 		}
 
@@ -330,10 +329,10 @@ void UPodVehicleMovementComponent::ApplySteering(float DeltaTime, float InTurnIn
 	}
 	else // Airborne
 	{
-		OutRotation.Yaw += InTurnInput * AirControlTurnFactor * MaxTurnRate * DeltaTime;
+		OutRotation.Yaw += InTurnInput * Tuning.AirControlTurnFactor * Tuning.MaxTurnRate * DeltaTime;
 		// TODO: Don't want to change pitch and roll while midair unless we have an auto correct once we land to offset it
-		//OutRotation.Pitch += InTurnInput * AirControlPitchFactor * MaxTurnRate * DeltaTime; // Improved air pitch control
-		//OutRotation.Roll += InTurnInput * AirControlRollFactor * MaxTurnRate * DeltaTime;
+		//OutRotation.Pitch += InTurnInput * Tuning.AirControlPitchFactor * Tuning.MaxTurnRate * DeltaTime; // Improved air pitch control
+		//OutRotation.Roll += InTurnInput * Tuning.AirControlRollFactor * Tuning.MaxTurnRate * DeltaTime;
 		OutAngularYawVelocity = 0.0f;
 	}
 }
@@ -341,14 +340,14 @@ void UPodVehicleMovementComponent::ApplySteering(float DeltaTime, float InTurnIn
 // Improved ground normal detection with multiple traces
 FVector UPodVehicleMovementComponent::GetGroundNormal(FHitResult& OutHit) const
 {
+	const FPodVehicleTuning& Tuning = GetTuning();
 	FVector Start = UpdatedComponent->GetComponentLocation();
-	FVector End = Start - FVector(0, 0, GroundTraceDistance + 50.0f); // Extra distance
-	FCollisionQueryParams Params;
+	FVector End = Start - FVector(0, 0, Tuning.GroundTraceDistance + 50.0f); // Extra distance
+	FCollisionQueryParams Params(PodQueryStats::Tag(EPodQueryClass::PodVehicle));
 	Params.AddIgnoredActor(GetOwner());
-	Params.bTraceComplex = true;
 
 	FHitResult Hit;
-	GetWorld()->LineTraceSingleByChannel(Hit, Start, End, GroundCollisionChannel, Params);
+	PodGroundProbe::LineTrace(GetWorld(), Hit, Start, End, Tuning.GroundCollisionChannel, Params);
 	OutHit = Hit;
 	return Hit.IsValidBlockingHit() ? Hit.Normal.GetSafeNormal() : FVector::UpVector;
 }
@@ -357,28 +356,31 @@ FVector UPodVehicleMovementComponent::GetGroundNormal(FHitResult& OutHit) const
 bool UPodVehicleMovementComponent::IsGrounded() const
 {
 	if (!UpdatedComponent) return false;
+	const FPodVehicleTuning& Tuning = GetTuning();
 
 	UCapsuleComponent* Capsule = Cast<UCapsuleComponent>(UpdatedComponent);
 	float HalfHeight = Capsule ? Capsule->GetScaledCapsuleHalfHeight() : 50.0f;
 	float Radius = Capsule ? Capsule->GetScaledCapsuleRadius() : 50.0f;
 
 	FVector Start = UpdatedComponent->GetComponentLocation();
-	FVector End = Start - FVector(0, 0, HalfHeight + GroundTraceDistance);
+	FVector End = Start - FVector(0, 0, HalfHeight + Tuning.GroundTraceDistance);
 
-	FCollisionQueryParams Params;
+	FCollisionQueryParams Params(PodQueryStats::Tag(EPodQueryClass::PodVehicle));
 	Params.AddIgnoredActor(GetOwner());
 
 	FCollisionShape Shape = FCollisionShape::MakeSphere(Radius * 0.9f); // Slightly smaller for edge cases
 
 	FHitResult Hit;
-	bool bHit = GetWorld()->SweepSingleByChannel(Hit, Start, End, FQuat::Identity, GroundCollisionChannel, Shape, Params);
+	bool bHit = PodQueryStats::SweepSingleByChannel(GetWorld(), Hit, Start, End, FQuat::Identity, Tuning.GroundCollisionChannel, Shape, Params);
 	return bHit;
 }
 
 // Visual handling - now works on remote vehicles
+template<bool bDebug>
 void UPodVehicleMovementComponent::HandleEngineHoveringVisuals(float InTurnRightInput, float DeltaTime)
 {
-	float RollAngle = AngleOfRoll * InTurnRightInput;
+	const FPodVehicleTuning& Tuning = GetTuning();
+	float RollAngle = Tuning.AngleOfRoll * InTurnRightInput;
 
 	FRotator TargetRelRot(0.0f, 0.0f, RollAngle);
 	FQuat TargetQuat = TargetRelRot.Quaternion();
@@ -386,13 +388,16 @@ void UPodVehicleMovementComponent::HandleEngineHoveringVisuals(float InTurnRight
 	FQuat InterpQuat = FMath::QInterpTo(CurrentQuat, TargetQuat, DeltaTime, 5.0f); // Smoother interp
 	OwningPodVehicle->EngineCenterPoint->SetRelativeRotation(InterpQuat);
 
-	AdjustVehiclePitch(DeltaTime);
+	AdjustVehiclePitch<bDebug>(DeltaTime);
 }
 
 // Improved pitch adjustment with multiple traces for cooler visuals
+template<bool bDebug>
 void UPodVehicleMovementComponent::AdjustVehiclePitch(float DeltaTime)
 {
 	if (!OwningPodVehicle->VehicleCenterRoot || !GetWorld()) return;
+	// Purely visual, the pod keeps its current pitch when the frame's query budget is spent
+	if (!PodQueryStats::HasBudgetForCosmetic()) return;
 
 	const float TraceLength = 1000.0f;
 	const float TraceOffset = 100.0f;
@@ -408,13 +413,13 @@ void UPodVehicleMovementComponent::AdjustVehiclePitch(float DeltaTime)
 	FVector BackEnd = BackStart + Down * TraceLength;
 
 	FHitResult FrontLeftHit, FrontRightHit, BackHit;
-	FCollisionQueryParams Params;
+	FCollisionQueryParams Params(PodQueryStats::Tag(EPodQueryClass::PodVehicle));
 	Params.AddIgnoredActor(OwningPodVehicle);
-	ECollisionChannel Channel = ECC_WorldStatic;
+	ECollisionChannel Channel = GetTuning().GroundCollisionChannel;
 
-	bool bFLHit = GetWorld()->LineTraceSingleByChannel(FrontLeftHit, FrontLeftStart, FrontLeftEnd, Channel, Params);
-	bool bFRHit = GetWorld()->LineTraceSingleByChannel(FrontRightHit, FrontRightStart, FrontRightEnd, Channel, Params);
-	bool bBHit = GetWorld()->LineTraceSingleByChannel(BackHit, BackStart, BackEnd, Channel, Params);
+	bool bFLHit = PodGroundProbe::LineTrace(GetWorld(), FrontLeftHit, FrontLeftStart, FrontLeftEnd, Channel, Params);
+	bool bFRHit = PodGroundProbe::LineTrace(GetWorld(), FrontRightHit, FrontRightStart, FrontRightEnd, Channel, Params);
+	bool bBHit = PodGroundProbe::LineTrace(GetWorld(), BackHit, BackStart, BackEnd, Channel, Params);
 
 	float TargetPitch = 0.0f;
 	float MaxAirPitch = -45.0f;
@@ -430,7 +435,10 @@ void UPodVehicleMovementComponent::AdjustVehiclePitch(float DeltaTime)
 	else if (!bFLHit && !bFRHit && !bBHit)
 	{
 		TargetPitch = MaxAirPitch;
-		GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Red, TEXT("No Hit For Hover Trace."));
+		if constexpr (bDebug)
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Red, TEXT("No Hit For Hover Trace."));
+		}
 	}
 	else
 	{
@@ -449,7 +457,10 @@ void UPodVehicleMovementComponent::AdjustVehiclePitch(float DeltaTime)
 		}
 		Slope.Normalize();
 		TargetPitch = FMath::RadiansToDegrees(FMath::Asin(Slope.Z));
-		GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Yellow, TEXT("Partial Hit For Hover Trace."));
+		if constexpr (bDebug)
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Yellow, TEXT("Partial Hit For Hover Trace."));
+		}
 	}
 
 	TargetPitch = FMath::Clamp(TargetPitch, -45.0f, 45.0f);
@@ -471,6 +482,7 @@ void UPodVehicleMovementComponent::Server_ProcessMove_Implementation(FClientMove
 // Client acknowledgment with smoother correction
 void UPodVehicleMovementComponent::Client_AcknowledgeMove_Implementation(uint32 LastProcessedMoveID, FVector ServerLocation, FRotator ServerRotation, FVector ServerVelocity, float ServerAngularYawVelocity)
 {
+	const FPodVehicleTuning& Tuning = GetTuning();
 	APawn* OwnerPawn = Cast<APawn>(GetOwner());
 	if (!OwnerPawn || !OwnerPawn->IsLocallyControlled())
 	{
@@ -489,7 +501,7 @@ void UPodVehicleMovementComponent::Client_AcknowledgeMove_Implementation(uint32
 	FRotator ClientRot = UpdatedComponent->GetComponentRotation();
 
 	float LocDiff = FVector::DistSquared(ClientLoc, ServerLocation);
-	if (LocDiff > FMath::Square(CorrectionThreshold) || !ClientRot.Equals(ServerRotation, 1.0f) || !Velocity.Equals(ServerVelocity, 10.0f) || !FMath::IsNearlyEqual(CurrentAngularYawVelocity, ServerAngularYawVelocity, 5.0f))
+	if (LocDiff > FMath::Square(Tuning.CorrectionThreshold) || !ClientRot.Equals(ServerRotation, 1.0f) || !Velocity.Equals(ServerVelocity, 10.0f) || !FMath::IsNearlyEqual(CurrentAngularYawVelocity, ServerAngularYawVelocity, 5.0f))
 	{
 		// Smoother correction: Interp to server state over a short time instead of hard set
 		// But for now, keep hard set + replay, but increase threshold for minor diffs
@@ -498,6 +510,9 @@ void UPodVehicleMovementComponent::Client_AcknowledgeMove_Implementation(uint32
 		CurrentAngularYawVelocity = ServerAngularYawVelocity;
 
 		// Replay history
+#if WITH_POD_DETERMINISM_HARNESS
+		FPodDeterminismHarness::FScopedCorrectionReplay CorrectionReplay;
+#endif
 		FVector ReplayVel = Velocity;
 		FRotator ReplayRot = ServerRotation;
 		float ReplayYawVel = ServerAngularYawVelocity;
@@ -6,6 +6,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PawnMovementComponent.h"
+#include "PodTickRole.h"
+#include "PodTuningDataAsset.h"
 #include "PodVehicleMovementComponent.generated.h"
 
 class APodVehicle;
@@ -55,10 +57,17 @@ public:
 	UPodVehicleMovementComponent();
 	
 	virtual void BeginPlay() override;
+	virtual void PostLoad() override;
 
 	// Overrides from UPawnMovementComponent
 	// This is where the core movement logic for the vehicle will live.
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// Binds the tick path for the owner's current role. Called from BeginPlay and by the pawn when its controller or net role changes.
+	void RefreshRoleTick();
 
 	// --- Input State ---
 	// Stores the current desired forward movement input (e.g., from W/S keys or joystick).
@@ -106,98 +115,16 @@ public:
 	void Client_AcknowledgeMove(uint32 LastProcessedMoveID, FVector ServerLocation, FRotator ServerRotation, FVector ServerVelocity, float ServerAngularYawVelocity);
 
 
-	// --- Vehicle Physics Parameters ---
-	// Max linear speed (cm/s)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement")
-	float MaxSpeed;
-	// Linear acceleration rate (cm/s^2)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement")
-	float Acceleration;
-	// Deceleration rate when no forward input is applied (cm/s^2)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement")
-	float Deceleration;
-	// Linear damping (0-1, 1 means instant stop)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement")
-	float LinearDamping;
-	// Max target angular velocity for turning (degrees/s)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Steering")
-	float MaxTurnRate;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Steering")
-	float TurnAcceleration;
-	// Angular damping for turning (0-1, 1 means instant stop)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Steering")
-	float AngularDamping;
-	// Multiplier for steering at MaxSpeed (0 to 1, lower = less turn)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Steering")
-	float HighSpeedSteeringDampFactor;
-	// Speed for interpolating keyboard input to smoothed input
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Steering")
-	float KeyboardSteeringInterpSpeed;
-	// Speed for returning smoothed input to 0
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Steering")
-	float KeyboardSteeringReturnSpeed;
-
-	// Boost related parameters
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Boost")
-	float BoostAcceleration; // Additional acceleration when boosting (cm/s^2)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Boost")
-	float BoostMaxSpeedMultiplier; // Max speed multiplier when boosting
-
-	// Brake related parameters
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Brake")
-	float BrakeDeceleration; // Deceleration rate when braking (cm/s^2)
-
-	// Drift related parameters
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Drift")
-	float DriftTurnSpeedMultiplier; // How much turn speed is multiplied when drifting
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Drift")
-	float DriftLinearDampingMultiplier; // Multiplier for linear damping when drifting (lower = more slide)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Drift")
-	float DriftAngularDampingMultiplier; // Multiplier for angular damping when drifting (lower = sustains spin more)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Drift")
-	float DriftLateralSlideFactor; // How much lateral velocity is retained when drifting (0-1, 1 means no lateral friction)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Drift")
-	float DriftMinSlideFactor; // Minimum slide factor for indefinite drift
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Drift")
-	float DriftMomentumDecayRate; // How quickly the lateral momentum decays during drift (lower = longer slide)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Drift")
-	float DriftLateralContributionScale; // Scales how much CurrentLateralMomentum adds to OutVelocity
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Drift")
-	float DriftLateralMomentumMax; // Maximum magnitude for CurrentLateralMomentum
-
-	// Air control parameters
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|AirControl")
-	float AirControlTurnFactor; // How much TurnRightInput affects Yaw when airborne
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|AirControl")
-	float AirControlPitchFactor; // How much Forward/Backward input affects Pitch when airborne (e.g. for tilting)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|AirControl")
-	float AirControlRollFactor; // How much TurnRightInput affects Roll when airborne
-
-	// Air Resistance
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodRacer|Movement")
-	float DragCoefficient; // Interpolation speed for air resistance
-
-	// Ground detection parameters
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|GroundDetection")
-	float GroundTraceDistance; // How far down to trace for ground
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|GroundDetection")
-	float GroundDetectionRadius; // Radius for ground detection trace
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|GroundDetection")
-	TEnumAsByte<ECollisionChannel> GroundCollisionChannel; // Collision channel for ground trace
-
-	// Threshold for position difference before a client correction occurs (e.g., in cm)
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Networking")
-	float CorrectionThreshold;
-
-	// Gravity applied when airborne
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement")
-	float GravityScale;
-
-	// Visual Configuration
-
-	// Max angle of engine turn roll rotation
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement")
-	float AngleOfRoll;
+	// --- Vehicle Tuning ---
+	// Shared tuning asset, every pod of a class should point at the same one. Defaults are used when unset.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PodMovement")
+	TObjectPtr<UPodTuningDataAsset> TuningAsset;
+
+	const FPodVehicleTuning& GetTuning() const { return UPodTuningDataAsset::GetVehicleTuning(TuningAsset); }
+
+	// On-screen messages when the pitch traces miss (compiled out of shipping role ticks)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PodMovement|Debug")
+	bool bShowHoverTraceMessages;
 
 	UPROPERTY()
 	APodVehicle* OwningPodVehicle;
@@ -206,6 +133,41 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 protected:
+#if WITH_EDITORONLY_DATA
+	// Tuning saved per instance before TuningAsset, checked against the class default asset by PostLoad
+	UPROPERTY() float MaxSpeed_DEPRECATED = 15000.0f;
+	UPROPERTY() float Acceleration_DEPRECATED = 2000.0f;
+	UPROPERTY() float Deceleration_DEPRECATED = 3000.0f;
+	UPROPERTY() float LinearDamping_DEPRECATED = 0.05f;
+	UPROPERTY() float DragCoefficient_DEPRECATED = 10.0f;
+	UPROPERTY() float GravityScale_DEPRECATED = 980.0f;
+	UPROPERTY() float MaxTurnRate_DEPRECATED = 200.0f;
+	UPROPERTY() float TurnAcceleration_DEPRECATED = 1000.0f;
+	UPROPERTY() float AngularDamping_DEPRECATED = 10.0f;
+	UPROPERTY() float HighSpeedSteeringDampFactor_DEPRECATED = 0.3f;
+	UPROPERTY() float KeyboardSteeringInterpSpeed_DEPRECATED = 15.0f;
+	UPROPERTY() float KeyboardSteeringReturnSpeed_DEPRECATED = 30.0f;
+	UPROPERTY() float BoostAcceleration_DEPRECATED = 15000.0f;
+	UPROPERTY() float BoostMaxSpeedMultiplier_DEPRECATED = 1.8f;
+	UPROPERTY() float BrakeDeceleration_DEPRECATED = 20000.0f;
+	UPROPERTY() float DriftTurnSpeedMultiplier_DEPRECATED = 1.5f;
+	UPROPERTY() float DriftLinearDampingMultiplier_DEPRECATED = 0.05f;
+	UPROPERTY() float DriftAngularDampingMultiplier_DEPRECATED = 0.2f;
+	UPROPERTY() float DriftLateralSlideFactor_DEPRECATED = 0.9f;
+	UPROPERTY() float DriftMinSlideFactor_DEPRECATED = 0.3f;
+	UPROPERTY() float DriftMomentumDecayRate_DEPRECATED = 0.05f;
+	UPROPERTY() float DriftLateralContributionScale_DEPRECATED = 0.05f;
+	UPROPERTY() float DriftLateralMomentumMax_DEPRECATED = 5000.0f;
+	UPROPERTY() float AirControlTurnFactor_DEPRECATED = 0.4f;
+	UPROPERTY() float AirControlPitchFactor_DEPRECATED = 0.6f;
+	UPROPERTY() float AirControlRollFactor_DEPRECATED = 0.7f;
+	UPROPERTY() float GroundTraceDistance_DEPRECATED = 50.0f;
+	UPROPERTY() float GroundDetectionRadius_DEPRECATED = 60.0f;
+	UPROPERTY() float CorrectionThreshold_DEPRECATED = 10.0f;
+	UPROPERTY() float AngleOfRoll_DEPRECATED = 30.0f;
+	UPROPERTY() TEnumAsByte<ECollisionChannel> GroundCollisionChannel_DEPRECATED = ECC_Visibility;
+#endif
+
 	// A counter for unique move IDs for client prediction.
 	uint32 CurrentMoveID;
 
@@ -232,9 +194,21 @@ protected:
 	void ApplySteering(float DeltaTime, float InTurnInput, bool InDrifting, bool bGrounded, float EffectiveMaxSpeed, FRotator& OutRotation, float& OutAngularYawVelocity);
 
 	FVector GetGroundNormal(FHitResult& OutHit) const;
+	template<bool bDebug>
 	void AdjustVehiclePitch(float DeltaTime);
+	template<bool bDebug>
 	void HandleEngineHoveringVisuals(float InTurnRightInput, float DeltaTime);
 	
 	// Ground detection
 	bool IsGrounded() const;
+
+	// Role-specialized tick bound by RefreshRoleTick
+	using FRoleTickFunction = void (UPodVehicleMovementComponent::*)(float DeltaTime);
+	FRoleTickFunction RoleTick = nullptr;
+
+	template<EPodTickRole Role, bool bDebug>
+	void TickRole(float DeltaTime);
+
+	friend struct TPodRoleTickSelector<UPodVehicleMovementComponent>;
+	friend class FPodDeterminismHarness;
 };
\ No newline at end of file
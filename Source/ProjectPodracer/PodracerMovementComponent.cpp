@@ -4,7 +4,8 @@
 #include "GameFramework/Controller.h"
 #include "Engine/World.h"
 #include "Net/UnrealNetwork.h" // For DOREPLIFETIME
-#include "Kismet/KismetSystemLibrary.h" // For LineTrace
+#include "HoverSpringSolver.h"
+#include "PodGroundProbe.h"
 
 UPodracerMovementComponent::UPodracerMovementComponent()
 {
@@ -18,6 +19,7 @@ UPodracerMovementComponent::UPodracerMovementComponent()
     HoverStiffness = 10.0f;
     HoverDamping = 5.0f;
     MinGroundDistanceForFullHoverEffect = 50.f;
+    bUseImplicitHoverSpring = false;
 
     CurrentThrottleInput = 0.f;
     CurrentSteeringInput = 0.f;
@@ -90,12 +92,10 @@ void UPodracerMovementComponent::ApplyHover(float DeltaTime)
     FVector TraceEnd = ActorLocation - FVector(0, 0, 1) * (TargetHoverHeight + 200.0f); // Trace further
 
     FHitResult HitResult;
-    TArray<AActor*> ActorsToIgnore;
-    ActorsToIgnore.Add(PawnOwner);
+    FCollisionQueryParams QueryParams(PodQueryStats::Tag(EPodQueryClass::PodracerMovement));
+    QueryParams.AddIgnoredActor(PawnOwner);
 
-    bool bHit = UKismetSystemLibrary::LineTraceSingle(
-        GetWorld(), TraceStart, TraceEnd, UEngineTypes::ConvertToTraceType(ECC_Visibility),
-        false, ActorsToIgnore, EDrawDebugTrace::None, HitResult, true);
+    bool bHit = PodGroundProbe::LineTrace(GetWorld(), HitResult, TraceStart, TraceEnd, ECC_PodGround, QueryParams);
 
     FVector TargetUp = FVector::UpVector; // Default to world up if no ground
     float CurrentGroundDistance = TargetHoverHeight + 100.f; // Assume far if no hit
@@ -106,27 +106,41 @@ void UPodracerMovementComponent::ApplyHover(float DeltaTime)
         TargetUp = HitResult.ImpactNormal; // Align to ground normal
     }
     
-    // Calculate desired Z position (simplified, not physics force based)
-    float HeightError = TargetHoverHeight - CurrentGroundDistance;
-    float VerticalAdjustment = HeightError * HoverStiffness * DeltaTime;
-
-    // Apply damping to vertical movement to prevent bouncing
-    float VerticalVelocity = CurrentVelocity.Z; // Assuming Z is up for velocity component
-    VerticalAdjustment -= VerticalVelocity * HoverDamping * DeltaTime;
-    
-    // Limit hover effect close to ground
-    if (CurrentGroundDistance < MinGroundDistanceForFullHoverEffect)
+    if (bUseImplicitHoverSpring)
     {
-        VerticalAdjustment *= FMath::Clamp(CurrentGroundDistance / MinGroundDistanceForFullHoverEffect, 0.1f, 1.0f);
+        // Only velocity is changed, SimulateMovement then moves with the new velocity (semi-implicit position update)
+        float NewVerticalVelocity = FHoverSpringSolver::SolveRate(CurrentGroundDistance - TargetHoverHeight, CurrentVelocity.Z,
+            HoverStiffness, HoverDamping, DeltaTime);
+        float VelocityChange = NewVerticalVelocity - CurrentVelocity.Z;
+        if (CurrentGroundDistance < MinGroundDistanceForFullHoverEffect)
+        {
+            VelocityChange *= FMath::Clamp(CurrentGroundDistance / MinGroundDistanceForFullHoverEffect, 0.1f, 1.0f);
+        }
+        CurrentVelocity.Z += VelocityChange;
+    }
+    else
+    {
+        // Calculate desired Z position (simplified, not physics force based)
+        float HeightError = TargetHoverHeight - CurrentGroundDistance;
+        float VerticalAdjustment = HeightError * HoverStiffness * DeltaTime;
+
+        // Apply damping to vertical movement to prevent bouncing
+        float VerticalVelocity = CurrentVelocity.Z; // Assuming Z is up for velocity component
+        VerticalAdjustment -= VerticalVelocity * HoverDamping * DeltaTime;
+
+        // Limit hover effect close to ground
+        if (CurrentGroundDistance < MinGroundDistanceForFullHoverEffect)
+        {
+            VerticalAdjustment *= FMath::Clamp(CurrentGroundDistance / MinGroundDistanceForFullHoverEffect, 0.1f, 1.0f);
+        }
+
+        // Kinematically adjust position
+        FVector NewLocation = UpdatedComponent->GetComponentLocation();
+        NewLocation.Z += VerticalAdjustment; // Directly adjust Z based on hover calculation
+
+        // Adjust velocity based on hover (this makes it react more like a force)
+        CurrentVelocity.Z += VerticalAdjustment / DeltaTime; // Crude way to simulate force effect on velocity
     }
-
-
-    // Kinematically adjust position
-    FVector NewLocation = UpdatedComponent->GetComponentLocation();
-    NewLocation.Z += VerticalAdjustment; // Directly adjust Z based on hover calculation
-    
-    // Adjust velocity based on hover (this makes it react more like a force)
-    CurrentVelocity.Z += VerticalAdjustment / DeltaTime; // Crude way to simulate force effect on velocity
 
     // Align to surface (simple version)
     FRotator TargetRotation = FQuat::FindBetweenNormals(PawnOwner->GetActorUpVector(), TargetUp).Rotator();
@@ -55,6 +55,11 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Podracer Movement")
     float MinGroundDistanceForFullHoverEffect; // Distance below which hover has less/no effect
 
+    // Solve the hover spring implicitly (HoverStiffness in 1/s^2, HoverDamping in 1/s). Stable at any tick rate,
+    // the explicit update starts to oscillate once DeltaTime * HoverStiffness gets close to 1
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Podracer Movement")
+    bool bUseImplicitHoverSpring;
+
     // Call this from Pawn to provide input
     void SetThrottleInput(float InThrottle);
     void SetSteeringInput(float InSteering);
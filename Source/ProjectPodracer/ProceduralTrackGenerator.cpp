@@ -3,13 +3,361 @@
 #include "ProceduralTrackGenerator.h"
 #include "Components/SplineComponent.h"
 #include "ProceduralMeshComponent.h"
-#include "Kismet/KismetMathLibrary.h"
 #include "DestructibleBuildingActor.h" // You will need to create this class
+#include "PhysicsEngine/BodySetup.h"
+#include "PodTrackSurfaceSubsystem.h"
+#include "PodGroundProbe.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Tasks/Task.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/DamageEvents.h"
+#include "EngineUtils.h"
+#include "Net/UnrealNetwork.h"
+#include "Algo/BinarySearch.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "ProjectPodracerPlayerController.h"
+#include "Engine/Engine.h"
+#include "TimerManager.h"
+#include <atomic>
+
+static const FName NAME_PodGroundProxyProfile(TEXT("PodGroundProxy"));
+
+// Generated points are rounded to whole centimetres. FRandomStream is plain integer arithmetic, but the trig between
+// its draws may differ in the last bit on another platform, and rounding keeps that from reaching a client's track.
+static FVector QuantizeTrackLocation(const FVector& Location)
+{
+    return FVector(FMath::RoundToDouble(Location.X), FMath::RoundToDouble(Location.Y), FMath::RoundToDouble(Location.Z));
+}
+
+// Most rows one spline segment gets however hard it turns.
+static constexpr int32 MaxRowsPerSegment = 64;
+
+// Points along a segment its turning is measured between.
+static constexpr int32 SegmentTurnSteps = 4;
+
+// Each LOD halves the rows of the one before, so past this there's nothing left to drop.
+static constexpr int32 MaxTrackLODs = 6;
+
+// Generated before road LODs existed, with every segment at ten rows.
+static constexpr int32 FixedRowsPerSegment = 10;
+
+// Spacing of the arc-length table. Lerping between entries this close is well under a centimetre off the spline on
+// the tightest turns generation makes.
+static constexpr float ArcLengthTableStep = 100.0f;
+
+// Rows handed to each worker at a time. Evaluating one row is a few spline lookups, so small batches are all overhead.
+static constexpr int32 SurfaceSampleBatchSize = 64;
+
+// Spots tried around a building before giving up on finding another next to it (k in Bridson's Poisson-disk sampling).
+static constexpr int32 BuildingCandidatesPerPoint = 16;
+
+static int32 GParallelTrackMesh = 1;
+static FAutoConsoleVariableRef CVarParallelTrackMesh(
+    TEXT("Pod.Track.ParallelMesh"),
+    GParallelTrackMesh,
+    TEXT("Evaluate and triangulate generated track meshes on worker threads (0 = single thread)"));
+
+static bool IsGenerationCancelled(const std::atomic<bool>* bCancelled)
+{
+    return bCancelled && bCancelled->load(std::memory_order_relaxed);
+}
+
+static EParallelForFlags GetTrackMeshParallelForFlags()
+{
+    return GParallelTrackMesh ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+}
+
+static int32 GInstancedBuildings = 1;
+static FAutoConsoleVariableRef CVarInstancedBuildings(
+    TEXT("Pod.Track.InstancedBuildings"),
+    GInstancedBuildings,
+    TEXT("Place intact buildings as instances and only spawn a destructible actor for one once it is damaged (0 = an actor per building)"));
+
+static int32 GUseTrackCache = 1;
+static FAutoConsoleVariableRef CVarUseTrackCache(
+    TEXT("Pod.Track.Cache"),
+    GUseTrackCache,
+    TEXT("Read generated tracks back from Saved/TrackCache when the seed and settings match, and write new ones there (0 = always generate)"));
+
+// Bump whenever generation changes what a seed produces, so old files stop matching.
+static constexpr uint32 TrackCacheVersion = 8;
+static constexpr uint32 TrackCacheMagic = 0x4B525450; // "PTRK"
+
+// Everything a seed generates, as stored in the track cache.
+struct FTrackCacheData
+{
+    TArray<FVector> SplinePoints;
+    TArray<int32> ChunkFirstRows;
+    TArray<FTrackChunkBuffers> ChunkBuffers;
+    TArray<FTrackBuildingPlacement> Placements;
+};
+
+static FArchive& operator<<(FArchive& Ar, FTrackBuildingPlacement& Placement)
+{
+    return Ar << Placement.AssetIndex << Placement.Transform;
+}
+
+static void SerializeTrackCacheItem(FArchive& Ar, FTrackChunkLOD& LOD);
+static void SerializeTrackCacheItem(FArchive& Ar, FTrackChunkBuffers& Buffers);
+template <typename ElementType> static void SerializeTrackCacheItem(FArchive& Ar, TArray<ElementType>& Array);
+
+template <typename ItemType>
+static void SerializeTrackCacheItem(FArchive& Ar, ItemType& Item)
+{
+    Ar << Item;
+}
+
+// Laid out like TArray's own serialization, but a count read from a damaged file fails the read instead of allocating
+// whatever it says. Every element takes at least a byte, so no more can follow than there are bytes left.
+template <typename ElementType>
+static void SerializeTrackCacheItem(FArchive& Ar, TArray<ElementType>& Array)
+{
+    int32 Num = Array.Num();
+    Ar << Num;
+    if (Ar.IsLoading())
+    {
+        if (Ar.IsError() || Num < 0 || Num > Ar.TotalSize() - Ar.Tell())
+        {
+            Ar.SetError();
+            Array.Reset();
+            return;
+        }
+        Array.SetNum(Num);
+    }
+
+    for (ElementType& Element : Array)
+    {
+        SerializeTrackCacheItem(Ar, Element);
+        if (Ar.IsError())
+        {
+            return;
+        }
+    }
+}
+
+static void SerializeTrackCacheItem(FArchive& Ar, FTrackChunkLOD& LOD)
+{
+    SerializeTrackCacheItem(Ar, LOD.Vertices);
+    SerializeTrackCacheItem(Ar, LOD.Triangles);
+    SerializeTrackCacheItem(Ar, LOD.Normals);
+    SerializeTrackCacheItem(Ar, LOD.UVs);
+}
+
+static void SerializeTrackCacheItem(FArchive& Ar, FTrackChunkBuffers& Buffers)
+{
+    SerializeTrackCacheItem(Ar, Buffers.LODs);
+    SerializeTrackCacheItem(Ar, Buffers.CollisionSlabs);
+    Ar << Buffers.Hash;
+    Ar << Buffers.UVHash;
+}
+
+static void SerializeTrackCache(FArchive& Ar, FTrackCacheData& Data)
+{
+    SerializeTrackCacheItem(Ar, Data.SplinePoints);
+    SerializeTrackCacheItem(Ar, Data.ChunkFirstRows);
+    SerializeTrackCacheItem(Ar, Data.ChunkBuffers);
+    SerializeTrackCacheItem(Ar, Data.Placements);
+}
+
+// Two vertices across each of Rows, the road between them as a strip of quads.
+static void TriangulateTrackRows(const TArray<FTrackSurfaceSample>& Samples, TConstArrayView<int32> Rows, float TrackWidth, FTrackChunkLOD& Out)
+{
+    const int32 NumRows = Rows.Num();
+    Out.Vertices.SetNumUninitialized(NumRows * 2);
+    Out.Normals.SetNumUninitialized(NumRows * 2);
+    Out.UVs.SetNumUninitialized(NumRows * 2);
+    Out.Triangles.SetNumUninitialized((NumRows - 1) * 6);
+
+    for (int32 Row = 0; Row < NumRows; ++Row)
+    {
+        const FTrackSurfaceSample& Sample = Samples[Rows[Row]];
+        const int32 Left = Row * 2;
+        const int32 Right = Left + 1;
+
+        // Add vertices for the left and right side of the track segment.
+        Out.Vertices[Left] = Sample.Location - Sample.RightVector * TrackWidth / 2;
+        Out.Vertices[Right] = Sample.Location + Sample.RightVector * TrackWidth / 2;
+
+        // Add normals pointing up.
+        Out.Normals[Left] = Sample.UpVector;
+        Out.Normals[Right] = Sample.UpVector;
+
+        // Add UVs. U is along the whole track, so the texture runs on across chunks, V is across it.
+        Out.UVs[Left] = FVector2D(Sample.Distance / (TrackWidth * 2), 0);
+        Out.UVs[Right] = FVector2D(Sample.Distance / (TrackWidth * 2), 1);
+
+        // Two triangles join this row to the next one.
+        if (Row < NumRows - 1)
+        {
+            int32* Triangle = &Out.Triangles[Row * 6];
+            Triangle[0] = Left;
+            Triangle[1] = Left + 2;
+            Triangle[2] = Right;
+
+            Triangle[3] = Right;
+            Triangle[4] = Left + 2;
+            Triangle[5] = Right + 2;
+        }
+    }
+}
+
+// Convex slabs under Samples[FirstRow .. LastRow], RowsPerSlab rows each. Neighbouring slabs share their end row so there
+// is no gap between them.
+static void BuildTrackSlabs(const TArray<FTrackSurfaceSample>& Samples, int32 FirstRow, int32 LastRow, int32 RowsPerSlab, float TrackWidth, float Thickness, TArray<TArray<FVector>>& OutSlabs)
+{
+    RowsPerSlab = FMath::Max(RowsPerSlab, 2);
+    for (int32 First = FirstRow; First < LastRow; First += RowsPerSlab - 1)
+    {
+        const int32 Last = FMath::Min(First + RowsPerSlab - 1, LastRow);
+        TArray<FVector>& Slab = OutSlabs.AddDefaulted_GetRef();
+        Slab.Reserve((Last - First + 1) * 4);
+        for (int32 Row = First; Row <= Last; ++Row)
+        {
+            // Road edges and their undersides.
+            const FTrackSurfaceSample& Sample = Samples[Row];
+            const FVector Left = Sample.Location - Sample.RightVector * TrackWidth / 2;
+            const FVector Right = Sample.Location + Sample.RightVector * TrackWidth / 2;
+            Slab.Add(Left);
+            Slab.Add(Right);
+            Slab.Add(Left - Sample.UpVector * Thickness);
+            Slab.Add(Right - Sample.UpVector * Thickness);
+        }
+    }
+}
+
+static uint32 HashBuildingPlacement(const FTrackBuildingPlacement& Placement, uint32 Crc)
+{
+    const FVector Location = QuantizeTrackLocation(Placement.Transform.GetLocation());
+    Crc = FCrc::MemCrc32(&Placement.AssetIndex, sizeof(Placement.AssetIndex), Crc);
+    return FCrc::MemCrc32(&Location, sizeof(Location), Crc);
+}
+
+static FString GetTrackCacheFilename(uint64 Key)
+{
+    return FPaths::ProjectSavedDir() / TEXT("TrackCache") / FString::Printf(TEXT("%016llX.track"), Key);
+}
+
+// Maps the file and deserializes the track out of the mapping into OutData's own arrays. Fails on a missing, stale or
+// damaged file.
+static bool LoadTrackCache(uint64 Key, FTrackCacheData& OutData)
+{
+    if (!GUseTrackCache)
+    {
+        return false;
+    }
+
+    TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*GetTrackCacheFilename(Key)));
+    if (!MappedFile)
+    {
+        return false;
+    }
+    TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+    if (!Region)
+    {
+        return false;
+    }
+
+    FMemoryReaderView Reader(MakeArrayView(Region->GetMappedPtr(), Region->GetMappedSize()));
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    uint64 FileKey = 0;
+    Reader << Magic << Version << FileKey;
+    if (Magic != TrackCacheMagic || Version != TrackCacheVersion || FileKey != Key)
+    {
+        return false;
+    }
+
+    SerializeTrackCache(Reader, OutData);
+    return !Reader.IsError() && OutData.SplinePoints.Num() >= 2;
+}
+
+static void SaveTrackCache(uint64 Key, FTrackCacheData& Data)
+{
+    if (!GUseTrackCache)
+    {
+        return;
+    }
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    uint32 Magic = TrackCacheMagic;
+    uint32 Version = TrackCacheVersion;
+    Writer << Magic << Version << Key;
+    SerializeTrackCache(Writer, Data);
+
+    // Another run may have the old file mapped, and truncating it under the mapping would fault the reader. The new one
+    // is written next to it and moved over it, which leaves a mapped file's contents alone (or fails, and it stays).
+    const FString Filename = GetTrackCacheFilename(Key);
+    const FString TempFilename = FPaths::CreateTempFilename(*FPaths::GetPath(Filename), TEXT("TrackCache"), TEXT(".tmp"));
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempFilename) || !IFileManager::Get().Move(*Filename, *TempFilename, true, false, false, true))
+    {
+        IFileManager::Get().Delete(*TempFilename, false, false, true);
+        UE_LOG(LogTemp, Warning, TEXT("Couldn't write track cache %s"), *Filename);
+    }
+}
+
+enum class ETrackGenerationStage : uint8
+{
+    // Worker: control points
+    SplinePoints,
+    // Worker: surface samples, chunk buffers and building placements
+    Buffers,
+    // Game thread: mesh sections and collision, a few chunks per frame
+    Commit,
+    // Game thread: buildings, a few per frame
+    Buildings
+};
+
+// One GenerateAsync run. Workers fill in the stage results, the game thread applies them between stages.
+struct FTrackGenerationJob
+{
+    ETrackGenerationStage Stage = ETrackGenerationStage::SplinePoints;
+    UE::Tasks::FTask WorkerTask;
+    std::atomic<bool> bCancelled{ false };
+
+    FTrackBuildSettings Settings;
+    FRandomStream Stream;
+    FVector StartLocation = FVector::ZeroVector;
+    uint64 CacheKey = 0;
+    bool bUseCache = true;
+    bool bFromCache = false;
+
+    FTrackCacheData Track;
+    int32 NextChunk = 0;
+    int32 NextPlacement = 0;
+};
+
+// Share of the run done when each stage starts, and how much it covers.
+static float GetStageProgress(ETrackGenerationStage Stage, float StageFraction)
+{
+    static const float StageStart[] = { 0.0f, 0.1f, 0.4f, 0.8f, 1.0f };
+    const int32 Index = static_cast<int32>(Stage);
+    return FMath::Lerp(StageStart[Index], StageStart[Index + 1], StageFraction);
+}
 
 AProceduralTrackGenerator::AProceduralTrackGenerator()
 {
-    // The actor can't tick, but it can run construction scripts in the editor.
-    PrimaryActorTick.bCanEverTick = false;
+    // Ticks only to pick road LODs, and not often. It can also run construction scripts in the editor.
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
+    PrimaryActorTick.TickInterval = 0.1f;
+
+    // Only the seed, settings and checksum replicate, and they rarely change.
+    bReplicates = true;
+    bAlwaysRelevant = true;
+    SetNetUpdateFrequency(1.0f);
 
     // Create the Spline Component and set it as the root.
     TrackSpline = CreateDefaultSubobject<USplineComponent>(TEXT("TrackSpline"));
@@ -18,190 +366,2103 @@ AProceduralTrackGenerator::AProceduralTrackGenerator()
     // Create the Procedural Mesh Component.
     TrackMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("TrackMesh"));
     TrackMesh->SetupAttachment(RootComponent);
+    // Chunks cook their collision on a worker and swap it in when done, instead of stalling the game thread for it.
+    TrackMesh->bUseAsyncCooking = true;
+
+    // Only the convex slabs collide, and only with hover probes.
+    GroundProxyMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("GroundProxyMesh"));
+    GroundProxyMesh->SetupAttachment(RootComponent);
+    GroundProxyMesh->SetCollisionProfileName(NAME_PodGroundProxyProfile);
+    GroundProxyMesh->bUseComplexAsSimpleCollision = false;
+    GroundProxyMesh->bUseAsyncCooking = true;
+    GroundProxyMesh->SetVisibility(false);
+    GroundProxyMesh->SetHiddenInGame(true);
+    GroundProxyMesh->SetCastShadow(false);
+    GroundProxyMesh->SetCanEverAffectNavigation(false);
 }
 
 void AProceduralTrackGenerator::BeginPlay()
 {
     Super::BeginPlay();
-}
 
-// This function is called whenever the actor is moved or a property is changed in the editor.
-void AProceduralTrackGenerator::OnConstruction(const FTransform& Transform)
-{
-    Super::OnConstruction(Transform);
-    // You could optionally call Generate() here for a live preview,
-    // but it can be slow with many buildings. A button is often better.
-}
+    // Neither the table nor the building hash is saved with the level.
+    BakeArcLengthTable();
+    RebuildBuildingHash();
 
-void AProceduralTrackGenerator::Generate()
-{
-    // First, clear any previously generated content.
-    ClearAll();
+    // Tracks saved before the road was split into chunks rebuild it on load.
+    if (TrackMesh->GetNumSections() > 0)
+    {
+        GenerateTrackMesh();
+    }
 
-    // Create a random stream from the seed. This ensures the same seed always produces the same track.
-    FRandomStream RandomStream(GenerationSeed);
+    // Tracks generated before the ground proxy existed get their slabs on load.
+    if (TrackChunks.Num() > 0 && GroundProxyMesh->GetBodySetup()->AggGeom.ConvexElems.Num() == 0)
+    {
+        GenerateGroundProxy();
+    }
 
-    // Generate the core path of the track.
-    GenerateSplinePoints(RandomStream);
+    // The spline is saved with the level, so pods can query the road analytically from the first tick.
+    UpdateSurfaceRegistration();
 
-    // Build the visible track geometry based on the new spline.
-    GenerateTrackMesh();
+    if (HasAuthority())
+    {
+        // Covers tracks saved before the checksum existed, or edited by hand since.
+        UpdateTrackChecksum();
+        FillDestructiblePool();
+    }
 
-    // Place destructible buildings alongside the track.
-    PlaceBuildings(RandomStream);
+    SetActorTickEnabled(GetNetMode() != NM_DedicatedServer && TrackLODScreenSizes.Num() > 1);
 }
 
-void AProceduralTrackGenerator::ClearAll()
+void AProceduralTrackGenerator::Tick(float DeltaTime)
 {
-    // Clear the procedural mesh data.
-    TrackMesh->ClearAllMeshSections();
+    Super::Tick(DeltaTime);
 
-    // Destroy all previously spawned building actors.
-    for (AActor* Building : SpawnedBuildingActors)
+    UpdateTrackLODs();
+}
+
+void AProceduralTrackGenerator::UpdateTrackLODs()
+{
+    // Each chunk's LOD comes from the view it is largest in.
+    TArray<FVector, TInlineAllocator<4>> ViewOrigins;
+    TArray<double, TInlineAllocator<4>> ScreenMultiples;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
     {
-        if (Building)
+        const APlayerController* PlayerController = It->Get();
+        if (PlayerController && PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
         {
-            Building->Destroy();
+            const double HalfFOV = FMath::DegreesToRadians(PlayerController->PlayerCameraManager->GetFOVAngle() * 0.5);
+            ViewOrigins.Add(PlayerController->PlayerCameraManager->GetCameraLocation());
+            ScreenMultiples.Add(1.0 / FMath::Max(FMath::Tan(HalfFOV), UE_KINDA_SMALL_NUMBER));
         }
     }
-    SpawnedBuildingActors.Empty();
+    if (ViewOrigins.Num() == 0)
+    {
+        return;
+    }
 
-    // Clear the spline points, leaving just the default start and end.
-    TrackSpline->ClearSplinePoints(true);
+    TrackChunkLODs.SetNumZeroed(TrackChunks.Num());
+    const int32 NumLODs = FMath::Clamp(TrackLODScreenSizes.Num(), 1, MaxTrackLODs);
+    for (int32 Chunk = 0; Chunk < TrackChunks.Num(); ++Chunk)
+    {
+        UProceduralMeshComponent* Component = TrackChunks[Chunk];
+        if (!Component)
+        {
+            continue;
+        }
+
+        // Bounds sphere against view distance, the measure static mesh LOD screen sizes use.
+        double ScreenSize = 0.0;
+        for (int32 View = 0; View < ViewOrigins.Num(); ++View)
+        {
+            const double Distance = FMath::Max(FVector::Dist(Component->Bounds.Origin, ViewOrigins[View]), 1.0);
+            ScreenSize = FMath::Max(ScreenSize, ScreenMultiples[View] * Component->Bounds.SphereRadius / Distance);
+        }
+
+        int32 LOD = NumLODs - 1;
+        while (LOD > 0 && ScreenSize >= TrackLODScreenSizes[LOD])
+        {
+            --LOD;
+        }
+        LOD = FMath::Min(LOD, Component->GetNumSections() - 1);
+
+        if (LOD >= 0 && LOD != TrackChunkLODs[Chunk])
+        {
+            Component->SetMeshSectionVisible(TrackChunkLODs[Chunk], false);
+            Component->SetMeshSectionVisible(LOD, true);
+            TrackChunkLODs[Chunk] = LOD;
+        }
+    }
 }
 
-void AProceduralTrackGenerator::GenerateSplinePoints(FRandomStream& Stream)
+void AProceduralTrackGenerator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
-    TrackSpline->ClearSplinePoints();
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    FVector CurrentLocation = GetActorLocation();
-    FRotator CurrentRotation = FRotator::ZeroRotator;
+    // Everything generation reads, and the checksum whose OnRep generates from it. Rep notifies run once the whole
+    // bunch is applied, so the settings are in place by then.
+    DOREPLIFETIME(AProceduralTrackGenerator, GenerationSeed);
+    DOREPLIFETIME(AProceduralTrackGenerator, NumberOfControlPoints);
+    DOREPLIFETIME(AProceduralTrackGenerator, MaxPointDistance);
+    DOREPLIFETIME(AProceduralTrackGenerator, MinPointDistance);
+    DOREPLIFETIME(AProceduralTrackGenerator, TrackWidth);
+    DOREPLIFETIME(AProceduralTrackGenerator, TrackChunkLength);
+    DOREPLIFETIME(AProceduralTrackGenerator, TrackRowAngle);
+    DOREPLIFETIME(AProceduralTrackGenerator, TrackLODScreenSizes);
+    DOREPLIFETIME(AProceduralTrackGenerator, ShoulderWidth);
+    DOREPLIFETIME(AProceduralTrackGenerator, MaxYawChange);
+    DOREPLIFETIME(AProceduralTrackGenerator, MaxPitchChange);
+    DOREPLIFETIME(AProceduralTrackGenerator, MaxRollChange);
+    DOREPLIFETIME(AProceduralTrackGenerator, MaxZOffsetOnNextPoint);
+    DOREPLIFETIME(AProceduralTrackGenerator, TrackMaterial);
+    DOREPLIFETIME(AProceduralTrackGenerator, GroundProxySamplesPerSlab);
+    DOREPLIFETIME(AProceduralTrackGenerator, GroundProxyThickness);
+    DOREPLIFETIME(AProceduralTrackGenerator, bSimpleTrackCollision);
+    DOREPLIFETIME(AProceduralTrackGenerator, TrackCollisionRowsPerSlab);
+    DOREPLIFETIME(AProceduralTrackGenerator, TrackCollisionThickness);
+    DOREPLIFETIME(AProceduralTrackGenerator, BuildingAssets);
+    DOREPLIFETIME(AProceduralTrackGenerator, BuildingSpacing);
+    DOREPLIFETIME(AProceduralTrackGenerator, BuildingSideOffsetMin);
+    DOREPLIFETIME(AProceduralTrackGenerator, BuildingSideOffsetMax);
+    DOREPLIFETIME(AProceduralTrackGenerator, TrackChecksum);
+}
 
-    // TODO: Add rotational and zaxis constraints based on adjustable properties
+void AProceduralTrackGenerator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    CancelGeneration();
 
-    for (int32 i = 0; i < NumberOfControlPoints; ++i)
+    if (UPodTrackSurfaceSubsystem* TrackSurfaces = UPodTrackSurfaceSubsystem::Get(GetWorld()))
     {
-        // Add a new point at the current location.
-        TrackSpline->AddSplinePoint(CurrentLocation, ESplineCoordinateSpace::World, false);
+        TrackSurfaces->UnregisterTrack(this);
+    }
+    PodGroundProbe::UnregisterGroundProxyOwner(this);
 
-        // Determine the next location.
-        const float Distance = Stream.FRandRange(MinPointDistance, MaxPointDistance);
-        
-        // Add some random rotation for variety in turns.
-        const float YawChange = Stream.FRandRange(-MaxYawChange, MaxYawChange);
-        const float PitchChange = Stream.FRandRange(-MaxPitchChange, MaxPitchChange);
-        const float RollChange = Stream.FRandRange(-MaxRollChange, MaxRollChange);
-        CurrentRotation += FRotator(PitchChange, YawChange, RollChange);
-        
-        // Move forward to the next point's location.
-        FVector NextLocation = CurrentLocation + CurrentRotation.Vector() * Distance;
-        float NextZDifference = NextLocation.Z - CurrentLocation.Z;
-        if (FMath::Abs(NextZDifference) > MaxZOffsetOnNextPoint)
-        {
-            NextLocation.Z += (NextZDifference * -1);
-            CurrentLocation = NextLocation;
-        } else
-        {
-            CurrentLocation += CurrentRotation.Vector() * Distance;
-        }
-        // TODO: Should try to always tend back to the original Z axis level
+    Super::EndPlay(EndPlayReason);
+}
+
+// This function is called whenever the actor is moved or a property is changed in the editor.
+void AProceduralTrackGenerator::OnConstruction(const FTransform& Transform)
+{
+    Super::OnConstruction(Transform);
+
+    // Workers of an async run may be reading the table.
+    if (!IsGenerating())
+    {
+        BakeArcLengthTable();
     }
+    // You could optionally call Generate() here for a live preview,
+    // but it can be slow with many buildings. A button is often better.
+}
 
-    // Close the loop to make it a continuous circuit.
-    TrackSpline->SetClosedLoop(true, true);
+void AProceduralTrackGenerator::BeginDestroy()
+{
+    // Workers may still be reading the spline.
+    StopGeneration();
 
-    // Update the spline to finalize the shape.
-    TrackSpline->UpdateSpline();
+    Super::BeginDestroy();
 }
 
-void AProceduralTrackGenerator::GenerateTrackMesh()
+void AProceduralTrackGenerator::Generate()
 {
-    TrackMesh->ClearAllMeshSections();
-    if (TrackSpline->GetNumberOfSplinePoints() < 2) return;
+    CancelGeneration();
 
-    TArray<FVector> Vertices;
-    TArray<int32> Triangles;
-    TArray<FVector> Normals;
-    TArray<FVector2D> UVs;
-    TArray<FProcMeshTangent> Tangents; // Not used in this basic example, but good practice.
-    TArray<FColor> VertexColors;      // Not used in this basic example.
+    // First, clear the previous buildings. The road chunks are kept, so any that come out the same aren't recooked.
+    ClearBuildings();
+
+    // A track generated before from the same seed and settings is read back instead.
+    const uint64 CacheKey = ComputeTrackCacheKey();
+    FTrackCacheData Track;
+    if (LoadTrackCache(CacheKey, Track))
+    {
+        ApplySplinePoints(Track.SplinePoints);
+    }
+    else
+    {
+        // Create a random stream from the seed. This ensures the same seed always produces the same track.
+        FRandomStream RandomStream(GenerationSeed);
+
+        // Generate the core path of the track.
+        const FTrackBuildSettings Settings = CaptureBuildSettings();
+        ComputeSplinePoints(Settings, RandomStream, GetActorLocation(), Track.SplinePoints);
+        ApplySplinePoints(Track.SplinePoints);
 
-    const int32 NumSegments = TrackSpline->GetNumberOfSplinePoints();
-    const float DistanceStep = TrackSpline->GetSplineLength() / (NumSegments * 10); // Increase density for smoother curves
+        // Build the visible track geometry and lay out the buildings based on the new spline.
+        BuildTrackChunks(Settings, Track.ChunkBuffers, Track.ChunkFirstRows);
+        ComputeBuildingPlacements(Settings, RandomStream, Track.Placements);
+
+        SaveTrackCache(CacheKey, Track);
+    }
 
-    for (float Distance = 0; Distance <= TrackSpline->GetSplineLength(); Distance += DistanceStep)
+    ResizeTrackChunks(Track.ChunkFirstRows);
+    for (int32 Chunk = 0; Chunk < Track.ChunkBuffers.Num(); ++Chunk)
     {
-        const FVector Location = TrackSpline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local);
-        const FVector Direction = TrackSpline->GetDirectionAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local);
-        const FVector UpVector = TrackSpline->GetUpVectorAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local);
-        
-        const FVector RightVector = FVector::CrossProduct(Direction, UpVector).GetSafeNormal();
+        CommitTrackChunk(Chunk, Track.ChunkBuffers[Chunk]);
+    }
+    GenerateGroundProxy();
 
-        // Add vertices for the left and right side of the track segment.
-        Vertices.Add(Location - RightVector * TrackWidth / 2); // Left Vertex
-        Vertices.Add(Location + RightVector * TrackWidth / 2); // Right Vertex
+    // Place destructible buildings alongside the track.
+    PlaceBuildings(Track.Placements);
 
-        // Add normals pointing up.
-        Normals.Add(UpVector);
-        Normals.Add(UpVector);
+    UpdateSurfaceRegistration();
+    UpdateTrackChecksum();
+}
+
+uint64 AProceduralTrackGenerator::ComputeTrackCacheKey() const
+{
+    // The spline starts at the actor, and every editable setting declared here can change what gets generated.
+    FString Settings = FString::Printf(TEXT("%u|%s|"), TrackCacheVersion, *GetActorTransform().ToString());
+    for (TFieldIterator<FProperty> It(AProceduralTrackGenerator::StaticClass(), EFieldIterationFlags::None); It; ++It)
+    {
+        const FProperty* Property = *It;
+        if (!Property->HasAnyPropertyFlags(CPF_Edit) || Property->HasAnyPropertyFlags(CPF_EditConst))
+        {
+            continue;
+        }
 
-        // Add UVs. U is along the track, V is across it.
-        UVs.Add(FVector2D(Distance / (TrackWidth * 2), 0));
-        UVs.Add(FVector2D(Distance / (TrackWidth * 2), 1));
+        FString Value;
+        Property->ExportTextItem_InContainer(Value, this, nullptr, nullptr, PPF_None);
+        Settings += FString::Printf(TEXT("%s=%s|"), *Property->GetName(), *Value);
     }
 
-    // Create triangles connecting the vertices.
-    for (int32 i = 0; i < Vertices.Num() - 3; i += 2)
+    return CityHash64(reinterpret_cast<const char*>(*Settings), Settings.Len() * sizeof(TCHAR));
+}
+
+uint32 AProceduralTrackGenerator::ComputeTrackChecksum() const
+{
+    const int32 NumPoints = TrackSpline->GetNumberOfSplinePoints();
+    if (NumPoints == 0)
     {
-        Triangles.Add(i);
-        Triangles.Add(i + 2);
-        Triangles.Add(i + 1);
+        return 0;
+    }
 
-        Triangles.Add(i + 1);
-        Triangles.Add(i + 2);
-        Triangles.Add(i + 3);
+    // The control points and placements pin down everything else generation builds from them.
+    uint32 Checksum = BuildingChecksum;
+    for (int32 Point = 0; Point < NumPoints; ++Point)
+    {
+        const FVector Location = QuantizeTrackLocation(TrackSpline->GetLocationAtSplinePoint(Point, ESplineCoordinateSpace::World));
+        Checksum = FCrc::MemCrc32(&Location, sizeof(Location), Checksum);
     }
-    
-    // Create the mesh section.
-    TrackMesh->CreateMeshSection(0, Vertices, Triangles, Normals, UVs, VertexColors, Tangents, true);
-    TrackMesh->SetMaterial(0, TrackMaterial);
+    return FMath::Max(Checksum, 1u);
 }
 
-void AProceduralTrackGenerator::PlaceBuildings(FRandomStream& Stream)
+void AProceduralTrackGenerator::UpdateTrackChecksum()
 {
-    if (BuildingAssets.Num() == 0) return;
+    const uint32 Checksum = ComputeTrackChecksum();
+    if (HasAuthority())
+    {
+        TrackChecksum = Checksum;
+        return;
+    }
 
-    for (float Distance = 0; Distance < TrackSpline->GetSplineLength(); Distance += BuildingSpacing)
+    if (Checksum == TrackChecksum)
     {
-        // Get the transform at the current distance along the spline.
-        const FTransform SplineTransform = TrackSpline->GetTransformAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
-        const FVector RightVector = SplineTransform.GetUnitAxis(EAxis::Y);
+        bRegeneratedForChecksum = false;
+        return;
+    }
 
-        // Randomly decide to place on the left or right.
-        const float Side = UKismetMathLibrary::RandomBoolFromStream(Stream) ? 1.0f : -1.0f;
-        const float Offset = Stream.FRandRange(BuildingSideOffsetMin, BuildingSideOffsetMax);
+    // Once from the replicated seed and settings, past the track cache in case that is what's wrong. Next tick, as this
+    // can run from the end of an async run.
+    if (!bRegeneratedForChecksum)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: generated track checksum %08X doesn't match the server's %08X, regenerating from seed %d"),
+            *GetName(), Checksum, TrackChecksum, GenerationSeed);
+        bRegeneratedForChecksum = true;
+        GetWorldTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &AProceduralTrackGenerator::StartGeneration, false));
+        return;
+    }
 
-        // Calculate the final spawn location for the building.
-        const FVector SpawnLocation = SplineTransform.GetLocation() + (RightVector * (TrackWidth / 2 + Offset) * Side);
-        
-        // Choose a random building from the asset array.
-        const int32 BuildingIndex = Stream.RandRange(0, BuildingAssets.Num() - 1);
-        FDestructibleBuildingAsset& Asset = BuildingAssets[BuildingIndex];
+    // Still different: this client races on another track than everyone else.
+    UE_LOG(LogTemp, Error, TEXT("%s: regenerated track checksum %08X still doesn't match the server's %08X"), *GetName(), Checksum, TrackChecksum);
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 30.0f, FColor::Red,
+            FString::Printf(TEXT("Track %s doesn't match the server's, collisions and positions will be off"), *GetName()));
+    }
+    if (AProjectPodracerPlayerController* PlayerController = Cast<AProjectPodracerPlayerController>(GetWorld()->GetFirstPlayerController()))
+    {
+        PlayerController->ServerReportTrackMismatch(this, Checksum);
+    }
+}
 
-        if (Asset.DestructibleActorClass)
-        {
-            // Spawn the destructible actor blueprint.
-            FTransform SpawnTransform(SplineTransform.GetRotation(), SpawnLocation);
-            
-            // Add some random yaw rotation for variety.
-            SpawnTransform.SetRotation(FQuat(FRotator(0, Stream.FRandRange(0, 360), 0)));
+void AProceduralTrackGenerator::OnRep_TrackChecksum()
+{
+    // A new track on the server gets its own retry.
+    bRegeneratedForChecksum = false;
 
-            ADestructibleBuildingActor* NewBuilding = GetWorld()->SpawnActor<ADestructibleBuildingActor>(Asset.DestructibleActorClass, SpawnTransform);
-            if (NewBuilding)
-            {
-                // Store the reference so we can clean it up later.
-                SpawnedBuildingActors.Add(NewBuilding);
-            }
+    // A track saved with the level usually matches already. Anything else is generated here from the replicated
+    // seed and settings, over a few frames so joining doesn't hitch.
+    if (TrackChecksum == 0)
+    {
+        if (TrackSpline->GetNumberOfSplinePoints() > 0)
+        {
+            ClearAll();
         }
     }
+    else if (ComputeTrackChecksum() != TrackChecksum)
+    {
+        GenerateAsync();
+    }
 }
+
+void AProceduralTrackGenerator::ClearAll()
+{
+    CancelGeneration();
+
+    // Clear the procedural mesh data.
+    TrackMesh->ClearAllMeshSections();
+    DestroyTrackChunks();
+    GroundProxyMesh->ClearCollisionConvexMeshes();
+
+    ClearBuildings();
+    DestroyBuildingInstances();
+
+    // Clear the spline points, leaving just the default start and end.
+    TrackSpline->ClearSplinePoints(true);
+
+    UpdateSurfaceRegistration();
+
+    if (HasAuthority())
+    {
+        TrackChecksum = 0;
+    }
+}
+
+void AProceduralTrackGenerator::RebuildTrackMesh()
+{
+    CancelGeneration();
+
+    TrackSpline->UpdateSpline();
+    BakeArcLengthTable();
+
+    GenerateTrackMesh();
+    GenerateGroundProxy();
+
+    UpdateSurfaceRegistration();
+    UpdateTrackChecksum();
+}
+
+void AProceduralTrackGenerator::GenerateAsync()
+{
+    StartGeneration(true);
+}
+
+void AProceduralTrackGenerator::StartGeneration(bool bUseCache)
+{
+    CancelGeneration();
+    ClearBuildings();
+
+    // Workers only read the copy, so replicated or edited settings can't change under them.
+    TSharedRef<FTrackGenerationJob> Job = MakeShared<FTrackGenerationJob>();
+    Job->Settings = CaptureBuildSettings();
+    Job->Stream = FRandomStream(GenerationSeed);
+    Job->StartLocation = GetActorLocation();
+    Job->CacheKey = ComputeTrackCacheKey();
+    Job->bUseCache = bUseCache;
+    GenerationJob = Job;
+    SetGenerationProgress(0.0f);
+
+    // Workers get the raw job, StopGeneration waits for them before it lets the job go.
+    FTrackGenerationJob* JobPtr = &Job.Get();
+    Job->WorkerTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, JobPtr]()
+    {
+        // A cached track comes with everything the later stages would build.
+        JobPtr->bFromCache = JobPtr->bUseCache && LoadTrackCache(JobPtr->CacheKey, JobPtr->Track);
+        if (!JobPtr->bFromCache)
+        {
+            ComputeSplinePoints(JobPtr->Settings, JobPtr->Stream, JobPtr->StartLocation, JobPtr->Track.SplinePoints);
+        }
+    });
+
+    GenerationTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &AProceduralTrackGenerator::TickGeneration));
+}
+
+void AProceduralTrackGenerator::CancelGeneration()
+{
+    if (StopGeneration())
+    {
+        OnGenerationFinished.Broadcast(false);
+    }
+}
+
+bool AProceduralTrackGenerator::StopGeneration()
+{
+    if (!GenerationJob.IsValid())
+    {
+        return false;
+    }
+
+    GenerationJob->bCancelled = true;
+    GenerationJob->WorkerTask.Wait();
+    GenerationJob.Reset();
+
+    FTSTicker::GetCoreTicker().RemoveTicker(GenerationTickerHandle);
+    GenerationTickerHandle.Reset();
+    return true;
+}
+
+void AProceduralTrackGenerator::SetGenerationProgress(float Progress)
+{
+    GenerationProgress = Progress;
+    OnGenerationProgress.Broadcast(Progress);
+}
+
+bool AProceduralTrackGenerator::TickGeneration(float DeltaTime)
+{
+    if (!GenerationJob.IsValid())
+    {
+        return false;
+    }
+
+    FTrackGenerationJob& Job = *GenerationJob;
+    if (!Job.WorkerTask.IsCompleted())
+    {
+        return true;
+    }
+
+    const double EndTime = FPlatformTime::Seconds() + AsyncGenerationBudgetMs / 1000.0;
+    switch (Job.Stage)
+    {
+    case ETrackGenerationStage::SplinePoints:
+    {
+        // The old road table no longer matches the spline, pods trace the scene until the new one is registered.
+        if (UPodTrackSurfaceSubsystem* TrackSurfaces = UPodTrackSurfaceSubsystem::Get(GetWorld()))
+        {
+            TrackSurfaces->UnregisterTrack(this);
+        }
+        ApplySplinePoints(Job.Track.SplinePoints);
+        Job.Stage = ETrackGenerationStage::Buffers;
+        SetGenerationProgress(GetStageProgress(Job.Stage, 0.0f));
+        if (Job.bFromCache)
+        {
+            return true;
+        }
+
+        // Nothing writes the spline again until this run ends, so the workers can read it.
+        FTrackGenerationJob* JobPtr = &Job;
+        Job.WorkerTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, JobPtr]()
+        {
+            // Both stop early when cancelled, and an unfinished track mustn't go in the cache.
+            BuildTrackChunks(JobPtr->Settings, JobPtr->Track.ChunkBuffers, JobPtr->Track.ChunkFirstRows, &JobPtr->bCancelled);
+            if (!JobPtr->bCancelled)
+            {
+                ComputeBuildingPlacements(JobPtr->Settings, JobPtr->Stream, JobPtr->Track.Placements, &JobPtr->bCancelled);
+            }
+            if (!JobPtr->bCancelled)
+            {
+                SaveTrackCache(JobPtr->CacheKey, JobPtr->Track);
+            }
+        });
+        return true;
+    }
+
+    case ETrackGenerationStage::Buffers:
+        ResizeTrackChunks(Job.Track.ChunkFirstRows);
+        Job.Stage = ETrackGenerationStage::Commit;
+        break;
+
+    case ETrackGenerationStage::Commit:
+        // Unchanged chunks are nearly free, so keep going until the budget is spent.
+        while (Job.NextChunk < Job.Track.ChunkBuffers.Num())
+        {
+            CommitTrackChunk(Job.NextChunk, Job.Track.ChunkBuffers[Job.NextChunk]);
+            ++Job.NextChunk;
+            if (FPlatformTime::Seconds() >= EndTime)
+            {
+                break;
+            }
+        }
+
+        if (Job.NextChunk < Job.Track.ChunkBuffers.Num())
+        {
+            SetGenerationProgress(GetStageProgress(Job.Stage, float(Job.NextChunk) / Job.Track.ChunkBuffers.Num()));
+            return true;
+        }
+
+        GenerateGroundProxy();
+        UpdateSurfaceRegistration();
+        Job.Stage = ETrackGenerationStage::Buildings;
+        break;
+
+    case ETrackGenerationStage::Buildings:
+        while (Job.NextPlacement < Job.Track.Placements.Num())
+        {
+            // Instances go in as one batch, actors one at a time.
+            const int32 Count = GInstancedBuildings ? Job.Track.Placements.Num() - Job.NextPlacement : 1;
+            PlaceBuildings(MakeArrayView(Job.Track.Placements).Slice(Job.NextPlacement, Count));
+            Job.NextPlacement += Count;
+            if (FPlatformTime::Seconds() >= EndTime)
+            {
+                break;
+            }
+        }
+
+        if (Job.NextPlacement < Job.Track.Placements.Num())
+        {
+            SetGenerationProgress(GetStageProgress(Job.Stage, float(Job.NextPlacement) / Job.Track.Placements.Num()));
+            return true;
+        }
+
+        // Removes this ticker, so don't touch Job past here.
+        StopGeneration();
+        UpdateTrackChecksum();
+        SetGenerationProgress(1.0f);
+        OnGenerationFinished.Broadcast(true);
+        return false;
+    }
+
+    SetGenerationProgress(GetStageProgress(Job.Stage, 0.0f));
+    return true;
+}
+
+void AProceduralTrackGenerator::ClearBuildings()
+{
+    // Destroy all previously spawned building actors.
+    for (AActor* Building : SpawnedBuildingActors)
+    {
+        if (Building)
+        {
+            Building->Destroy();
+        }
+    }
+    SpawnedBuildingActors.Empty();
+    BuildingChecksum = 0;
+    PlacedBuildings.Reset();
+    BuildingHash.Reset(BuildingSpacing);
+
+    // Promoted buildings are put back together and wait in the pool for the next track.
+    for (ADestructibleBuildingActor* Building : PromotedBuildings)
+    {
+        if (Building)
+        {
+            Building->ResetToIntact();
+            Building->SetSource(nullptr, INDEX_NONE, INDEX_NONE);
+            Building->SetPooled(true);
+            PooledDestructibles.Add(Building);
+        }
+    }
+    PromotedBuildings.Empty();
+
+    for (UHierarchicalInstancedStaticMeshComponent* Instances : BuildingInstances)
+    {
+        if (Instances)
+        {
+            Instances->ClearInstances();
+        }
+    }
+}
+
+void AProceduralTrackGenerator::DestroyBuildingInstances()
+{
+    for (UHierarchicalInstancedStaticMeshComponent* Instances : BuildingInstances)
+    {
+        if (Instances)
+        {
+            Instances->DestroyComponent();
+        }
+    }
+    BuildingInstances.Empty();
+
+    for (ADestructibleBuildingActor* Building : PooledDestructibles)
+    {
+        if (Building)
+        {
+            Building->Destroy();
+        }
+    }
+    PooledDestructibles.Empty();
+    PendingHiddenInstances.Empty();
+}
+
+void AProceduralTrackGenerator::UpdateSurfaceRegistration()
+{
+    UPodTrackSurfaceSubsystem* TrackSurfaces = UPodTrackSurfaceSubsystem::Get(GetWorld());
+    if (!TrackSurfaces || !HasActorBegunPlay())
+    {
+        return;
+    }
+
+    // The ground proxy is built along with the chunks.
+    if (TrackSpline->GetNumberOfSplinePoints() >= 2 && TrackChunks.Num() > 0)
+    {
+        TrackSurfaces->RegisterTrack(this);
+        PodGroundProbe::RegisterGroundProxyOwner(this);
+    }
+    else
+    {
+        TrackSurfaces->UnregisterTrack(this);
+        PodGroundProbe::UnregisterGroundProxyOwner(this);
+    }
+}
+
+void AProceduralTrackGenerator::GenerateSplinePoints(FRandomStream& Stream)
+{
+    TArray<FVector> Points;
+    ComputeSplinePoints(CaptureBuildSettings(), Stream, GetActorLocation(), Points);
+    ApplySplinePoints(Points);
+}
+
+void AProceduralTrackGenerator::ComputeSplinePoints(const FTrackBuildSettings& Settings, FRandomStream& Stream, const FVector& StartLocation, TArray<FVector>& OutPoints) const
+{
+    OutPoints.Reset(Settings.NumberOfControlPoints);
+
+    FVector CurrentLocation = StartLocation;
+    FRotator CurrentRotation = FRotator::ZeroRotator;
+
+    // TODO: Add rotational and zaxis constraints based on adjustable properties
+
+    for (int32 i = 0; i < Settings.NumberOfControlPoints; ++i)
+    {
+        // Add a new point at the current location.
+        OutPoints.Add(QuantizeTrackLocation(CurrentLocation));
+
+        // Determine the next location.
+        const float Distance = Stream.FRandRange(Settings.MinPointDistance, Settings.MaxPointDistance);
+        
+        // Add some random rotation for variety in turns.
+        const float YawChange = Stream.FRandRange(-Settings.MaxYawChange, Settings.MaxYawChange);
+        const float PitchChange = Stream.FRandRange(-Settings.MaxPitchChange, Settings.MaxPitchChange);
+        const float RollChange = Stream.FRandRange(-Settings.MaxRollChange, Settings.MaxRollChange);
+        CurrentRotation += FRotator(PitchChange, YawChange, RollChange);
+        
+        // Move forward to the next point's location.
+        FVector NextLocation = CurrentLocation + CurrentRotation.Vector() * Distance;
+        float NextZDifference = NextLocation.Z - CurrentLocation.Z;
+        if (FMath::Abs(NextZDifference) > Settings.MaxZOffsetOnNextPoint)
+        {
+            NextLocation.Z += (NextZDifference * -1);
+            CurrentLocation = NextLocation;
+        } else
+        {
+            CurrentLocation += CurrentRotation.Vector() * Distance;
+        }
+        // TODO: Should try to always tend back to the original Z axis level
+    }
+}
+
+void AProceduralTrackGenerator::ApplySplinePoints(const TArray<FVector>& Points)
+{
+    TrackSpline->ClearSplinePoints();
+    for (const FVector& Point : Points)
+    {
+        TrackSpline->AddSplinePoint(Point, ESplineCoordinateSpace::World, false);
+    }
+
+    // Close the loop to make it a continuous circuit.
+    TrackSpline->SetClosedLoop(true, true);
+
+    // Update the spline to finalize the shape.
+    TrackSpline->UpdateSpline();
+    BakeArcLengthTable();
+}
+
+FTrackBuildSettings AProceduralTrackGenerator::CaptureBuildSettings() const
+{
+    FTrackBuildSettings Settings;
+    Settings.NumberOfControlPoints = NumberOfControlPoints;
+    Settings.MinPointDistance = MinPointDistance;
+    Settings.MaxPointDistance = MaxPointDistance;
+    Settings.MaxYawChange = MaxYawChange;
+    Settings.MaxPitchChange = MaxPitchChange;
+    Settings.MaxRollChange = MaxRollChange;
+    Settings.MaxZOffsetOnNextPoint = MaxZOffsetOnNextPoint;
+
+    Settings.TrackWidth = TrackWidth;
+    Settings.TrackChunkLength = TrackChunkLength;
+    Settings.TrackRowAngle = TrackRowAngle;
+    Settings.NumLODs = FMath::Clamp(TrackLODScreenSizes.Num(), 1, MaxTrackLODs);
+    Settings.bSimpleTrackCollision = bSimpleTrackCollision;
+    Settings.TrackCollisionRowsPerSlab = TrackCollisionRowsPerSlab;
+    Settings.TrackCollisionThickness = TrackCollisionThickness;
+
+    // Only types with a destructible actor can be placed.
+    for (int32 AssetIndex = 0; AssetIndex < BuildingAssets.Num(); ++AssetIndex)
+    {
+        if (BuildingAssets[AssetIndex].DestructibleActorClass)
+        {
+            Settings.PlaceableAssets.Add(AssetIndex);
+        }
+    }
+    Settings.BuildingSpacing = BuildingSpacing;
+    Settings.BuildingSideOffsetMin = BuildingSideOffsetMin;
+    Settings.BuildingSideOffsetMax = BuildingSideOffsetMax;
+    Settings.SplineTransform = TrackSpline->GetComponentTransform();
+    return Settings;
+}
+
+void AProceduralTrackGenerator::BakeArcLengthTable()
+{
+    ArcLengthTable.Build(*TrackSpline, ArcLengthTableStep, GetTrackMeshParallelForFlags());
+}
+
+const FTrackArcLengthTable& AProceduralTrackGenerator::GetCurrentArcLengthTable(FTrackArcLengthTable& Scratch) const
+{
+    if (ArcLengthTable.IsBuiltFrom(*TrackSpline))
+    {
+        return ArcLengthTable;
+    }
+
+    Scratch.Build(*TrackSpline, ArcLengthTableStep, GetTrackMeshParallelForFlags());
+    return Scratch;
+}
+
+FTransform AProceduralTrackGenerator::GetTrackTransformAtDistance(float Distance) const
+{
+    if (ArcLengthTable.IsEmpty())
+    {
+        return GetActorTransform();
+    }
+
+    FVector Location, Direction, UpVector;
+    ArcLengthTable.Sample(Distance, Location, Direction, UpVector);
+    return FTransform(FRotationMatrix::MakeFromXZ(Direction, UpVector).ToQuat(), Location) * TrackSpline->GetComponentTransform();
+}
+
+void AProceduralTrackGenerator::GenerateTrackMesh()
+{
+    TArray<FTrackChunkBuffers> Buffers;
+    TArray<int32> FirstRows;
+    BuildTrackChunks(CaptureBuildSettings(), Buffers, FirstRows);
+
+    ResizeTrackChunks(FirstRows);
+    for (int32 Chunk = 0; Chunk < Buffers.Num(); ++Chunk)
+    {
+        CommitTrackChunk(Chunk, Buffers[Chunk]);
+    }
+}
+
+void AProceduralTrackGenerator::BuildTrackChunks(const FTrackBuildSettings& Settings, TArray<FTrackChunkBuffers>& OutBuffers, TArray<int32>& OutFirstRows, const std::atomic<bool>* bCancelled) const
+{
+    OutBuffers.Reset();
+    OutFirstRows.Reset();
+    if (TrackSpline->GetNumberOfSplinePoints() < 2) return;
+
+    TArray<FTrackSurfaceSample> Samples;
+    EvaluateSurfaceSamples(Settings, Samples);
+    if (IsGenerationCancelled(bCancelled)) return;
+
+    ComputeTrackChunkRows(Settings, Samples, OutFirstRows);
+    const TArray<int32>& FirstRows = OutFirstRows;
+    const int32 NumChunks = FirstRows.Num();
+    const int32 NumLODs = Settings.NumLODs;
+    TArray<FTrackChunkBuffers>& Buffers = OutBuffers;
+    Buffers.SetNum(NumChunks);
+
+    // Every chunk builds its own buffers, sized up front, so chunks are triangulated side by side. Chunks not started
+    // when the run is cancelled are skipped.
+    ParallelFor(TEXT("TrackMeshChunks"), NumChunks, 1, [&](int32 Chunk)
+    {
+        if (IsGenerationCancelled(bCancelled)) return;
+
+        const int32 FirstRow = FirstRows[Chunk];
+        const int32 LastRow = Chunk + 1 < NumChunks ? FirstRows[Chunk + 1] : Samples.Num() - 1;
+
+        FTrackChunkBuffers& Buffer = Buffers[Chunk];
+        Buffer.LODs.SetNum(NumLODs);
+        TArray<int32> Rows;
+        Rows.Reserve(LastRow - FirstRow + 1);
+        for (int32 LOD = 0; LOD < NumLODs; ++LOD)
+        {
+            // Every LOD keeps every other row of the one before within each segment. Rows on spline points and the
+            // chunk's last row always stay, so neighbouring chunks meet along the same edge whatever their LODs.
+            const int32 Stride = 1 << LOD;
+            Rows.Reset();
+            for (int32 Row = FirstRow; Row <= LastRow; ++Row)
+            {
+                if (Row == LastRow || Samples[Row].SegmentRow % Stride == 0)
+                {
+                    Rows.Add(Row);
+                }
+            }
+            TriangulateTrackRows(Samples, Rows, Settings.TrackWidth, Buffer.LODs[LOD]);
+        }
+
+        if (Settings.bSimpleTrackCollision)
+        {
+            BuildTrackSlabs(Samples, FirstRow, LastRow, Settings.TrackCollisionRowsPerSlab, Settings.TrackWidth, Settings.TrackCollisionThickness, Buffer.CollisionSlabs);
+        }
+
+        // The other LODs are subsets of LOD 0's rows, so its buffers and the LOD count cover them. Triangles only depend
+        // on the row count, which the vertex count already covers. UVs are hashed apart, a change to them alone doesn't
+        // need a recook.
+        const FTrackChunkLOD& Mesh = Buffer.LODs[0];
+        Buffer.UVHash = FCrc::MemCrc32(Mesh.UVs.GetData(), Mesh.UVs.Num() * Mesh.UVs.GetTypeSize());
+        Buffer.Hash = FCrc::MemCrc32(Mesh.Vertices.GetData(), Mesh.Vertices.Num() * Mesh.Vertices.GetTypeSize());
+        Buffer.Hash = FCrc::MemCrc32(Mesh.Normals.GetData(), Mesh.Normals.Num() * Mesh.Normals.GetTypeSize(), Buffer.Hash);
+        Buffer.Hash = FCrc::MemCrc32(&NumLODs, sizeof(NumLODs), Buffer.Hash);
+        for (const TArray<FVector>& Slab : Buffer.CollisionSlabs)
+        {
+            Buffer.Hash = FCrc::MemCrc32(Slab.GetData(), Slab.Num() * Slab.GetTypeSize(), Buffer.Hash);
+        }
+    }, GetTrackMeshParallelForFlags());
+}
+
+void AProceduralTrackGenerator::ResizeTrackChunks(const TArray<int32>& FirstRows)
+{
+    // Tracks saved before chunking kept the whole road in this one section.
+    TrackMesh->ClearAllMeshSections();
+
+    // Drop the chunks past the new end of the road.
+    const int32 NumChunks = FirstRows.Num();
+    for (int32 Chunk = NumChunks; Chunk < TrackChunks.Num(); ++Chunk)
+    {
+        if (TrackChunks[Chunk])
+        {
+            TrackChunks[Chunk]->DestroyComponent();
+        }
+    }
+    TrackChunks.SetNumZeroed(NumChunks);
+    TrackChunkHashes.SetNumZeroed(NumChunks);
+    TrackChunkUVHashes.SetNumZeroed(NumChunks);
+    TrackChunkLODs.SetNumZeroed(NumChunks);
+    TrackChunkFirstRows = FirstRows;
+}
+
+void AProceduralTrackGenerator::CommitTrackChunk(int32 Chunk, const FTrackChunkBuffers& Buffers)
+{
+    UProceduralMeshComponent*& Component = TrackChunks[Chunk];
+    if (!Component)
+    {
+        Component = CreateTrackChunk();
+    }
+    else if (TrackChunkHashes[Chunk] == Buffers.Hash && Component->GetNumSections() > 0)
+    {
+        // Same road as last time, keep its sections and cooked collision. When only the UVs moved on (the track got
+        // longer or shorter before this chunk), they're updated in place: without positions the update leaves the
+        // collision alone.
+        const bool bSameUVs = TrackChunkUVHashes[Chunk] == Buffers.UVHash;
+        for (int32 LOD = 0; LOD < Component->GetNumSections(); ++LOD)
+        {
+            if (!bSameUVs && Buffers.LODs.IsValidIndex(LOD))
+            {
+                Component->UpdateMeshSection(LOD, TArray<FVector>(), TArray<FVector>(), Buffers.LODs[LOD].UVs, TArray<FColor>(), TArray<FProcMeshTangent>());
+            }
+            Component->SetMaterial(LOD, TrackMaterial);
+        }
+        TrackChunkUVHashes[Chunk] = Buffers.UVHash;
+        return;
+    }
+
+    TArray<FProcMeshTangent> Tangents; // Not used in this basic example, but good practice.
+    TArray<FColor> VertexColors;      // Not used in this basic example.
+
+    // Every section and slab change recooks the component's collision. The old road's collision is switched off first
+    // (the section flags directly, the slabs by clearing them), so the recooks until the new road is in have nothing to
+    // cook and the chunk is cooked once, at the end.
+    Component->bUseAsyncCooking = TrackMesh->bUseAsyncCooking;
+    for (int32 Section = 0; Section < Component->GetNumSections(); ++Section)
+    {
+        Component->GetProcMeshSection(Section)->bEnableCollision = false;
+    }
+    Component->ClearCollisionConvexMeshes();
+
+    const int32 NumLODs = Buffers.LODs.Num();
+    for (int32 Section = Component->GetNumSections() - 1; Section >= NumLODs; --Section)
+    {
+        Component->ClearMeshSection(Section);
+    }
+
+    // One section per LOD, with the one the chunk is showing visible. Only LOD 0 has collision, cooked for this chunk
+    // alone, so its triangles are the hit face indices.
+    TrackChunkLODs[Chunk] = FMath::Min(TrackChunkLODs[Chunk], NumLODs - 1);
+    for (int32 LOD = 0; LOD < NumLODs; ++LOD)
+    {
+        const FTrackChunkLOD& Mesh = Buffers.LODs[LOD];
+        Component->CreateMeshSection(LOD, Mesh.Vertices, Mesh.Triangles, Mesh.Normals, Mesh.UVs, VertexColors, Tangents, false);
+        Component->SetMeshSectionVisible(LOD, LOD == TrackChunkLODs[Chunk]);
+        Component->SetMaterial(LOD, TrackMaterial);
+    }
+
+    // With slabs, physics contacts use them and only complex traces reach the triangles. Setting them is the one cook.
+    Component->bUseComplexAsSimpleCollision = Buffers.CollisionSlabs.Num() == 0 && TrackMesh->bUseComplexAsSimpleCollision;
+    if (FProcMeshSection* CollisionSection = Component->GetProcMeshSection(0))
+    {
+        CollisionSection->bEnableCollision = true;
+    }
+    Component->SetCollisionConvexMeshes(Buffers.CollisionSlabs);
+    TrackChunkHashes[Chunk] = Buffers.Hash;
+    TrackChunkUVHashes[Chunk] = Buffers.UVHash;
+}
+
+void AProceduralTrackGenerator::ComputeTrackChunkRows(const FTrackBuildSettings& Settings, const TArray<FTrackSurfaceSample>& Samples, TArray<int32>& OutFirstRows) const
+{
+    OutFirstRows.Reset();
+    if (Samples.Num() < 2) return;
+
+    // Only rows on spline points can start a chunk, so moving a point leaves the chunk boundaries before it alone.
+    OutFirstRows.Add(0);
+    for (int32 Row = 1; Row < Samples.Num() - 1; ++Row)
+    {
+        if (Samples[Row].SegmentRow == 0 && Samples[Row].Distance - Samples[OutFirstRows.Last()].Distance >= Settings.TrackChunkLength)
+        {
+            OutFirstRows.Add(Row);
+        }
+    }
+}
+
+UProceduralMeshComponent* AProceduralTrackGenerator::CreateTrackChunk()
+{
+    const FName ChunkName = MakeUniqueObjectName(this, UProceduralMeshComponent::StaticClass(), TEXT("TrackChunk"));
+    UProceduralMeshComponent* Chunk = NewObject<UProceduralMeshComponent>(this, ChunkName, RF_Transactional);
+    Chunk->SetupAttachment(TrackMesh);
+
+    // Chunks collide and render like the track mesh component they replace.
+    Chunk->BodyInstance.CopyBodyInstancePropertiesFrom(&TrackMesh->BodyInstance);
+    Chunk->bUseComplexAsSimpleCollision = TrackMesh->bUseComplexAsSimpleCollision;
+    Chunk->bUseAsyncCooking = TrackMesh->bUseAsyncCooking;
+    Chunk->SetCastShadow(TrackMesh->CastShadow);
+    Chunk->SetCanEverAffectNavigation(TrackMesh->CanEverAffectNavigation());
+
+    // Saved with the level like a component added in the editor.
+    AddInstanceComponent(Chunk);
+    Chunk->RegisterComponent();
+    return Chunk;
+}
+
+void AProceduralTrackGenerator::DestroyTrackChunks()
+{
+    for (UProceduralMeshComponent* Chunk : TrackChunks)
+    {
+        if (Chunk)
+        {
+            Chunk->DestroyComponent();
+        }
+    }
+    TrackChunks.Empty();
+    TrackChunkHashes.Empty();
+    TrackChunkUVHashes.Empty();
+    TrackChunkLODs.Empty();
+    TrackChunkFirstRows.Empty();
+}
+
+void AProceduralTrackGenerator::GenerateGroundProxy()
+{
+    GroundProxyMesh->ClearCollisionConvexMeshes();
+    if (TrackSpline->GetNumberOfSplinePoints() < 2) return;
+
+    // Road rows in the same local space as the track mesh.
+    TArray<FTrackSurfaceSample> Samples;
+    EvaluateSurfaceSamples(CaptureBuildSettings(), Samples);
+
+    TArray<TArray<FVector>> Slabs;
+    BuildTrackSlabs(Samples, 0, Samples.Num() - 1, GroundProxySamplesPerSlab, TrackWidth, GroundProxyThickness, Slabs);
+
+    GroundProxyMesh->SetCollisionConvexMeshes(Slabs);
+}
+
+void AProceduralTrackGenerator::ComputeSegmentFirstRows(const FTrackBuildSettings& Settings, TArray<int32>& OutFirstRows) const
+{
+    OutFirstRows.Reset();
+    if (TrackSpline->GetNumberOfSplinePoints() < 2) return;
+
+    const int32 NumSegments = TrackSpline->GetNumberOfSplineSegments();
+    const double RowAngle = FMath::DegreesToRadians(FMath::Max(Settings.TrackRowAngle, 0.5f));
+    OutFirstRows.SetNumUninitialized(NumSegments + 1);
+
+    int32 NumRows = 0;
+    for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+    {
+        OutFirstRows[Segment] = NumRows;
+
+        // How far the road turns and banks across the segment, summed over a few steps so an S-bend doesn't pass for
+        // a straight.
+        double Turn = 0.0;
+        FVector PreviousDirection = TrackSpline->GetDirectionAtSplineInputKey(Segment, ESplineCoordinateSpace::Local);
+        FVector PreviousUp = TrackSpline->GetUpVectorAtSplineInputKey(Segment, ESplineCoordinateSpace::Local);
+        for (int32 Step = 1; Step <= SegmentTurnSteps; ++Step)
+        {
+            const float Key = Segment + float(Step) / SegmentTurnSteps;
+            const FVector Direction = TrackSpline->GetDirectionAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+            const FVector Up = TrackSpline->GetUpVectorAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+            Turn += FMath::Acos(FMath::Clamp(Direction | PreviousDirection, -1.0, 1.0));
+            Turn += FMath::Acos(FMath::Clamp(Up | PreviousUp, -1.0, 1.0));
+            PreviousDirection = Direction;
+            PreviousUp = Up;
+        }
+
+        NumRows += FMath::Clamp(FMath::CeilToInt32(Turn / RowAngle), 1, MaxRowsPerSegment);
+    }
+    OutFirstRows[NumSegments] = NumRows;
+}
+
+void AProceduralTrackGenerator::EvaluateSurfaceSamples(const FTrackBuildSettings& Settings, TArray<FTrackSurfaceSample>& OutSamples) const
+{
+    TArray<int32> SegmentFirstRows;
+    ComputeSegmentFirstRows(Settings, SegmentFirstRows);
+    const int32 NumSamples = SegmentFirstRows.Num() > 0 ? SegmentFirstRows.Last() + 1 : 0;
+    OutSamples.SetNumUninitialized(NumSamples);
+    if (NumSamples == 0) return;
+
+    // Distance to the start of each segment, then the end of the spline.
+    const int32 NumSegments = TrackSpline->GetNumberOfSplineSegments();
+    TArray<float> SegmentStarts;
+    SegmentStarts.SetNumUninitialized(NumSegments + 1);
+    for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+    {
+        SegmentStarts[Segment] = TrackSpline->GetDistanceAlongSplineAtSplinePoint(Segment);
+    }
+    SegmentStarts[NumSegments] = TrackSpline->GetSplineLength();
+
+    FTrackArcLengthTable Scratch;
+    const FTrackArcLengthTable& Table = GetCurrentArcLengthTable(Scratch);
+
+    // Each row's distance comes from its index rather than a running sum, so rows are independent and the last one
+    // lands on the end of the spline (closing the loop) instead of wherever float drift leaves it.
+    // The table is only read here, so workers look up a batch of rows each, side by side.
+    const int32 NumBatches = FMath::DivideAndRoundUp(NumSamples, SurfaceSampleBatchSize);
+    ParallelFor(TEXT("TrackSurfaceSamples"), NumBatches, 1, [&](int32 Batch)
+    {
+        const int32 FirstRow = Batch * SurfaceSampleBatchSize;
+        const int32 Count = FMath::Min(SurfaceSampleBatchSize, NumSamples - FirstRow);
+
+        float Distances[SurfaceSampleBatchSize];
+        int32 SegmentRows[SurfaceSampleBatchSize];
+        for (int32 Item = 0; Item < Count; ++Item)
+        {
+            // The last row ends the last segment rather than starting one.
+            const int32 Row = FirstRow + Item;
+            const int32 Segment = FMath::Min(int32(Algo::UpperBound(SegmentFirstRows, Row)) - 1, NumSegments - 1);
+            SegmentRows[Item] = Row - SegmentFirstRows[Segment];
+            const float Alpha = float(SegmentRows[Item]) / (SegmentFirstRows[Segment + 1] - SegmentFirstRows[Segment]);
+            Distances[Item] = FMath::Lerp(SegmentStarts[Segment], SegmentStarts[Segment + 1], Alpha);
+        }
+
+        FVector Locations[SurfaceSampleBatchSize];
+        FVector Directions[SurfaceSampleBatchSize];
+        FVector UpVectors[SurfaceSampleBatchSize];
+        Table.SampleBatch(MakeArrayView(Distances, Count), MakeArrayView(Locations, Count), MakeArrayView(Directions, Count), MakeArrayView(UpVectors, Count));
+
+        for (int32 Item = 0; Item < Count; ++Item)
+        {
+            FTrackSurfaceSample& Sample = OutSamples[FirstRow + Item];
+            Sample.Distance = Distances[Item];
+            Sample.Location = Locations[Item];
+            Sample.RightVector = FVector::CrossProduct(Directions[Item], UpVectors[Item]).GetSafeNormal();
+            Sample.UpVector = UpVectors[Item];
+            Sample.SegmentRow = SegmentRows[Item];
+        }
+    }, GetTrackMeshParallelForFlags());
+}
+
+void AProceduralTrackGenerator::GetSurfaceSamples(TArray<float>& OutDistances, TArray<FVector>& OutLeftEdges, TArray<FVector>& OutRightEdges) const
+{
+    OutDistances.Reset();
+    OutLeftEdges.Reset();
+    OutRightEdges.Reset();
+    if (TrackSpline->GetNumberOfSplinePoints() < 2) return;
+
+    TArray<FTrackSurfaceSample> Samples;
+    EvaluateSurfaceSamples(CaptureBuildSettings(), Samples);
+
+    OutDistances.SetNumUninitialized(Samples.Num());
+    OutLeftEdges.SetNumUninitialized(Samples.Num());
+    OutRightEdges.SetNumUninitialized(Samples.Num());
+
+    // Mesh vertices are in the spline's local space, the mesh component shares its transform.
+    const FTransform MeshTransform = TrackMesh->GetComponentTransform();
+    for (int32 Row = 0; Row < Samples.Num(); ++Row)
+    {
+        const FTrackSurfaceSample& Sample = Samples[Row];
+        OutDistances[Row] = Sample.Distance;
+        OutLeftEdges[Row] = MeshTransform.TransformPosition(Sample.Location - Sample.RightVector * TrackWidth / 2);
+        OutRightEdges[Row] = MeshTransform.TransformPosition(Sample.Location + Sample.RightVector * TrackWidth / 2);
+    }
+}
+
+void AProceduralTrackGenerator::ComputeBuildingPlacements(const FTrackBuildSettings& Settings, FRandomStream& Stream, TArray<FTrackBuildingPlacement>& OutPlacements, const std::atomic<bool>* bCancelled) const
+{
+    OutPlacements.Reset();
+
+    const TArray<int32, TInlineAllocator<8>>& PlaceableAssets = Settings.PlaceableAssets;
+    FTrackArcLengthTable Scratch;
+    const FTrackArcLengthTable& Table = GetCurrentArcLengthTable(Scratch);
+    if (PlaceableAssets.Num() == 0 || Table.Num() < 2) return;
+
+    const FTransform& SplineTransform = Settings.SplineTransform;
+    const float Length = Table.GetLength();
+    const bool bClosedLoop = TrackSpline->IsClosedLoop();
+    const float Spacing = Settings.BuildingSpacing;
+
+    // Buildings stand in a band either side of the road, this far from its centre line.
+    const float InnerOffset = FMath::Max(Settings.TrackWidth / 2 + Settings.BuildingSideOffsetMin, 1.0f);
+    const float OuterOffset = FMath::Max(Settings.TrackWidth / 2 + Settings.BuildingSideOffsetMax, InnerOffset);
+
+    // The centre line at every table entry, so a spot in the band of one stretch that a tight bend brings too close to
+    // another stretch of road is turned down as well.
+    FTrackSpatialHash Road;
+    Road.Reset(InnerOffset);
+    for (int32 Entry = 0; Entry < Table.Num(); ++Entry)
+    {
+        FVector Location, Direction, UpVector;
+        Table.Sample(Entry * Length / (Table.Num() - 1), Location, Direction, UpVector);
+        Road.Add(FVector2D(SplineTransform.TransformPosition(Location)));
+    }
+
+    // Buildings placed so far, with the distance along the track and signed offset across it of each.
+    FTrackSpatialHash Buildings;
+    Buildings.Reset(Spacing);
+    TArray<FVector2D> TrackPositions;
+    TArray<int32> Active;
+
+    // Places a building Offset across the track at Distance along it if the spot is in the band and clear of the road
+    // and every other building.
+    auto TryPlace = [&](float Distance, float Offset)
+    {
+        if (FMath::Abs(Offset) < InnerOffset || FMath::Abs(Offset) > OuterOffset || (!bClosedLoop && (Distance < 0 || Distance > Length)))
+        {
+            return false;
+        }
+
+        FVector Location, Direction, UpVector;
+        Table.Sample(Distance, Location, Direction, UpVector);
+        const FVector RightVector = SplineTransform.TransformVectorNoScale(FVector::CrossProduct(UpVector, Direction).GetSafeNormal());
+        const FVector SpawnLocation = QuantizeTrackLocation(SplineTransform.TransformPosition(Location) + RightVector * Offset);
+        const FVector2D Point(SpawnLocation);
+        if (Buildings.AnyWithin(Point, Spacing) || Road.AnyWithin(Point, InnerOffset))
+        {
+            return false;
+        }
+
+        Buildings.Add(Point);
+        Active.Add(TrackPositions.Add(FVector2D(Distance, Offset)));
+
+        // Choose a random building, with some random yaw rotation for variety.
+        FTrackBuildingPlacement& Placement = OutPlacements.AddDefaulted_GetRef();
+        Placement.AssetIndex = PlaceableAssets[Stream.RandRange(0, PlaceableAssets.Num() - 1)];
+        Placement.Transform = FTransform(FQuat(FRotator(0, Stream.FRandRange(0, 360), 0)), SpawnLocation);
+        return true;
+    };
+
+    // Bridson's Poisson-disk sampling, in track space so the band is easy to stay in but with the spacing checked in
+    // the world. The band is usually narrower than the spacing, so candidates are drawn across the band on the side of
+    // the building they grow from and up to two spacings along the track, rather than from a ring around it. Starting
+    // over every Spacing along each side fills both sides and any stretch a bend has cut off from the rest.
+    for (float Distance = 0; Distance < Length && !IsGenerationCancelled(bCancelled); Distance += Spacing)
+    {
+        for (const float Side : { -1.0f, 1.0f })
+        {
+            if (!TryPlace(Distance, Side * Stream.FRandRange(InnerOffset, OuterOffset)))
+            {
+                continue;
+            }
+
+            while (Active.Num() > 0)
+            {
+                if (IsGenerationCancelled(bCancelled)) return;
+
+                const int32 ActiveIndex = Stream.RandRange(0, Active.Num() - 1);
+                const FVector2D From = TrackPositions[Active[ActiveIndex]];
+                const float FromSide = From.Y < 0 ? -1.0f : 1.0f;
+
+                bool bPlaced = false;
+                for (int32 Candidate = 0; Candidate < BuildingCandidatesPerPoint && !bPlaced; ++Candidate)
+                {
+                    const float Along = Stream.FRandRange(-2 * Spacing, 2 * Spacing);
+                    bPlaced = TryPlace(From.X + Along, FromSide * Stream.FRandRange(InnerOffset, OuterOffset));
+                }
+                if (!bPlaced)
+                {
+                    Active.RemoveAtSwap(ActiveIndex);
+                }
+            }
+        }
+    }
+}
+
+ADestructibleBuildingActor* AProceduralTrackGenerator::SpawnBuilding(const FTrackBuildingPlacement& Placement)
+{
+    // Building actors replicate, so clients get the server's.
+    if (!HasAuthority() || !BuildingAssets.IsValidIndex(Placement.AssetIndex) || !BuildingAssets[Placement.AssetIndex].DestructibleActorClass)
+    {
+        return nullptr;
+    }
+
+    // Spawn the destructible actor blueprint.
+    ADestructibleBuildingActor* NewBuilding = GetWorld()->SpawnActor<ADestructibleBuildingActor>(BuildingAssets[Placement.AssetIndex].DestructibleActorClass, Placement.Transform);
+    if (NewBuilding)
+    {
+        // Store the reference so we can clean it up later.
+        SpawnedBuildingActors.Add(NewBuilding);
+    }
+    return NewBuilding;
+}
+
+void AProceduralTrackGenerator::PlaceBuildings(TArrayView<const FTrackBuildingPlacement> Placements)
+{
+    // A building is known everywhere by its type and the order it was placed in, which every machine generating the
+    // same seed agrees on. The checksum catches the odd one that doesn't.
+    for (const FTrackBuildingPlacement& Placement : Placements)
+    {
+        BuildingChecksum = HashBuildingPlacement(Placement, BuildingChecksum);
+    }
+
+    if (!GInstancedBuildings)
+    {
+        for (const FTrackBuildingPlacement& Placement : Placements)
+        {
+            if (AActor* Building = SpawnBuilding(Placement))
+            {
+                AddPlacedBuilding(Placement.Transform.GetLocation(), { Placement.AssetIndex, INDEX_NONE, Building });
+            }
+        }
+        return;
+    }
+
+    // One batch per building type, so each component builds its tree once.
+    TArray<TArray<FTransform>> Transforms;
+    Transforms.SetNum(BuildingAssets.Num());
+    for (const FTrackBuildingPlacement& Placement : Placements)
+    {
+        if (GetBuildingInstances(Placement.AssetIndex))
+        {
+            Transforms[Placement.AssetIndex].Add(Placement.Transform);
+        }
+        else if (AActor* Building = SpawnBuilding(Placement))
+        {
+            // Nothing to draw an instance with, so this type stays an actor.
+            AddPlacedBuilding(Placement.Transform.GetLocation(), { Placement.AssetIndex, INDEX_NONE, Building });
+        }
+    }
+
+    for (int32 AssetIndex = 0; AssetIndex < Transforms.Num(); ++AssetIndex)
+    {
+        if (Transforms[AssetIndex].Num() > 0)
+        {
+            const TArray<int32> InstanceIndices = BuildingInstances[AssetIndex]->AddInstances(Transforms[AssetIndex], true, true);
+            for (int32 Added = 0; Added < InstanceIndices.Num(); ++Added)
+            {
+                AddPlacedBuilding(Transforms[AssetIndex][Added].GetLocation(), { AssetIndex, InstanceIndices[Added], nullptr });
+            }
+        }
+    }
+
+    // Promotions the server sent before these instances were placed.
+    for (int32 Pending = PendingHiddenInstances.Num() - 1; Pending >= 0; --Pending)
+    {
+        const FIntPoint Instance = PendingHiddenInstances[Pending];
+        const UHierarchicalInstancedStaticMeshComponent* Instances = BuildingInstances.IsValidIndex(Instance.X) ? BuildingInstances[Instance.X] : nullptr;
+        if (Instances && Instances->IsValidInstance(Instance.Y))
+        {
+            PendingHiddenInstances.RemoveAtSwap(Pending);
+            HideBuildingInstance(Instance.X, Instance.Y);
+        }
+    }
+}
+
+void AProceduralTrackGenerator::AddPlacedBuilding(const FVector& Location, const FTrackPlacedBuilding& Building)
+{
+    PlacedBuildings.Add(Building);
+    BuildingHash.Add(FVector2D(Location));
+}
+
+void AProceduralTrackGenerator::RebuildBuildingHash()
+{
+    PlacedBuildings.Reset();
+    BuildingHash.Reset(BuildingSpacing);
+
+    // Promoted instances are only scaled to nothing, so they still stand where their building did.
+    for (int32 AssetIndex = 0; AssetIndex < BuildingInstances.Num(); ++AssetIndex)
+    {
+        const UHierarchicalInstancedStaticMeshComponent* Instances = BuildingInstances[AssetIndex];
+        for (int32 InstanceIndex = 0; Instances && InstanceIndex < Instances->GetInstanceCount(); ++InstanceIndex)
+        {
+            FTransform Transform;
+            Instances->GetInstanceTransform(InstanceIndex, Transform, true);
+            AddPlacedBuilding(Transform.GetLocation(), { AssetIndex, InstanceIndex, nullptr });
+        }
+    }
+
+    for (AActor* Building : SpawnedBuildingActors)
+    {
+        if (Building)
+        {
+            const int32 AssetIndex = BuildingAssets.IndexOfByPredicate([Building](const FDestructibleBuildingAsset& Asset)
+            {
+                return Building->GetClass() == Asset.DestructibleActorClass.Get();
+            });
+            AddPlacedBuilding(Building->GetActorLocation(), { AssetIndex, INDEX_NONE, Building });
+        }
+    }
+}
+
+void AProceduralTrackGenerator::FindBuildingsNear(const FVector& Location, float Radius, TArray<FTrackPlacedBuilding>& OutBuildings) const
+{
+    OutBuildings.Reset();
+    BuildingHash.ForEachWithin(FVector2D(Location), Radius, [this, &OutBuildings](int32 Building, double)
+    {
+        OutBuildings.Add(PlacedBuildings[Building]);
+        return true;
+    });
+}
+
+UHierarchicalInstancedStaticMeshComponent* AProceduralTrackGenerator::GetBuildingInstances(int32 AssetIndex)
+{
+    if (!BuildingAssets.IsValidIndex(AssetIndex))
+    {
+        return nullptr;
+    }
+
+    const FDestructibleBuildingAsset& Asset = BuildingAssets[AssetIndex];
+    UStaticMesh* Mesh = Asset.IntactMesh;
+    if (!Mesh && Asset.DestructibleActorClass)
+    {
+        Mesh = Asset.DestructibleActorClass->GetDefaultObject<ADestructibleBuildingActor>()->GetIntactMesh();
+    }
+    if (!Mesh)
+    {
+        return nullptr;
+    }
+
+    if (BuildingInstances.Num() < BuildingAssets.Num())
+    {
+        BuildingInstances.SetNumZeroed(BuildingAssets.Num());
+    }
+
+    UHierarchicalInstancedStaticMeshComponent*& Instances = BuildingInstances[AssetIndex];
+    if (!Instances)
+    {
+        Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, NAME_None, RF_Transactional);
+        Instances->SetupAttachment(RootComponent);
+        // Same collision as the intact mesh of a destructible, so pods can't tell an instance from an actor.
+        Instances->SetCollisionProfileName(TEXT("BlockAll"));
+        AddInstanceComponent(Instances);
+        Instances->RegisterComponent();
+    }
+    if (Instances->GetStaticMesh() != Mesh)
+    {
+        Instances->SetStaticMesh(Mesh);
+    }
+    return Instances;
+}
+
+float AProceduralTrackGenerator::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+{
+    const float ActualDamage = Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
+
+    if (DamageEvent.IsOfType(FPointDamageEvent::ClassID))
+    {
+        const FHitResult& Hit = static_cast<const FPointDamageEvent&>(DamageEvent).HitInfo;
+        const int32 AssetIndex = BuildingInstances.IndexOfByKey(Hit.GetComponent());
+        if (AssetIndex != INDEX_NONE)
+        {
+            DamageBuildingInstance(AssetIndex, Hit.Item, DamageAmount);
+        }
+    }
+    else if (DamageEvent.IsOfType(FRadialDamageEvent::ClassID))
+    {
+        const FRadialDamageEvent& RadialDamage = static_cast<const FRadialDamageEvent&>(DamageEvent);
+
+        // ComponentHits has one hit per component, so one instance of each building type. The building hash finds the
+        // rest whose placement point is in range.
+        TSet<FIntPoint> Instances;
+        for (const FHitResult& Hit : RadialDamage.ComponentHits)
+        {
+            const int32 AssetIndex = BuildingInstances.IndexOfByKey(Hit.GetComponent());
+            if (AssetIndex != INDEX_NONE)
+            {
+                Instances.Add(FIntPoint(AssetIndex, Hit.Item));
+            }
+        }
+        TArray<FTrackPlacedBuilding> Nearby;
+        FindBuildingsNear(RadialDamage.Origin, RadialDamage.Params.OuterRadius, Nearby);
+        for (const FTrackPlacedBuilding& Building : Nearby)
+        {
+            if (Building.InstanceIndex != INDEX_NONE)
+            {
+                Instances.Add(FIntPoint(Building.AssetIndex, Building.InstanceIndex));
+            }
+        }
+
+        // Like UGameplayStatics::ApplyRadialDamage, on Visibility. The instanced components are left out so a building
+        // doesn't shield itself.
+        FCollisionQueryParams LineOfSightParams(SCENE_QUERY_STAT(TrackBuildingDamage), true, DamageCauser);
+        for (const UHierarchicalInstancedStaticMeshComponent* Component : BuildingInstances)
+        {
+            if (Component)
+            {
+                LineOfSightParams.AddIgnoredComponent(Component);
+            }
+        }
+
+        for (const FIntPoint& Instance : Instances)
+        {
+            DamageBuildingInstance(Instance.X, Instance.Y,
+                GetRadialDamageToInstance(RadialDamage, DamageAmount, Instance.X, Instance.Y, LineOfSightParams));
+        }
+    }
+
+    return ActualDamage;
+}
+
+float AProceduralTrackGenerator::GetRadialDamageToInstance(const FRadialDamageEvent& RadialDamage, float BaseDamage, int32 AssetIndex,
+    int32 InstanceIndex, const FCollisionQueryParams& LineOfSightParams) const
+{
+    const UHierarchicalInstancedStaticMeshComponent* Instances = BuildingInstances.IsValidIndex(AssetIndex) ? BuildingInstances[AssetIndex] : nullptr;
+    if (!Instances || !Instances->GetStaticMesh() || !Instances->IsValidInstance(InstanceIndex))
+    {
+        return 0.f;
+    }
+
+    FTransform Transform;
+    Instances->GetInstanceTransform(InstanceIndex, Transform, true);
+    if (Transform.GetScale3D().IsNearlyZero())
+    {
+        // Already promoted.
+        return 0.f;
+    }
+
+    const FBox Bounds = Instances->GetStaticMesh()->GetBounds().GetBox().TransformBy(Transform);
+    const FVector ClosestPoint = Bounds.GetClosestPointTo(RadialDamage.Origin);
+    const float Distance = FVector::Dist(RadialDamage.Origin, ClosestPoint);
+    const float DamageScale = RadialDamage.Params.GetDamageScale(Distance);
+    if (DamageScale <= 0.f)
+    {
+        return 0.f;
+    }
+
+    // An origin inside the bounds has nothing to trace through.
+    if (Distance > UE_KINDA_SMALL_NUMBER && GetWorld()->LineTraceTestByChannel(RadialDamage.Origin, ClosestPoint, ECC_Visibility, LineOfSightParams))
+    {
+        return 0.f;
+    }
+
+    return FMath::Lerp(RadialDamage.Params.MinimumDamage, BaseDamage, DamageScale);
+}
+
+void AProceduralTrackGenerator::DamageBuildingInstance(int32 AssetIndex, int32 InstanceIndex, float Damage)
+{
+    if (!BuildingAssets.IsValidIndex(AssetIndex) || Damage <= 0.f || Damage < BuildingAssets[AssetIndex].DestroyDamage)
+    {
+        return;
+    }
+
+    if (ADestructibleBuildingActor* Building = PromoteBuildingInstance(AssetIndex, InstanceIndex))
+    {
+        Building->TriggerDestruction();
+    }
+}
+
+ADestructibleBuildingActor* AProceduralTrackGenerator::PromoteBuildingInstance(int32 AssetIndex, int32 InstanceIndex)
+{
+    UHierarchicalInstancedStaticMeshComponent* Instances = BuildingInstances.IsValidIndex(AssetIndex) ? BuildingInstances[AssetIndex] : nullptr;
+    if (!HasAuthority() || !Instances || !Instances->IsValidInstance(InstanceIndex))
+    {
+        return nullptr;
+    }
+
+    FTransform Transform;
+    Instances->GetInstanceTransform(InstanceIndex, Transform, true);
+    if (Transform.GetScale3D().IsNearlyZero())
+    {
+        // Already promoted.
+        return nullptr;
+    }
+
+    ADestructibleBuildingActor* Building = AcquireDestructible(AssetIndex, Transform);
+    if (!Building)
+    {
+        return nullptr;
+    }
+
+    HideBuildingInstance(AssetIndex, InstanceIndex);
+    Building->SetSource(this, AssetIndex, InstanceIndex);
+    PromotedBuildings.Add(Building);
+    return Building;
+}
+
+void AProceduralTrackGenerator::HideBuildingInstance(int32 AssetIndex, int32 InstanceIndex)
+{
+    UHierarchicalInstancedStaticMeshComponent* Instances = BuildingInstances.IsValidIndex(AssetIndex) ? BuildingInstances[AssetIndex] : nullptr;
+    if (!Instances || !Instances->IsValidInstance(InstanceIndex))
+    {
+        PendingHiddenInstances.AddUnique(FIntPoint(AssetIndex, InstanceIndex));
+        return;
+    }
+
+    // Scaled to nothing rather than removed, so the other instances keep their indices. A zero scale instance has
+    // no physics body either.
+    FTransform Transform;
+    Instances->GetInstanceTransform(InstanceIndex, Transform, true);
+    Transform.SetScale3D(FVector::ZeroVector);
+    Instances->UpdateInstanceTransform(InstanceIndex, Transform, true, true, false);
+}
+
+ADestructibleBuildingActor* AProceduralTrackGenerator::AcquireDestructible(int32 AssetIndex, const FTransform& Transform)
+{
+    UClass* BuildingClass = BuildingAssets.IsValidIndex(AssetIndex) ? BuildingAssets[AssetIndex].DestructibleActorClass.Get() : nullptr;
+    if (!BuildingClass)
+    {
+        return nullptr;
+    }
+
+    const int32 PoolIndex = PooledDestructibles.IndexOfByPredicate([BuildingClass](const ADestructibleBuildingActor* Building)
+    {
+        return IsValid(Building) && Building->GetClass() == BuildingClass;
+    });
+    if (PoolIndex == INDEX_NONE)
+    {
+        return GetWorld()->SpawnActor<ADestructibleBuildingActor>(BuildingClass, Transform);
+    }
+
+    ADestructibleBuildingActor* Building = PooledDestructibles[PoolIndex];
+    PooledDestructibles.RemoveAtSwap(PoolIndex);
+    Building->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+    Building->SetPooled(false);
+    return Building;
+}
+
+void AProceduralTrackGenerator::FillDestructiblePool()
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    for (const FDestructibleBuildingAsset& Asset : BuildingAssets)
+    {
+        UClass* BuildingClass = Asset.DestructibleActorClass.Get();
+        if (!BuildingClass)
+        {
+            continue;
+        }
+
+        int32 Pooled = 0;
+        for (const ADestructibleBuildingActor* Building : PooledDestructibles)
+        {
+            Pooled += IsValid(Building) && Building->GetClass() == BuildingClass;
+        }
+
+        for (; Pooled < DestructiblePoolSize; ++Pooled)
+        {
+            ADestructibleBuildingActor* Building = GetWorld()->SpawnActor<ADestructibleBuildingActor>(BuildingClass, GetActorTransform(), SpawnParams);
+            if (Building)
+            {
+                Building->SetPooled(true);
+                PooledDestructibles.Add(Building);
+            }
+        }
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+// Generation benchmarks. The mesh and cache ones run on a throwaway track far below the level.
+struct FProceduralTrackMeshBench
+{
+    static AProceduralTrackGenerator* SpawnTrack(UWorld* World)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AProceduralTrackGenerator* Track = World->SpawnActor<AProceduralTrackGenerator>(FVector(0, 0, -100000), FRotator::ZeroRotator, SpawnParams);
+        if (Track)
+        {
+            Track->SetActorHiddenInGame(true);
+        }
+        return Track;
+    }
+
+    // Surface evaluation and the full mesh build, single threaded against parallel.
+    static void Run(const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 100) : 5;
+
+        AProceduralTrackGenerator* Track = SpawnTrack(World);
+        if (!Track)
+        {
+            return;
+        }
+
+        const int32 SavedParallel = GParallelTrackMesh;
+        const int32 ControlPointCounts[] = { 10, 100, 1000 };
+        for (const int32 NumPoints : ControlPointCounts)
+        {
+            Track->NumberOfControlPoints = NumPoints;
+            FRandomStream Stream(Track->GenerationSeed);
+            Track->GenerateSplinePoints(Stream);
+
+            for (int32 Parallel = 0; Parallel <= 1; ++Parallel)
+            {
+                GParallelTrackMesh = Parallel;
+
+                const FTrackBuildSettings Settings = Track->CaptureBuildSettings();
+                TArray<FTrackSurfaceSample> Samples;
+                double SampleSeconds = 0.0;
+                double MeshSeconds = 0.0;
+                for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+                {
+                    double Start = FPlatformTime::Seconds();
+                    Track->EvaluateSurfaceSamples(Settings, Samples);
+                    SampleSeconds += FPlatformTime::Seconds() - Start;
+
+                    // Forget the chunk hashes so every chunk is rebuilt.
+                    Track->TrackChunkHashes.Reset();
+                    Start = FPlatformTime::Seconds();
+                    Track->GenerateTrackMesh();
+                    MeshSeconds += FPlatformTime::Seconds() - Start;
+                }
+
+                UE_LOG(LogTemp, Display, TEXT("Pod.Track.MeshBench: %d points, %d rows, %s: samples %.3f ms, mesh with collision %.3f ms"),
+                    NumPoints, Samples.Num(), Parallel ? TEXT("parallel") : TEXT("single thread"),
+                    SampleSeconds * 1000.0 / Iterations, MeshSeconds * 1000.0 / Iterations);
+            }
+        }
+        GParallelTrackMesh = SavedParallel;
+
+        Track->Destroy();
+    }
+
+    // Cold generation against generation from the track cache, plus the bare build against the bare cache read.
+    static void RunCache(const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 100) : 3;
+
+        AProceduralTrackGenerator* Track = SpawnTrack(World);
+        if (!Track)
+        {
+            return;
+        }
+
+        const int32 SavedUseCache = GUseTrackCache;
+        const int32 ControlPointCounts[] = { 10, 100, 1000 };
+        for (const int32 NumPoints : ControlPointCounts)
+        {
+            Track->NumberOfControlPoints = NumPoints;
+            const uint64 Key = Track->ComputeTrackCacheKey();
+
+            double ColdSeconds = 0.0;
+            double CachedSeconds = 0.0;
+            double BuildSeconds = 0.0;
+            double LoadSeconds = 0.0;
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                // Whole Generate calls, from a cleared track so every chunk is cooked both ways.
+                GUseTrackCache = 0;
+                Track->ClearAll();
+                double Start = FPlatformTime::Seconds();
+                Track->Generate();
+                ColdSeconds += FPlatformTime::Seconds() - Start;
+
+                GUseTrackCache = 1;
+                FTrackCacheData Data;
+                Start = FPlatformTime::Seconds();
+                FRandomStream Stream(Track->GenerationSeed);
+                const FTrackBuildSettings Settings = Track->CaptureBuildSettings();
+                Track->ComputeSplinePoints(Settings, Stream, Track->GetActorLocation(), Data.SplinePoints);
+                Track->BuildTrackChunks(Settings, Data.ChunkBuffers, Data.ChunkFirstRows);
+                Track->ComputeBuildingPlacements(Settings, Stream, Data.Placements);
+                BuildSeconds += FPlatformTime::Seconds() - Start;
+                SaveTrackCache(Key, Data);
+
+                Start = FPlatformTime::Seconds();
+                const bool bLoaded = LoadTrackCache(Key, Data);
+                LoadSeconds += FPlatformTime::Seconds() - Start;
+                if (!bLoaded)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("Pod.Track.CacheBench: couldn't read back %s"), *GetTrackCacheFilename(Key));
+                }
+
+                Track->ClearAll();
+                Start = FPlatformTime::Seconds();
+                Track->Generate();
+                CachedSeconds += FPlatformTime::Seconds() - Start;
+            }
+
+            UE_LOG(LogTemp, Display, TEXT("Pod.Track.CacheBench: %d points: Generate cold %.3f ms, cached %.3f ms; build %.3f ms, cache read %.3f ms (%lld bytes)"),
+                NumPoints, ColdSeconds * 1000.0 / Iterations, CachedSeconds * 1000.0 / Iterations,
+                BuildSeconds * 1000.0 / Iterations, LoadSeconds * 1000.0 / Iterations, IFileManager::Get().FileSize(*GetTrackCacheFilename(Key)));
+
+            IFileManager::Get().Delete(*GetTrackCacheFilename(Key));
+        }
+        GUseTrackCache = SavedUseCache;
+
+        Track->Destroy();
+    }
+
+    // Vertices per road LOD against the fixed ten rows per segment generated before, and the time to build them all.
+    static void RunLODs(const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 100) : 5;
+
+        AProceduralTrackGenerator* Track = SpawnTrack(World);
+        if (!Track)
+        {
+            return;
+        }
+
+        const int32 ControlPointCounts[] = { 10, 100, 1000 };
+        for (const int32 NumPoints : ControlPointCounts)
+        {
+            Track->NumberOfControlPoints = NumPoints;
+            FRandomStream Stream(Track->GenerationSeed);
+            Track->GenerateSplinePoints(Stream);
+
+            TArray<FTrackChunkBuffers> Buffers;
+            TArray<int32> FirstRows;
+            const double Start = FPlatformTime::Seconds();
+            const FTrackBuildSettings Settings = Track->CaptureBuildSettings();
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                Track->BuildTrackChunks(Settings, Buffers, FirstRows);
+            }
+            const double Seconds = FPlatformTime::Seconds() - Start;
+
+            TArray<int32> LODVertices;
+            for (const FTrackChunkBuffers& Buffer : Buffers)
+            {
+                LODVertices.SetNumZeroed(FMath::Max(LODVertices.Num(), Buffer.LODs.Num()));
+                for (int32 LOD = 0; LOD < Buffer.LODs.Num(); ++LOD)
+                {
+                    LODVertices[LOD] += Buffer.LODs[LOD].Vertices.Num();
+                }
+            }
+
+            FString Counts;
+            for (int32 LOD = 0; LOD < LODVertices.Num(); ++LOD)
+            {
+                Counts += FString::Printf(TEXT(", LOD%d %d"), LOD, LODVertices[LOD]);
+            }
+
+            const int32 FixedVertices = (Track->TrackSpline->GetNumberOfSplineSegments() * FixedRowsPerSegment + 1) * 2;
+            UE_LOG(LogTemp, Display, TEXT("Pod.Track.LODBench: %d points: fixed density %d vertices%s; every LOD built in %.3f ms"),
+                NumPoints, FixedVertices, *Counts, Seconds * 1000.0 / Iterations);
+        }
+
+        Track->Destroy();
+    }
+
+    // Distance lookups through the spline's own reparameterization against the arc-length table, one at a time and
+    // batched, plus how far the table strays from the spline.
+    static void RunArcLength(const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 NumLookups = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1000, 10000000) : 100000;
+
+        AProceduralTrackGenerator* Track = SpawnTrack(World);
+        if (!Track)
+        {
+            return;
+        }
+
+        const USplineComponent* Spline = Track->TrackSpline;
+        TArray<float> Distances;
+        TArray<FVector> Locations;
+        TArray<FVector> Directions;
+        TArray<FVector> UpVectors;
+        Distances.SetNumUninitialized(NumLookups);
+        Locations.SetNumUninitialized(NumLookups);
+        Directions.SetNumUninitialized(NumLookups);
+        UpVectors.SetNumUninitialized(NumLookups);
+
+        const int32 ControlPointCounts[] = { 10, 100, 1000 };
+        for (const int32 NumPoints : ControlPointCounts)
+        {
+            Track->NumberOfControlPoints = NumPoints;
+            FRandomStream Stream(Track->GenerationSeed);
+            Track->GenerateSplinePoints(Stream);
+
+            double Start = FPlatformTime::Seconds();
+            Track->BakeArcLengthTable();
+            const double BakeSeconds = FPlatformTime::Seconds() - Start;
+            const FTrackArcLengthTable& Table = Track->ArcLengthTable;
+
+            FRandomStream DistanceStream(NumPoints);
+            for (float& Distance : Distances)
+            {
+                Distance = DistanceStream.FRandRange(0.0f, Table.GetLength());
+            }
+
+            Start = FPlatformTime::Seconds();
+            for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+            {
+                const float Key = Spline->GetInputKeyValueAtDistanceAlongSpline(Distances[Lookup]);
+                Locations[Lookup] = Spline->GetLocationAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+                Directions[Lookup] = Spline->GetDirectionAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+                UpVectors[Lookup] = Spline->GetUpVectorAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+            }
+            const double SplineSeconds = FPlatformTime::Seconds() - Start;
+
+            // Error against the spline results still in Locations, before the table overwrites them.
+            double MaxError = 0.0;
+            for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+            {
+                FVector Location, Direction, UpVector;
+                Table.Sample(Distances[Lookup], Location, Direction, UpVector);
+                MaxError = FMath::Max(MaxError, FVector::Dist(Location, Locations[Lookup]));
+            }
+
+            Start = FPlatformTime::Seconds();
+            for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+            {
+                Table.Sample(Distances[Lookup], Locations[Lookup], Directions[Lookup], UpVectors[Lookup]);
+            }
+            const double TableSeconds = FPlatformTime::Seconds() - Start;
+
+            Start = FPlatformTime::Seconds();
+            Table.SampleBatch(Distances, Locations, Directions, UpVectors);
+            const double BatchSeconds = FPlatformTime::Seconds() - Start;
+
+            UE_LOG(LogTemp, Display, TEXT("Pod.Track.ArcLengthBench: %d points, %d entries (%.1f KB) baked in %.3f ms; %d lookups: spline %.3f ms, table %.3f ms, batched %.3f ms; largest error %.3f cm"),
+                NumPoints, Table.Num(), Table.GetAllocatedSize() / 1024.0, BakeSeconds * 1000.0, NumLookups,
+                SplineSeconds * 1000.0, TableSeconds * 1000.0, BatchSeconds * 1000.0, MaxError);
+        }
+
+        Track->Destroy();
+    }
+
+    // Game thread time to commit every chunk cooking in place against handing the cooks to workers, and pod-sized
+    // sweeps against the chunks, which is the narrow phase a physics step runs for each pod touching the road, with the
+    // triangles as simple collision against the slabs.
+    static void RunCollision(const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 NumSweeps = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 100, 1000000) : 10000;
+
+        AProceduralTrackGenerator* Track = SpawnTrack(World);
+        if (!Track)
+        {
+            return;
+        }
+
+        const FCollisionShape PodShape = FCollisionShape::MakeBox(FVector(200.0f, 100.0f, 50.0f));
+        const FTransform& TrackTransform = Track->TrackSpline->GetComponentTransform();
+        const int32 ControlPointCounts[] = { 10, 100, 1000 };
+        for (const int32 NumPoints : ControlPointCounts)
+        {
+            Track->NumberOfControlPoints = NumPoints;
+            FRandomStream Stream(Track->GenerationSeed);
+            Track->GenerateSplinePoints(Stream);
+
+            // The same rows for both kinds of collision.
+            TArray<FTrackSurfaceSample> Samples;
+            Track->EvaluateSurfaceSamples(Track->CaptureBuildSettings(), Samples);
+            TArray<int32> SweepRows;
+            FRandomStream RowStream(NumPoints);
+            for (int32 Sweep = 0; Sweep < NumSweeps; ++Sweep)
+            {
+                SweepRows.Add(RowStream.RandRange(0, Samples.Num() - 1));
+            }
+
+            const bool bSavedAsync = Track->TrackMesh->bUseAsyncCooking;
+            for (int32 Simple = 0; Simple <= 1; ++Simple)
+            {
+                Track->bSimpleTrackCollision = Simple != 0;
+                TArray<FTrackChunkBuffers> Buffers;
+                TArray<int32> FirstRows;
+                Track->BuildTrackChunks(Track->CaptureBuildSettings(), Buffers, FirstRows);
+                Track->ResizeTrackChunks(FirstRows);
+
+                // Async first, so the sweeps run against the collision the synchronous commit has just cooked.
+                double CommitSeconds[2] = {};
+                for (int32 Async = 1; Async >= 0; --Async)
+                {
+                    Track->TrackMesh->bUseAsyncCooking = Async != 0;
+                    for (uint32& Hash : Track->TrackChunkHashes)
+                    {
+                        Hash = 0;
+                    }
+
+                    const double Start = FPlatformTime::Seconds();
+                    for (int32 Chunk = 0; Chunk < Buffers.Num(); ++Chunk)
+                    {
+                        Track->CommitTrackChunk(Chunk, Buffers[Chunk]);
+                    }
+                    CommitSeconds[Async] = FPlatformTime::Seconds() - Start;
+                }
+
+                int32 Hits = 0;
+                const double Start = FPlatformTime::Seconds();
+                for (const int32 Row : SweepRows)
+                {
+                    // Dropped onto the road from a little above it, lined up with it like a pod racing along.
+                    const FTrackSurfaceSample& Sample = Samples[Row];
+                    const int32 Chunk = Algo::UpperBound(FirstRows, Row) - 1;
+                    const FVector Location = TrackTransform.TransformPosition(Sample.Location);
+                    const FVector UpVector = TrackTransform.TransformVectorNoScale(Sample.UpVector);
+                    const FQuat Rotation = FRotationMatrix::MakeFromYZ(TrackTransform.TransformVectorNoScale(Sample.RightVector), UpVector).ToQuat();
+
+                    FHitResult Hit;
+                    Hits += Track->TrackChunks[Chunk]->SweepComponent(Hit, Location + UpVector * 300.0f, Location - UpVector * 100.0f, Rotation, PodShape, false);
+                }
+                const double SweepSeconds = FPlatformTime::Seconds() - Start;
+
+                int32 NumSlabs = 0;
+                int32 NumTriangles = 0;
+                for (const FTrackChunkBuffers& Buffer : Buffers)
+                {
+                    NumSlabs += Buffer.CollisionSlabs.Num();
+                    NumTriangles += Buffer.LODs[0].Triangles.Num() / 3;
+                }
+
+                UE_LOG(LogTemp, Display, TEXT("Pod.Track.CollisionBench: %d points, %d chunks, %s: commit cooking in place %.3f ms, async %.3f ms; %d sweeps %.3f us each, %d hit"),
+                    NumPoints, Buffers.Num(),
+                    *(Simple ? FString::Printf(TEXT("%d slabs"), NumSlabs) : FString::Printf(TEXT("%d triangles as simple"), NumTriangles)),
+                    CommitSeconds[0] * 1000.0, CommitSeconds[1] * 1000.0, NumSweeps, SweepSeconds * 1000000.0 / NumSweeps, Hits);
+            }
+            Track->TrackMesh->bUseAsyncCooking = bSavedAsync;
+        }
+
+        Track->Destroy();
+    }
+
+    static void AddObjectBytes(const UObject* Object, int32& InOutObjects, SIZE_T& InOutBytes)
+    {
+        ++InOutObjects;
+        InOutBytes += Object->GetClass()->GetStructureSize() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+    }
+
+    // Building placement with the building settings of the first track in the level that has building assets, as actors
+    // against as instances, and buildings-near queries through the building hash against checking every building. Runs
+    // on a throwaway track, so the level's own track and its buildings are left alone.
+    static void RunBuildings(const TArray<FString>& Args, UWorld* World)
+    {
+        const AProceduralTrackGenerator* LevelTrack = nullptr;
+        for (TActorIterator<AProceduralTrackGenerator> It(World); It; ++It)
+        {
+            if (It->BuildingAssets.Num() > 0 && !It->HasAnyFlags(RF_Transient))
+            {
+                LevelTrack = *It;
+                break;
+            }
+        }
+        if (!LevelTrack)
+        {
+            UE_LOG(LogTemp, Display, TEXT("Pod.Track.BuildingBench: no track with building assets in this world"));
+            return;
+        }
+
+        AProceduralTrackGenerator* Track = SpawnTrack(World);
+        if (!Track)
+        {
+            return;
+        }
+        Track->GenerationSeed = LevelTrack->GenerationSeed;
+        Track->NumberOfControlPoints = LevelTrack->NumberOfControlPoints;
+        Track->MinPointDistance = LevelTrack->MinPointDistance;
+        Track->MaxPointDistance = LevelTrack->MaxPointDistance;
+        Track->MaxYawChange = LevelTrack->MaxYawChange;
+        Track->MaxPitchChange = LevelTrack->MaxPitchChange;
+        Track->MaxRollChange = LevelTrack->MaxRollChange;
+        Track->MaxZOffsetOnNextPoint = LevelTrack->MaxZOffsetOnNextPoint;
+        Track->TrackWidth = LevelTrack->TrackWidth;
+        Track->BuildingAssets = LevelTrack->BuildingAssets;
+        Track->BuildingSpacing = LevelTrack->BuildingSpacing;
+        Track->BuildingSideOffsetMin = LevelTrack->BuildingSideOffsetMin;
+        Track->BuildingSideOffsetMax = LevelTrack->BuildingSideOffsetMax;
+
+        // Same placements Generate draws for the seed, against the spline drawn from it.
+        FRandomStream Stream(Track->GenerationSeed);
+        const FTrackBuildSettings Settings = Track->CaptureBuildSettings();
+        TArray<FVector> SplinePoints;
+        Track->ComputeSplinePoints(Settings, Stream, Track->GetActorLocation(), SplinePoints);
+        Track->ApplySplinePoints(SplinePoints);
+        TArray<FTrackBuildingPlacement> Placements;
+        const double PlacementStart = FPlatformTime::Seconds();
+        Track->ComputeBuildingPlacements(Settings, Stream, Placements);
+        const double PlacementSeconds = FPlatformTime::Seconds() - PlacementStart;
+
+        // Poisson-disk placement keeps every pair at least BuildingSpacing apart.
+        const float Spacing = Track->BuildingSpacing;
+        FTrackSpatialHash Placed;
+        Placed.Reset(Spacing);
+        double Closest = TNumericLimits<double>::Max();
+        for (const FTrackBuildingPlacement& Placement : Placements)
+        {
+            const FVector2D Point(Placement.Transform.GetLocation());
+            Placed.ForEachWithin(Point, Spacing * 2, [&Closest](int32, double DistanceSquared)
+            {
+                Closest = FMath::Min(Closest, FMath::Sqrt(DistanceSquared));
+                return true;
+            });
+            Placed.Add(Point);
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("Pod.Track.BuildingBench: %d placements computed in %.3f ms, closest two %s apart (spacing %.0f cm)"),
+            Placements.Num(), PlacementSeconds * 1000.0,
+            *(Closest < TNumericLimits<double>::Max() ? FString::Printf(TEXT("%.0f cm"), Closest) : FString(TEXT("over two spacings"))), Spacing);
+
+        const int32 SavedInstanced = GInstancedBuildings;
+        for (int32 Instanced = 0; Instanced <= 1; ++Instanced)
+        {
+            GInstancedBuildings = Instanced;
+            Track->ClearBuildings();
+
+            const int32 ActorsBefore = World->GetActorCount();
+            const double Start = FPlatformTime::Seconds();
+            Track->PlaceBuildings(Placements);
+            const double Seconds = FPlatformTime::Seconds() - Start;
+
+            // Object headers plus what each object reports for itself, meshes and other shared assets left out.
+            int32 Objects = 0;
+            SIZE_T Bytes = 0;
+            for (const AActor* Building : Track->SpawnedBuildingActors)
+            {
+                if (Building)
+                {
+                    AddObjectBytes(Building, Objects, Bytes);
+                    for (const UActorComponent* Component : Building->GetComponents())
+                    {
+                        AddObjectBytes(Component, Objects, Bytes);
+                    }
+                }
+            }
+            for (const UHierarchicalInstancedStaticMeshComponent* Instances : Track->BuildingInstances)
+            {
+                if (Instances)
+                {
+                    AddObjectBytes(Instances, Objects, Bytes);
+                }
+            }
+
+            UE_LOG(LogTemp, Display, TEXT("Pod.Track.BuildingBench: %s: %d buildings, %d new actors, %d objects, %.1f KB, placed in %.3f ms"),
+                Instanced ? TEXT("instanced") : TEXT("actors"), Placements.Num(), World->GetActorCount() - ActorsBefore,
+                Objects, Bytes / 1024.0, Seconds * 1000.0);
+        }
+        GInstancedBuildings = SavedInstanced;
+
+        Track->ClearBuildings();
+        Track->PlaceBuildings(Placements);
+
+        const int32 NumQueries = 10000;
+        const float QueryRadius = Spacing * 2;
+        FRandomStream QueryStream(Track->GenerationSeed);
+        TArray<FVector> QueryLocations;
+        for (int32 Query = 0; Query < NumQueries; ++Query)
+        {
+            QueryLocations.Add(Track->GetTrackTransformAtDistance(QueryStream.FRandRange(0.0f, Track->ArcLengthTable.GetLength())).GetLocation());
+        }
+
+        int32 HashFound = 0;
+        TArray<FTrackPlacedBuilding> Nearby;
+        double Start = FPlatformTime::Seconds();
+        for (const FVector& Location : QueryLocations)
+        {
+            Track->FindBuildingsNear(Location, QueryRadius, Nearby);
+            HashFound += Nearby.Num();
+        }
+        const double HashSeconds = FPlatformTime::Seconds() - Start;
+
+        int32 ScanFound = 0;
+        Start = FPlatformTime::Seconds();
+        for (const FVector& Location : QueryLocations)
+        {
+            for (int32 Building = 0; Building < Track->BuildingHash.Num(); ++Building)
+            {
+                ScanFound += FVector2D::DistSquared(Track->BuildingHash.GetPoint(Building), FVector2D(Location)) < FMath::Square(QueryRadius);
+            }
+        }
+        const double ScanSeconds = FPlatformTime::Seconds() - Start;
+
+        UE_LOG(LogTemp, Display, TEXT("Pod.Track.BuildingBench: %d buildings-near queries of %.0f cm round points on the road: hash %.3f us each, checking all %d buildings %.3f us each (%d and %d found)"),
+            NumQueries, QueryRadius, HashSeconds * 1000000.0 / NumQueries, Track->BuildingHash.Num(), ScanSeconds * 1000000.0 / NumQueries, HashFound, ScanFound);
+
+        // Destroys the buildings and pool along with the instances.
+        Track->ClearAll();
+        Track->Destroy();
+    }
+};
+
+static FAutoConsoleCommandWithWorldAndArgs TrackMeshBenchCmd(
+    TEXT("Pod.Track.MeshBench"),
+    TEXT("Time track mesh generation at 10, 100 and 1000 control points, single threaded and parallel (arg: iterations, default 5)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FProceduralTrackMeshBench::Run));
+
+static FAutoConsoleCommandWithWorldAndArgs TrackCacheBenchCmd(
+    TEXT("Pod.Track.CacheBench"),
+    TEXT("Time Generate cold against Generate from the track cache at 10, 100 and 1000 control points (arg: iterations, default 3)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FProceduralTrackMeshBench::RunCache));
+
+static FAutoConsoleCommandWithWorldAndArgs TrackLODBenchCmd(
+    TEXT("Pod.Track.LODBench"),
+    TEXT("Log road vertex counts per LOD against the old fixed density, and the time to build every LOD, at 10, 100 and 1000 control points (arg: iterations, default 5)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FProceduralTrackMeshBench::RunLODs));
+
+static FAutoConsoleCommandWithWorldAndArgs TrackArcLengthBenchCmd(
+    TEXT("Pod.Track.ArcLengthBench"),
+    TEXT("Time distance lookups through the spline against the arc-length table, single and batched, at 10, 100 and 1000 control points (arg: lookups, default 100000)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FProceduralTrackMeshBench::RunArcLength));
+
+static FAutoConsoleCommandWithWorldAndArgs TrackCollisionBenchCmd(
+    TEXT("Pod.Track.CollisionBench"),
+    TEXT("Time committing the road chunks with collision cooked in place and async, and pod-sized sweeps against triangle and slab collision, at 10, 100 and 1000 control points (arg: sweeps, default 10000)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FProceduralTrackMeshBench::RunCollision));
+
+static FAutoConsoleCommandWithWorldAndArgs TrackBuildingBenchCmd(
+    TEXT("Pod.Track.BuildingBench"),
+    TEXT("Place buildings with the settings of the first track in the level on a throwaway track, as actors and as instances, logging actor count, memory and time, then time buildings-near queries"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FProceduralTrackMeshBench::RunBuildings));
+#endif
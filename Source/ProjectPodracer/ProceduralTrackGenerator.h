@@ -4,12 +4,103 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Containers/Ticker.h"
+#include "TrackArcLengthTable.h"
+#include "TrackSpatialHash.h"
+#include <atomic>
 #include "ProceduralTrackGenerator.generated.h"
 
 // Forward declarations
 class USplineComponent;
 class UProceduralMeshComponent;
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
 class ADestructibleBuildingActor;
+struct FTrackGenerationJob;
+struct FRadialDamageEvent;
+struct FCollisionQueryParams;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTrackGenerationProgress, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTrackGenerationFinished, bool, bCompleted);
+
+// One row of the track surface in the spline's local space: where the mesh builder puts a left and right vertex.
+struct FTrackSurfaceSample
+{
+    float Distance = 0.0f;
+    FVector Location = FVector::ZeroVector;
+    FVector RightVector = FVector::RightVector;
+    FVector UpVector = FVector::UpVector;
+    // Row within its spline segment, 0 on the spline point the segment starts at.
+    int32 SegmentRow = 0;
+};
+
+// Vertex and index buffers of one level of detail of a road chunk.
+struct FTrackChunkLOD
+{
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    TArray<FVector> Normals;
+    TArray<FVector2D> UVs;
+};
+
+// Every LOD of one road chunk, built off the game thread and committed on it. LOD 0 is the collision surface.
+struct FTrackChunkBuffers
+{
+    TArray<FTrackChunkLOD> LODs;
+    // Convex slabs under LOD 0 for physics contacts. Empty when the chunk uses its triangles as simple collision too.
+    TArray<TArray<FVector>> CollisionSlabs;
+    // Geometry and collision, which recommitting recooks.
+    uint32 Hash = 0;
+    // UVs alone. U runs on along the whole track, so a length change upstream changes every chunk after it, but only
+    // this hash.
+    uint32 UVHash = 0;
+};
+
+// Where one building goes, decided before anything is spawned.
+struct FTrackBuildingPlacement
+{
+    int32 AssetIndex = INDEX_NONE;
+    FTransform Transform;
+};
+
+// A building standing on the track: an instance of its asset's instanced component, or an actor.
+struct FTrackPlacedBuilding
+{
+    int32 AssetIndex = INDEX_NONE;
+    // Instance of BuildingInstances[AssetIndex], INDEX_NONE for an actor.
+    int32 InstanceIndex = INDEX_NONE;
+    TWeakObjectPtr<AActor> Actor;
+};
+
+// Every setting the generation stages read, copied on the game thread. Workers read this instead of the actor's
+// properties, which replication and edits can change while they run.
+struct FTrackBuildSettings
+{
+    // Control points.
+    int32 NumberOfControlPoints = 0;
+    float MinPointDistance = 0.0f;
+    float MaxPointDistance = 0.0f;
+    float MaxYawChange = 0.0f;
+    float MaxPitchChange = 0.0f;
+    float MaxRollChange = 0.0f;
+    float MaxZOffsetOnNextPoint = 0.0f;
+
+    // Road.
+    float TrackWidth = 0.0f;
+    float TrackChunkLength = 0.0f;
+    float TrackRowAngle = 0.0f;
+    int32 NumLODs = 1;
+    bool bSimpleTrackCollision = false;
+    int32 TrackCollisionRowsPerSlab = 2;
+    float TrackCollisionThickness = 0.0f;
+
+    // Buildings. Only the index of each asset with a destructible actor, which is all placement needs of them.
+    TArray<int32, TInlineAllocator<8>> PlaceableAssets;
+    float BuildingSpacing = 0.0f;
+    float BuildingSideOffsetMin = 0.0f;
+    float BuildingSideOffsetMax = 0.0f;
+    FTransform SplineTransform;
+};
 
 // A simple struct to pair an intact mesh with its destructible counterpart.
 // This makes it easy to manage assets in the editor.
@@ -25,6 +116,14 @@ struct FDestructibleBuildingAsset
     // The Blueprint or C++ class that handles the destruction logic (e.g., contains a Geometry Collection).
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Assets")
     TSubclassOf<ADestructibleBuildingActor> DestructibleActorClass;
+
+    // Mesh drawn for the intact building while it is an instance. Defaults to the destructible class's intact mesh.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Assets")
+    UStaticMesh* IntactMesh = nullptr;
+
+    // Damage one hit has to deal an instance, after radial falloff, for it to be promoted and destroyed.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage", meta = (ClampMin = "0.0"))
+    float DestroyDamage = 1.0f;
 };
 
 
@@ -40,98 +139,385 @@ public:
 protected:
     // Called when the game starts or when spawned
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void OnConstruction(const FTransform& Transform) override;
+    virtual void BeginDestroy() override;
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 public:
+    // Picks each road chunk's LOD for the local views. Only enabled where something is rendered.
+    virtual void Tick(float DeltaTime) override;
+
     // The main spline component that will define the path of the race track.
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     USplineComponent* TrackSpline;
 
-    // The procedural mesh component that will be used to construct the track's visual mesh.
+    // Intact buildings, one instanced component per entry of BuildingAssets (null for types with no intact mesh).
+    UPROPERTY(VisibleInstanceOnly, Category = "Components")
+    TArray<UHierarchicalInstancedStaticMeshComponent*> BuildingInstances;
+
+    // Parent of the road chunks, whose collision and shadow settings they copy. Holds no geometry itself.
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UProceduralMeshComponent* TrackMesh;
 
+    // The road, one component per chunk so each is culled against its own bounds and cooks its own collision.
+    UPROPERTY(VisibleInstanceOnly, Category = "Components")
+    TArray<UProceduralMeshComponent*> TrackChunks;
+
+    // First surface row of each chunk. A chunk runs to the first row of the next one (or the last row), sharing it.
+    UPROPERTY()
+    TArray<int32> TrackChunkFirstRows;
+
+    // Hidden low-poly slabs under the road that hover probes trace against (PodGround channel, simple collision only).
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    UProceduralMeshComponent* GroundProxyMesh;
+
     // --- Generation Parameters ---
 
-    // The seed for the random number generator to ensure tracks can be replicated.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation")
+    // The seed for the random number generator to ensure tracks can be replicated. Clients get this and the other
+    // replicated settings rather than the generated track, and generate it themselves.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation")
     int32 GenerationSeed = 12345;
 
     // The number of control points for the spline. More points = more complex track.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation", meta = (ClampMin = "4", UIMin = "4"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "4", UIMin = "4"))
     int32 NumberOfControlPoints = 10;
 
     // The maximum distance a control point can be from the previous one.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation", meta = (ClampMin = "1000.0"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "1000.0"))
     float MaxPointDistance = 10000.0f;
 
     // The minimum distance a control point can be from the previous one.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation", meta = (ClampMin = "500.0"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "500.0"))
     float MinPointDistance = 5000.0f;
 
     // The width of the racetrack mesh.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation", meta = (ClampMin = "100.0"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "100.0"))
     float TrackWidth = 1500.0f;
 
+    // Road length per mesh chunk. Chunks end on spline points, so each is at least this long (bar the last).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "1000.0"))
+    float TrackChunkLength = 20000.0f;
+
+    // Largest change in road direction or banking between neighbouring rows of LOD 0, in degrees. Rows go where the
+    // road turns, so straights get very few.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "0.5"))
+    float TrackRowAngle = 4.0f;
+
+    // Screen size below which each road LOD is drawn, like a static mesh's LOD screen sizes (entry 0 is LOD 0's).
+    // Each LOD keeps every other row of the one before it, and only LOD 0 has collision.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation")
+    TArray<float> TrackLODScreenSizes = { 1.0f, 0.3f, 0.1f };
+
+    // Width beyond each road edge that still counts as on the track (shoulder), for track-space queries.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "0.0"))
+    float ShoulderWidth = 500.0f;
+
     // The Max Yaw Change on a new spline point
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation", meta = (ClampMin = "90.0"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "90.0"))
     float MaxYawChange = 45.0f;
 
     // The Max Pitch Change on a new spline point
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation", meta = (ClampMin = "90.0"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "90.0"))
     float MaxPitchChange = 15.0f;
 
     // The Max Roll Change on a new spline point
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation", meta = (ClampMin = "90.0"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation", meta = (ClampMin = "90.0"))
     float MaxRollChange = 0.0f;
 
     // The Max Z Location Offset between points
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation")
     float MaxZOffsetOnNextPoint = 0.0f;
     
     // The material to apply to the generated track mesh.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Procedural Generation")
     UMaterialInterface* TrackMaterial;
 
+    // --- Hover Ground Proxy ---
+
+    // Mesh samples covered by each convex slab of the ground proxy. Fewer means a closer fit on tight bends.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Hover Ground Proxy", meta = (ClampMin = "2", UIMin = "2"))
+    int32 GroundProxySamplesPerSlab = 4;
+
+    // How far each slab extends below the road surface.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Hover Ground Proxy", meta = (ClampMin = "1.0"))
+    float GroundProxyThickness = 50.0f;
+
+    // --- Track Collision ---
+
+    // Give each road chunk convex slabs for physics to collide pods against, leaving its triangles to traces that ask
+    // for complex collision. Off, the triangles are the chunk's simple collision as well.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Track Collision")
+    bool bSimpleTrackCollision = true;
+
+    // Road rows covered by each slab. Fewer means a closer fit on tight bends.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Track Collision", meta = (ClampMin = "2", UIMin = "2", EditCondition = "bSimpleTrackCollision"))
+    int32 TrackCollisionRowsPerSlab = 4;
+
+    // How far each slab extends below the road surface. Thicker keeps fast pods from tunnelling through.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Track Collision", meta = (ClampMin = "1.0", EditCondition = "bSimpleTrackCollision"))
+    float TrackCollisionThickness = 100.0f;
+
     // --- Building Placement ---
 
     // An array of available building assets that can be placed along the track.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Building Placement")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Building Placement")
     TArray<FDestructibleBuildingAsset> BuildingAssets;
 
-    // The distance between each potential building placement along the spline.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Building Placement", meta = (ClampMin = "100.0"))
+    // The closest two buildings can stand to each other. Both sides of the track are filled with buildings at least
+    // this far apart, so keep it above the widest building's footprint.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Building Placement", meta = (ClampMin = "100.0"))
     float BuildingSpacing = 2000.0f;
 
     // The minimum distance a building can be placed from the edge of the track.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Building Placement", meta = (ClampMin = "0.0"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Building Placement", meta = (ClampMin = "0.0"))
     float BuildingSideOffsetMin = 200.0f;
 
     // The maximum distance a building can be placed from the edge of the track.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Building Placement", meta = (ClampMin = "0.0"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Building Placement", meta = (ClampMin = "0.0"))
     float BuildingSideOffsetMax = 1000.0f;
 
+    // Destructible actors spawned hidden per building type at BeginPlay (server), handed out to instances that take damage.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Building Placement", meta = (ClampMin = "0"))
+    int32 DestructiblePoolSize = 2;
+
+    // Game thread time GenerateAsync spends per frame committing mesh chunks and spawning buildings. At least one of
+    // either is done every frame regardless.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Generation", meta = (ClampMin = "0.1"))
+    float AsyncGenerationBudgetMs = 4.0f;
+
     // --- Editor Functions ---
 
-    // Main function to generate the entire track and place buildings.
+    // Main function to generate the entire track and place buildings. Reads the track back from Saved/TrackCache when
+    // the same seed and settings were generated before (Pod.Track.Cache).
     UFUNCTION(CallInEditor, Category = "Procedural Generation")
     void Generate();
 
+    // Generates the track like Generate, but computes the spline, samples and mesh buffers on worker threads and commits
+    // mesh chunks and spawns buildings over several frames within AsyncGenerationBudgetMs. Starting again or calling
+    // Generate, RebuildTrackMesh or ClearAll cancels a run in progress. The settings are copied when the run starts, but
+    // the spline must not be edited while it is in progress.
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Procedural Generation")
+    void GenerateAsync();
+
+    // Stops an async run. Whatever it has already committed or spawned stays.
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Procedural Generation")
+    void CancelGeneration();
+
+    UFUNCTION(BlueprintPure, Category = "Procedural Generation")
+    bool IsGenerating() const { return GenerationJob.IsValid(); }
+
+    // 0 to 1 through the current (or last) async run.
+    UFUNCTION(BlueprintPure, Category = "Procedural Generation")
+    float GetGenerationProgress() const { return GenerationProgress; }
+
+    UPROPERTY(BlueprintAssignable, Category = "Procedural Generation")
+    FOnTrackGenerationProgress OnGenerationProgress;
+
+    // Fires when an async run finishes, with bCompleted false when it was cancelled.
+    UPROPERTY(BlueprintAssignable, Category = "Procedural Generation")
+    FOnTrackGenerationFinished OnGenerationFinished;
+
     // Clears all generated components (track mesh and buildings).
     UFUNCTION(CallInEditor, Category = "Procedural Generation")
     void ClearAll();
 
+    // Rebuilds the road from the current spline, e.g. after moving its points by hand. Only chunks whose road changed
+    // are recooked.
+    UFUNCTION(CallInEditor, Category = "Procedural Generation")
+    void RebuildTrackMesh();
+
+    // Point and radial damage that deals a building instance at least its asset's DestroyDamage promotes it and destroys
+    // it. Radial damage falls off per instance with the distance to its bounds and is stopped by Visibility blockers
+    // between the origin and the instance.
+    virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
+
+    // Buildings whose placement point is within Radius of Location, ignoring height. Only the cells of the building
+    // hash the radius touches are looked at. On clients, buildings spawned as actors are the server's and not listed.
+    void FindBuildingsNear(const FVector& Location, float Radius, TArray<FTrackPlacedBuilding>& OutBuildings) const;
+
+    // Checksum of the server's track, 0 when it has none.
+    uint32 GetTrackChecksum() const { return TrackChecksum; }
+
+    // Swaps one intact building instance for a destructible actor from the pool. Server only, returns null when the
+    // instance is gone or already promoted.
+    ADestructibleBuildingActor* PromoteBuildingInstance(int32 AssetIndex, int32 InstanceIndex);
+
+    // Hides an instance whose building has been promoted. Clients call this when the promoted actor replicates, which
+    // can be before they've built the track, so it is remembered until the instance is placed.
+    void HideBuildingInstance(int32 AssetIndex, int32 InstanceIndex);
+
+    // Baked from the spline whenever this actor changes it. Distance lookups against it skip the spline's own
+    // reparameterization, for race progress, AI and anything else that walks the track by distance.
+    const FTrackArcLengthTable& GetArcLengthTable() const { return ArcLengthTable; }
+
+    // World transform of the road centre line at Distance along the track (X along it, Z up), from the arc-length table.
+    UFUNCTION(BlueprintPure, Category = "Track")
+    FTransform GetTrackTransformAtDistance(float Distance) const;
+
+    // Left and right road edges in world space at every sample the mesh builder uses, so the
+    // ribbon they describe is exactly the generated collision surface.
+    void GetSurfaceSamples(TArray<float>& OutDistances, TArray<FVector>& OutLeftEdges, TArray<FVector>& OutRightEdges) const;
+
 private:
+    // First surface row of each spline segment, then the last row, which sits on the end of the spline. A segment gets
+    // evenly spaced rows, as many as its turning needs at TrackRowAngle, so editing a point only changes the rows of
+    // the segments it shapes.
+    void ComputeSegmentFirstRows(const FTrackBuildSettings& Settings, TArray<int32>& OutFirstRows) const;
+
+    // Evaluates every LOD 0 surface row, in parallel.
+    void EvaluateSurfaceSamples(const FTrackBuildSettings& Settings, TArray<FTrackSurfaceSample>& OutSamples) const;
+
+    // Copies the current settings for the generation stages.
+    FTrackBuildSettings CaptureBuildSettings() const;
+
+    void BakeArcLengthTable();
+
+    // The baked table when it matches the spline, otherwise Scratch built from it (the spline was changed some other way).
+    const FTrackArcLengthTable& GetCurrentArcLengthTable(FTrackArcLengthTable& Scratch) const;
+
+    // Key of this track in the track cache: the seed, every other generation setting and the actor's transform.
+    uint64 ComputeTrackCacheKey() const;
+
+    // Checksum of the control points and building placements, 0 when there is no track.
+    uint32 ComputeTrackChecksum() const;
+
+    // Publishes the checksum of what was just generated (server), or checks it against the server's (clients). A client
+    // that doesn't match regenerates once, then reports it to the server and on screen.
+    void UpdateTrackChecksum();
+
+    // Generates (or clears) the track locally when it doesn't match the server's.
+    UFUNCTION()
+    void OnRep_TrackChecksum();
+
+    // Hands the current spline to the world's track surface subsystem (or removes it when the track is cleared).
+    void UpdateSurfaceRegistration();
+
     // Helper function to generate the spline control points.
     void GenerateSplinePoints(FRandomStream& Stream);
 
-    // Helper function to build the track mesh from the spline.
+    // Control point locations only, without touching the spline, so it can run on a worker.
+    void ComputeSplinePoints(const FTrackBuildSettings& Settings, FRandomStream& Stream, const FVector& StartLocation, TArray<FVector>& OutPoints) const;
+
+    // Replaces the spline's points with Points and closes the loop.
+    void ApplySplinePoints(const TArray<FVector>& Points);
+
+    // Helper function to build the track mesh chunks from the spline.
     void GenerateTrackMesh();
+
+    // Samples the spline and builds every chunk's buffers. Only reads the spline, so it can run on a worker. Stops early,
+    // leaving the buffers unfinished, once bCancelled is set.
+    void BuildTrackChunks(const FTrackBuildSettings& Settings, TArray<FTrackChunkBuffers>& OutBuffers, TArray<int32>& OutFirstRows, const std::atomic<bool>* bCancelled = nullptr) const;
+
+    // Matches the chunk components to the new chunk rows, dropping any past the end. Call before CommitTrackChunk.
+    void ResizeTrackChunks(const TArray<int32>& FirstRows);
+
+    // Creates the chunk's section and cooks its collision, unless it came out the same as last time.
+    void CommitTrackChunk(int32 Chunk, const FTrackChunkBuffers& Buffers);
+
+    // Splits the surface rows into chunks of about TrackChunkLength, breaking only on spline points.
+    void ComputeTrackChunkRows(const FTrackBuildSettings& Settings, const TArray<FTrackSurfaceSample>& Samples, TArray<int32>& OutFirstRows) const;
+
+    UProceduralMeshComponent* CreateTrackChunk();
+    void DestroyTrackChunks();
+
+    // Removes every building instance, destroys previously spawned buildings and returns promoted ones to the pool.
+    void ClearBuildings();
+
+    // Destroys the instanced components and the pool as well.
+    void DestroyBuildingInstances();
     
-    // Helper function to place buildings along the track.
-    void PlaceBuildings(FRandomStream& Stream);
+    // Helper function to build the hover ground proxy slabs from the spline.
+    void GenerateGroundProxy();
+
+    // Draws where buildings go from Stream. Only reads the spline, so it can run on a worker. Stops early, leaving the
+    // placements unfinished, once bCancelled is set.
+    void ComputeBuildingPlacements(const FTrackBuildSettings& Settings, FRandomStream& Stream, TArray<FTrackBuildingPlacement>& OutPlacements, const std::atomic<bool>* bCancelled = nullptr) const;
+
+    // Instances (Pod.Track.InstancedBuildings) or actors for each placement.
+    void PlaceBuildings(TArrayView<const FTrackBuildingPlacement> Placements);
+
+    ADestructibleBuildingActor* SpawnBuilding(const FTrackBuildingPlacement& Placement);
+
+    // Refills the building hash from the instances and actors the track has, e.g. after loading a level.
+    void RebuildBuildingHash();
+    void AddPlacedBuilding(const FVector& Location, const FTrackPlacedBuilding& Building);
+
+    // Instanced component for the asset, created on first use. Null when the asset has no intact mesh.
+    UHierarchicalInstancedStaticMeshComponent* GetBuildingInstances(int32 AssetIndex);
+
+    // Pooled destructible of the asset's class moved to Transform, or a new one when the pool has none.
+    ADestructibleBuildingActor* AcquireDestructible(int32 AssetIndex, const FTransform& Transform);
+
+    // What a radial damage event deals one instance: BaseDamage scaled by the falloff at the distance from the origin
+    // to the instance's bounds, or nothing when out of range or when LineOfSightParams' trace is blocked.
+    float GetRadialDamageToInstance(const FRadialDamageEvent& RadialDamage, float BaseDamage, int32 AssetIndex, int32 InstanceIndex,
+        const FCollisionQueryParams& LineOfSightParams) const;
+
+    // Promotes and destroys the instance when Damage reaches its asset's DestroyDamage.
+    void DamageBuildingInstance(int32 AssetIndex, int32 InstanceIndex, float Damage);
+
+    void FillDestructiblePool();
+
+    // Advances the async run by one stage (or one frame of committing and spawning).
+    bool TickGeneration(float DeltaTime);
+
+    // GenerateAsync, optionally ignoring the track cache.
+    void StartGeneration(bool bUseCache);
+
+    // Ends the async run, waiting for its worker first. Returns false when none was running.
+    bool StopGeneration();
+
+    void SetGenerationProgress(float Progress);
+
+    // Shows the LOD of each road chunk that its screen size in the nearest local view calls for.
+    void UpdateTrackLODs();
 
     // References to spawned actors to allow for easy cleanup.
     UPROPERTY()
     TArray<AActor*> SpawnedBuildingActors;
+
+    // Instances swapped for destructibles, and destructibles waiting to be.
+    UPROPERTY()
+    TArray<ADestructibleBuildingActor*> PromotedBuildings;
+
+    UPROPERTY()
+    TArray<ADestructibleBuildingActor*> PooledDestructibles;
+
+    // Content checksum of the server's track. Clients generate from the seed until theirs matches it.
+    UPROPERTY(ReplicatedUsing = OnRep_TrackChecksum)
+    uint32 TrackChecksum = 0;
+
+    // Set on a client that regenerated after a mismatch, until it matches or the server's checksum changes.
+    bool bRegeneratedForChecksum = false;
+
+    // Placements folded in the order PlaceBuildings was given them, part of the track checksum.
+    UPROPERTY()
+    uint32 BuildingChecksum = 0;
+
+    // Every building on the track, and where each stands in the XY plane at the same index.
+    TArray<FTrackPlacedBuilding> PlacedBuildings;
+    FTrackSpatialHash BuildingHash;
+
+    // Instances to hide once placed, as (asset, instance) pairs.
+    TArray<FIntPoint> PendingHiddenInstances;
+
+    // Hash of the geometry each chunk was last built from, so a rebuild can skip chunks that came out the same.
+    UPROPERTY()
+    TArray<uint32> TrackChunkHashes;
+
+    // Hash of the UVs each chunk was last built with. A chunk whose geometry is unchanged gets new UVs in place.
+    UPROPERTY()
+    TArray<uint32> TrackChunkUVHashes;
+
+    // LOD each chunk is showing.
+    TArray<int32> TrackChunkLODs;
+
+    FTrackArcLengthTable ArcLengthTable;
+
+    TSharedPtr<FTrackGenerationJob> GenerationJob;
+    FTSTicker::FDelegateHandle GenerationTickerHandle;
+    float GenerationProgress = 0.0f;
+
+    friend struct FProceduralTrackMeshBench;
 };
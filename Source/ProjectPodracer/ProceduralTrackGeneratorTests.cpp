@@ -0,0 +1,604 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ProceduralTrackGenerator.h"
+#include "DestructibleBuildingActor.h"
+#include "PodTestWorld.h"
+#include "ProceduralMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/DamageEvents.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "PhysicsEngine/BodySetup.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ProceduralTrackGeneratorTests
+{
+	// Vertex positions of every section of every chunk, chunk by chunk
+	TArray<TArray<FVector>> GetSectionVertices(const AProceduralTrackGenerator* Track)
+	{
+		TArray<TArray<FVector>> Sections;
+		for (UProceduralMeshComponent* Chunk : Track->TrackChunks)
+		{
+			for (int32 SectionIndex = 0; SectionIndex < Chunk->GetNumSections(); ++SectionIndex)
+			{
+				TArray<FVector>& Vertices = Sections.AddDefaulted_GetRef();
+				for (const FProcMeshVertex& Vertex : Chunk->GetProcMeshSection(SectionIndex)->ProcVertexBuffer)
+				{
+					Vertices.Add(Vertex.Position);
+				}
+			}
+		}
+		return Sections;
+	}
+
+	// Generates Track and returns how long it took in milliseconds
+	double TimeGenerate(AProceduralTrackGenerator* Track)
+	{
+		const double Start = FPlatformTime::Seconds();
+		Track->Generate();
+		return (FPlatformTime::Seconds() - Start) * 1000.0;
+	}
+
+	// The track cache file written last, empty when there are none
+	FString FindNewestTrackCacheFile()
+	{
+		const FString Directory = FPaths::ProjectSavedDir() / TEXT("TrackCache");
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *(Directory / TEXT("*.track")), true, false);
+		FString Newest;
+		FDateTime NewestTime = FDateTime::MinValue();
+		for (const FString& File : Files)
+		{
+			const FString Path = Directory / File;
+			const FDateTime Time = IFileManager::Get().GetTimeStamp(*Path);
+			if (Time >= NewestTime)
+			{
+				Newest = Path;
+				NewestTime = Time;
+			}
+		}
+		return Newest;
+	}
+
+	// Destructible buildings standing in World, leaving out the ones parked in a pool, and what they take up
+	int32 CountBuildingActors(UWorld* World, SIZE_T& OutBytes)
+	{
+		int32 Count = 0;
+		OutBytes = 0;
+		for (TActorIterator<ADestructibleBuildingActor> It(World); It; ++It)
+		{
+			if (It->IsPooled())
+			{
+				continue;
+			}
+			++Count;
+			OutBytes += It->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			for (UActorComponent* Component : It->GetComponents())
+			{
+				OutBytes += Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			}
+		}
+		return Count;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrackParallelMeshTest, "ProjectPodracer.Track.ParallelMeshMatchesSerial",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Tracks of 10, 100 and 1000 points built on worker threads must come out vertex for vertex the same as built on one
+// thread. Reports both generation times
+bool FTrackParallelMeshTest::RunTest(const FString& Parameters)
+{
+	using namespace ProceduralTrackGeneratorTests;
+
+	FPodScopedConsoleVariable NoCache(TEXT("Pod.Track.Cache"), 0);
+	FPodTestWorld TestWorld;
+	for (const int32 NumberOfControlPoints : { 10, 100, 1000 })
+	{
+		AProceduralTrackGenerator* Track = TestWorld.SpawnTrack(NumberOfControlPoints);
+		if (!TestNotNull(TEXT("Track spawned"), Track))
+		{
+			return false;
+		}
+
+		double SerialMs = 0.0;
+		TArray<TArray<FVector>> SerialSections;
+		{
+			FPodScopedConsoleVariable SingleThread(TEXT("Pod.Track.ParallelMesh"), 0);
+			SerialMs = TimeGenerate(Track);
+			SerialSections = GetSectionVertices(Track);
+		}
+		// Unchanged chunks are skipped on commit, so start over for the second build to be committed in full too
+		Track->ClearAll();
+		const double ParallelMs = TimeGenerate(Track);
+		const TArray<TArray<FVector>> ParallelSections = GetSectionVertices(Track);
+
+		const FString Case = FString::Printf(TEXT("%d points"), NumberOfControlPoints);
+		TestTrue(FString::Printf(TEXT("%s has a road"), *Case), SerialSections.Num() > 0);
+		if (TestEqual(FString::Printf(TEXT("%s sections"), *Case), ParallelSections.Num(), SerialSections.Num()))
+		{
+			int32 DifferingSections = 0;
+			int32 NumVertices = 0;
+			for (int32 Index = 0; Index < SerialSections.Num(); ++Index)
+			{
+				DifferingSections += ParallelSections[Index] != SerialSections[Index];
+				NumVertices += SerialSections[Index].Num();
+			}
+			TestEqual(FString::Printf(TEXT("%s sections differing from the single thread build"), *Case), DifferingSections, 0);
+			AddInfo(FString::Printf(TEXT("%s, %d vertices: single thread %.3f ms, worker threads %.3f ms"), *Case, NumVertices, SerialMs, ParallelMs));
+		}
+		Track->ClearAll();
+		Track->Destroy();
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrackCacheTest, "ProjectPodracer.Track.CacheMatchesGenerated",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// A track read back from Saved/TrackCache must be the track the seed generates, and a damaged file must be generated
+// over rather than trusted. Reports generating against reading back
+bool FTrackCacheTest::RunTest(const FString& Parameters)
+{
+	using namespace ProceduralTrackGeneratorTests;
+
+	FPodTestWorld TestWorld;
+	AProceduralTrackGenerator* Track = TestWorld.SpawnTrack(100);
+	if (!TestNotNull(TEXT("Track spawned"), Track))
+	{
+		return false;
+	}
+
+	double ColdMs = 0.0;
+	{
+		FPodScopedConsoleVariable NoCache(TEXT("Pod.Track.Cache"), 0);
+		ColdMs = TimeGenerate(Track);
+	}
+	const TArray<TArray<FVector>> Generated = GetSectionVertices(Track);
+	TestTrue(TEXT("Track has a road"), Generated.Num() > 0);
+
+	// The first run writes the file unless an earlier session already did. Chunks whose hash is unchanged aren't
+	// committed again, and the cache stores the hashes, so every run starts over to build the road from what it read
+	FPodScopedConsoleVariable Cache(TEXT("Pod.Track.Cache"), 1);
+	Track->ClearAll();
+	const double WriteMs = TimeGenerate(Track);
+	TestTrue(TEXT("Writing the cache keeps the track"), GetSectionVertices(Track) == Generated);
+	Track->ClearAll();
+	TestTrue(TEXT("Clearing leaves no road"), GetSectionVertices(Track).Num() == 0);
+	const double ReadMs = TimeGenerate(Track);
+	TestTrue(TEXT("The cached track is the generated one"), GetSectionVertices(Track) == Generated);
+
+	const FString Filename = FindNewestTrackCacheFile();
+	if (!TestFalse(TEXT("Cache file written"), Filename.IsEmpty()))
+	{
+		return false;
+	}
+
+	// Magic, version and key take 16 bytes, then the spline point count, claimed far past the end of the file
+	TArray<uint8> Bytes;
+	if (TestTrue(TEXT("Cache file read"), FFileHelper::LoadFileToArray(Bytes, *Filename)) && TestTrue(TEXT("Cache file has a body"), Bytes.Num() > 20))
+	{
+		const int32 Count = MAX_int32;
+		FMemory::Memcpy(Bytes.GetData() + 16, &Count, sizeof(Count));
+		TestTrue(TEXT("Cache file damaged"), FFileHelper::SaveArrayToFile(Bytes, *Filename));
+
+		Track->ClearAll();
+		const double DamagedMs = TimeGenerate(Track);
+		TestTrue(TEXT("A damaged cache is generated over"), GetSectionVertices(Track) == Generated);
+		AddInfo(FString::Printf(TEXT("100 points: cache off %.3f ms, first with cache %.3f ms, read back %.3f ms, damaged file %.3f ms (%lld bytes)"),
+			ColdMs, WriteMs, ReadMs, DamagedMs, int64(Bytes.Num())));
+	}
+
+	IFileManager::Get().Delete(*Filename);
+	Track->ClearAll();
+	Track->Destroy();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrackInstancedBuildingsTest, "ProjectPodracer.Track.InstancedBuildings",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// The same buildings placed as actors and as instances, then one instance promoted to an actor and the track
+// generated again, which must park the actor in the pool where nothing sees or hits it. Reports the actors' time and
+// size against the instances'
+bool FTrackInstancedBuildingsTest::RunTest(const FString& Parameters)
+{
+	using namespace ProceduralTrackGeneratorTests;
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Cube mesh loaded"), Cube))
+	{
+		return false;
+	}
+
+	FPodScopedConsoleVariable NoCache(TEXT("Pod.Track.Cache"), 0);
+	FPodTestWorld TestWorld;
+	AProceduralTrackGenerator* Track = TestWorld.SpawnTrack();
+	if (!TestNotNull(TEXT("Track spawned"), Track))
+	{
+		return false;
+	}
+	FDestructibleBuildingAsset& Asset = Track->BuildingAssets.AddDefaulted_GetRef();
+	Asset.DestructibleActorClass = ADestructibleBuildingActor::StaticClass();
+	Asset.IntactMesh = Cube;
+
+	SIZE_T ActorBytes = 0;
+	int32 NumActors = 0;
+	double ActorsMs = 0.0;
+	{
+		FPodScopedConsoleVariable Actors(TEXT("Pod.Track.InstancedBuildings"), 0);
+		ActorsMs = TimeGenerate(Track);
+		NumActors = CountBuildingActors(TestWorld.World, ActorBytes);
+	}
+	if (!TestTrue(TEXT("Buildings placed as actors"), NumActors > 0))
+	{
+		return false;
+	}
+
+	FPodScopedConsoleVariable Instanced(TEXT("Pod.Track.InstancedBuildings"), 1);
+	const double InstancesMs = TimeGenerate(Track);
+	SIZE_T LeftoverBytes = 0;
+	TestEqual(TEXT("No building actors once instanced"), CountBuildingActors(TestWorld.World, LeftoverBytes), 0);
+	UHierarchicalInstancedStaticMeshComponent* Instances = Track->BuildingInstances.IsValidIndex(0) ? Track->BuildingInstances[0] : nullptr;
+	if (!TestNotNull(TEXT("Instanced component"), Instances))
+	{
+		return false;
+	}
+	TestEqual(TEXT("An instance per building"), Instances->GetInstanceCount(), NumActors);
+	AddInfo(FString::Printf(TEXT("%d buildings: actors %.3f ms, %.1f KB; instances %.3f ms, %.1f KB"), NumActors,
+		ActorsMs, ActorBytes / 1024.0, InstancesMs, Instances->GetResourceSizeBytes(EResourceSizeMode::Exclusive) / 1024.0));
+
+	ADestructibleBuildingActor* Promoted = Track->PromoteBuildingInstance(0, 0);
+	if (!TestNotNull(TEXT("Instance promoted"), Promoted))
+	{
+		return false;
+	}
+	TestFalse(TEXT("A promoted building is out of the pool"), Promoted->IsPooled());
+	TestFalse(TEXT("A promoted building is shown"), Promoted->IsHidden());
+	TestTrue(TEXT("A promoted building collides"), Promoted->GetActorEnableCollision());
+	TestNull(TEXT("An instance is only promoted once"), Track->PromoteBuildingInstance(0, 0));
+
+	Track->Generate();
+	TestTrue(TEXT("Generating again pools the promoted building"), Promoted->IsPooled());
+	TestTrue(TEXT("A pooled building is hidden"), Promoted->IsHidden());
+	TestFalse(TEXT("A pooled building doesn't collide"), Promoted->GetActorEnableCollision());
+
+	Track->ClearAll();
+	Track->Destroy();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrackChunkLODTest, "ProjectPodracer.Track.ChunkLODs",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Every chunk carries a section per LOD, each no denser than the one before, and only LOD 0 feeds collision. Reports
+// the vertices at each LOD and the generation time
+bool FTrackChunkLODTest::RunTest(const FString& Parameters)
+{
+	using namespace ProceduralTrackGeneratorTests;
+
+	FPodScopedConsoleVariable NoCache(TEXT("Pod.Track.Cache"), 0);
+	FPodTestWorld TestWorld;
+	AProceduralTrackGenerator* Track = TestWorld.SpawnTrack(100);
+	if (!TestNotNull(TEXT("Track spawned"), Track))
+	{
+		return false;
+	}
+	const double GenerateMs = TimeGenerate(Track);
+	if (!TestTrue(TEXT("Track has chunks"), Track->TrackChunks.Num() > 0))
+	{
+		return false;
+	}
+
+	const int32 NumLODs = Track->TrackLODScreenSizes.Num();
+	TArray<int32> LODVertices;
+	LODVertices.SetNumZeroed(NumLODs);
+	int32 WrongSectionCounts = 0;
+	int32 DenserLODs = 0;
+	int32 WrongCollision = 0;
+	for (UProceduralMeshComponent* Chunk : Track->TrackChunks)
+	{
+		if (Chunk->GetNumSections() != NumLODs)
+		{
+			++WrongSectionCounts;
+			continue;
+		}
+		for (int32 LOD = 0; LOD < NumLODs; ++LOD)
+		{
+			const FProcMeshSection* Section = Chunk->GetProcMeshSection(LOD);
+			LODVertices[LOD] += Section->ProcVertexBuffer.Num();
+			DenserLODs += LOD > 0 && Section->ProcVertexBuffer.Num() > Chunk->GetProcMeshSection(LOD - 1)->ProcVertexBuffer.Num();
+			WrongCollision += Section->bEnableCollision != (LOD == 0);
+		}
+	}
+	TestEqual(TEXT("Chunks without a section per LOD"), WrongSectionCounts, 0);
+	TestEqual(TEXT("LODs denser than the one before"), DenserLODs, 0);
+	TestEqual(TEXT("Sections with the wrong collision"), WrongCollision, 0);
+
+	FString Vertices;
+	for (int32 LOD = 0; LOD < NumLODs; ++LOD)
+	{
+		Vertices += FString::Printf(TEXT("%sLOD %d %d"), LOD > 0 ? TEXT(", ") : TEXT(""), LOD, LODVertices[LOD]);
+	}
+	AddInfo(FString::Printf(TEXT("100 points, %d chunks in %.3f ms: %s vertices"), Track->TrackChunks.Num(), GenerateMs, *Vertices));
+
+	Track->ClearAll();
+	Track->Destroy();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrackSimpleCollisionTest, "ProjectPodracer.Track.SimpleCollision",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// With bSimpleTrackCollision the road's simple collision is convex slabs, which sweeps land on, while complex traces
+// still get the road's triangles. Reports generating with collision cooked in place against cooked async
+bool FTrackSimpleCollisionTest::RunTest(const FString& Parameters)
+{
+	using namespace ProceduralTrackGeneratorTests;
+
+	FPodScopedConsoleVariable NoCache(TEXT("Pod.Track.Cache"), 0);
+	FPodTestWorld TestWorld;
+	AProceduralTrackGenerator* Track = TestWorld.SpawnTrack(100);
+	if (!TestNotNull(TEXT("Track spawned"), Track))
+	{
+		return false;
+	}
+	Track->bSimpleTrackCollision = true;
+
+	// Chunks copy the track mesh's cooking mode when they're created, and unchanged chunks aren't committed again, so
+	// each run starts from a cleared track. The cooked in place run goes last, leaving collision ready to query
+	Track->TrackMesh->bUseAsyncCooking = true;
+	const double AsyncMs = TimeGenerate(Track);
+	Track->ClearAll();
+	Track->TrackMesh->bUseAsyncCooking = false;
+	const double SyncMs = TimeGenerate(Track);
+	AddInfo(FString::Printf(TEXT("100 points, %d chunks: cooked in place %.3f ms, async %.3f ms"), Track->TrackChunks.Num(), SyncMs, AsyncMs));
+
+	int32 ChunksWithoutSlabs = 0;
+	int32 ChunksNotCooked = 0;
+	for (UProceduralMeshComponent* Chunk : Track->TrackChunks)
+	{
+		const UBodySetup* BodySetup = Chunk->GetBodySetup();
+		ChunksWithoutSlabs += !BodySetup || BodySetup->AggGeom.ConvexElems.Num() == 0;
+		ChunksNotCooked += Chunk->bUseAsyncCooking || !BodySetup || !BodySetup->bCreatedPhysicsMeshes;
+	}
+	TestEqual(TEXT("Chunks without convex slabs"), ChunksWithoutSlabs, 0);
+	if (!TestEqual(TEXT("Chunks whose collision isn't cooked yet"), ChunksNotCooked, 0))
+	{
+		return false;
+	}
+
+	TArray<float> Distances;
+	TArray<FVector> LeftEdges, RightEdges;
+	Track->GetSurfaceSamples(Distances, LeftEdges, RightEdges);
+	const FVector Down(0.f, 0.f, -600.f);
+	FCollisionQueryParams SimpleParams(SCENE_QUERY_STAT(TrackSimpleCollisionTest), false);
+	FCollisionQueryParams ComplexParams(SCENE_QUERY_STAT(TrackSimpleCollisionTest), true);
+	ComplexParams.bReturnFaceIndex = true;
+	int32 Probes = 0;
+	int32 SweepMisses = 0;
+	int32 ComplexMisses = 0;
+	for (int32 Row = 0; Row < LeftEdges.Num(); Row += 8)
+	{
+		const FVector Start = (LeftEdges[Row] + RightEdges[Row]) * 0.5f + FVector(0.f, 0.f, 300.f);
+		++Probes;
+
+		FHitResult Hit;
+		SweepMisses += !TestWorld.World->SweepSingleByChannel(Hit, Start, Start + Down, FQuat::Identity, ECC_WorldStatic,
+			FCollisionShape::MakeSphere(50.f), SimpleParams) || !Track->TrackChunks.Contains(Hit.GetComponent());
+		ComplexMisses += !TestWorld.World->LineTraceSingleByChannel(Hit, Start, Start + Down, ECC_WorldStatic, ComplexParams)
+			|| !Track->TrackChunks.Contains(Hit.GetComponent()) || Hit.FaceIndex == INDEX_NONE;
+	}
+	TestTrue(TEXT("Road probed"), Probes > 0);
+	TestEqual(TEXT("Sweeps missing the road"), SweepMisses, 0);
+	TestEqual(TEXT("Complex traces missing the road's triangles"), ComplexMisses, 0);
+
+	Track->ClearAll();
+	Track->Destroy();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrackBuildingPlacementTest, "ProjectPodracer.Track.BuildingPlacement",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Placed buildings keep BuildingSpacing from each other and clear of the road, and FindBuildingsNear finds exactly the
+// buildings a search through all of them does. Reports the lookup against that search
+bool FTrackBuildingPlacementTest::RunTest(const FString& Parameters)
+{
+	using namespace ProceduralTrackGeneratorTests;
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Cube mesh loaded"), Cube))
+	{
+		return false;
+	}
+
+	FPodScopedConsoleVariable NoCache(TEXT("Pod.Track.Cache"), 0);
+	FPodScopedConsoleVariable Instanced(TEXT("Pod.Track.InstancedBuildings"), 1);
+	FPodTestWorld TestWorld;
+	AProceduralTrackGenerator* Track = TestWorld.SpawnTrack(100);
+	if (!TestNotNull(TEXT("Track spawned"), Track))
+	{
+		return false;
+	}
+	// Only types with a destructible actor are placed, the instances draw the cube
+	FDestructibleBuildingAsset& Asset = Track->BuildingAssets.AddDefaulted_GetRef();
+	Asset.DestructibleActorClass = ADestructibleBuildingActor::StaticClass();
+	Asset.IntactMesh = Cube;
+	Track->Generate();
+
+	const UHierarchicalInstancedStaticMeshComponent* Instances = Track->BuildingInstances.IsValidIndex(0) ? Track->BuildingInstances[0] : nullptr;
+	if (!TestNotNull(TEXT("Instanced component"), Instances) || !TestTrue(TEXT("Buildings placed"), Instances->GetInstanceCount() > 1))
+	{
+		return false;
+	}
+	TArray<FVector2D> Buildings;
+	for (int32 Instance = 0; Instance < Instances->GetInstanceCount(); ++Instance)
+	{
+		FTransform Transform;
+		Instances->GetInstanceTransform(Instance, Transform, true);
+		Buildings.Add(FVector2D(Transform.GetLocation()));
+	}
+
+	// Locations are quantized and instances store them relative to the component, so allow a centimetre
+	constexpr double Tolerance = 1.0;
+	const float Spacing = Track->BuildingSpacing;
+	int32 Crowded = 0;
+	for (const FVector2D& Building : Buildings)
+	{
+		TArray<FTrackPlacedBuilding> Nearby;
+		Track->FindBuildingsNear(FVector(Building, 0.0), Spacing - Tolerance, Nearby);
+		Crowded += Nearby.Num() != 1;
+	}
+	TestEqual(TEXT("Buildings closer than BuildingSpacing to another"), Crowded, 0);
+
+	// The road as placement sees it, the centre line at every arc-length table entry
+	const FTrackArcLengthTable& Table = Track->GetArcLengthTable();
+	const FTransform SplineTransform = Track->TrackSpline->GetComponentTransform();
+	const double InnerOffset = FMath::Max(Track->TrackWidth / 2 + Track->BuildingSideOffsetMin, 1.0f);
+	int32 OnTheRoad = 0;
+	for (const FVector2D& Building : Buildings)
+	{
+		double Closest = TNumericLimits<double>::Max();
+		for (int32 Entry = 0; Entry < Table.Num(); ++Entry)
+		{
+			FVector Location, Direction, UpVector;
+			Table.Sample(Entry * Table.GetLength() / (Table.Num() - 1), Location, Direction, UpVector);
+			Closest = FMath::Min(Closest, FVector2D::Distance(Building, FVector2D(SplineTransform.TransformPosition(Location))));
+		}
+		OnTheRoad += Closest < InnerOffset - Tolerance;
+	}
+	TestEqual(TEXT("Buildings within the road's inner offset"), OnTheRoad, 0);
+
+	// Off the buildings themselves, so nothing sits on the edge of a search
+	const float Radius = Spacing * 2.5f;
+	const FVector2D QueryOffset(333.0, 777.0);
+	int32 Mismatches = 0;
+	double HashSeconds = 0.0;
+	double BruteForceSeconds = 0.0;
+	for (const FVector2D& Building : Buildings)
+	{
+		const FVector2D Centre = Building + QueryOffset;
+		TArray<FTrackPlacedBuilding> Nearby;
+		double Start = FPlatformTime::Seconds();
+		Track->FindBuildingsNear(FVector(Centre, 0.0), Radius, Nearby);
+		HashSeconds += FPlatformTime::Seconds() - Start;
+
+		TArray<int32> Expected;
+		Start = FPlatformTime::Seconds();
+		for (int32 Other = 0; Other < Buildings.Num(); ++Other)
+		{
+			if (FVector2D::DistSquared(Centre, Buildings[Other]) <= FMath::Square(Radius))
+			{
+				Expected.Add(Other);
+			}
+		}
+		BruteForceSeconds += FPlatformTime::Seconds() - Start;
+
+		TArray<int32> Found;
+		for (const FTrackPlacedBuilding& Placed : Nearby)
+		{
+			Found.Add(Placed.InstanceIndex);
+		}
+		Found.Sort();
+		Mismatches += Found != Expected;
+	}
+	TestEqual(TEXT("Lookups differing from a search through every building"), Mismatches, 0);
+	AddInfo(FString::Printf(TEXT("%d buildings, %.0f cm radius: hash %.3f us/lookup, every building %.3f us/lookup"),
+		Buildings.Num(), Radius, HashSeconds * 1.0e6 / Buildings.Num(), BruteForceSeconds * 1.0e6 / Buildings.Num()));
+
+	Track->ClearAll();
+	Track->Destroy();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrackRadialDamageTest, "ProjectPodracer.Track.RadialDamageFalloff",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Radial damage falls off per instance: a blast too weak for DestroyDamage leaves every building standing, and a full
+// one destroys the building it goes off in but none that its falloff leaves under DestroyDamage
+bool FTrackRadialDamageTest::RunTest(const FString& Parameters)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Cube mesh loaded"), Cube))
+	{
+		return false;
+	}
+
+	FPodScopedConsoleVariable NoCache(TEXT("Pod.Track.Cache"), 0);
+	FPodScopedConsoleVariable Instanced(TEXT("Pod.Track.InstancedBuildings"), 1);
+	FPodTestWorld TestWorld;
+	AProceduralTrackGenerator* Track = TestWorld.SpawnTrack(100);
+	if (!TestNotNull(TEXT("Track spawned"), Track))
+	{
+		return false;
+	}
+	constexpr float DestroyDamage = 50.f;
+	FDestructibleBuildingAsset& Asset = Track->BuildingAssets.AddDefaulted_GetRef();
+	Asset.DestructibleActorClass = ADestructibleBuildingActor::StaticClass();
+	Asset.IntactMesh = Cube;
+	Asset.DestroyDamage = DestroyDamage;
+	Track->Generate();
+
+	const UHierarchicalInstancedStaticMeshComponent* Instances = Track->BuildingInstances.IsValidIndex(0) ? Track->BuildingInstances[0] : nullptr;
+	if (!TestNotNull(TEXT("Instanced component"), Instances) || !TestTrue(TEXT("Buildings placed"), Instances->GetInstanceCount() > 1))
+	{
+		return false;
+	}
+	TArray<FBox> Bounds;
+	for (int32 Instance = 0; Instance < Instances->GetInstanceCount(); ++Instance)
+	{
+		FTransform Transform;
+		Instances->GetInstanceTransform(Instance, Transform, true);
+		Bounds.Add(Cube->GetBounds().GetBox().TransformBy(Transform));
+	}
+	auto IsStanding = [Instances](int32 Instance)
+	{
+		FTransform Transform;
+		Instances->GetInstanceTransform(Instance, Transform, true);
+		return !Transform.GetScale3D().IsNearlyZero();
+	};
+
+	FRadialDamageEvent Blast;
+	Blast.Origin = Bounds[0].GetCenter();
+	Blast.Params.MinimumDamage = 0.f;
+	Blast.Params.InnerRadius = 0.f;
+	Blast.Params.OuterRadius = 3.f * Track->BuildingSpacing;
+	Blast.Params.DamageFalloff = 1.f;
+
+	Blast.Params.BaseDamage = 0.8f * DestroyDamage;
+	Track->TakeDamage(Blast.Params.BaseDamage, Blast, nullptr, nullptr);
+	int32 Destroyed = 0;
+	for (int32 Instance = 0; Instance < Bounds.Num(); ++Instance)
+	{
+		Destroyed += !IsStanding(Instance);
+	}
+	TestEqual(TEXT("Buildings destroyed by a blast under DestroyDamage"), Destroyed, 0);
+
+	Blast.Params.BaseDamage = 2.f * DestroyDamage;
+	Track->TakeDamage(Blast.Params.BaseDamage, Blast, nullptr, nullptr);
+	TestFalse(TEXT("The building the blast goes off in is destroyed"), IsStanding(0));
+	int32 InRange = 0;
+	int32 DestroyedUnderThreshold = 0;
+	for (int32 Instance = 1; Instance < Bounds.Num(); ++Instance)
+	{
+		const float Distance = FMath::Sqrt(Bounds[Instance].ComputeSquaredDistanceToPoint(Blast.Origin));
+		const float Damage = Blast.Params.BaseDamage * Blast.Params.GetDamageScale(Distance);
+		InRange += Distance < Blast.Params.OuterRadius;
+		DestroyedUnderThreshold += Damage < DestroyDamage && !IsStanding(Instance);
+	}
+	TestEqual(TEXT("Buildings destroyed with falloff damage under DestroyDamage"), DestroyedUnderThreshold, 0);
+	AddInfo(FString::Printf(TEXT("%d of %d other buildings within the outer radius"), InRange, Bounds.Num() - 1));
+
+	Track->ClearAll();
+	Track->Destroy();
+	return true;
+}
+
+#endif
@@ -9,6 +9,6 @@ public class ProjectPodracer : ModuleRules
 		PrivateDependencyModuleNames.AddRange(new string[] { "EnhancedInput", "ProceduralMeshComponent" });
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "OnlineSubsystem", "OnlineSubsystemUtils", "ChaosVehicles", "PhysicsCore", "GeometryCollectionEngine" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "OnlineSubsystem", "OnlineSubsystemUtils", "ChaosVehicles", "Chaos", "PhysicsCore", "GeometryCollectionEngine" });
 	}
 }
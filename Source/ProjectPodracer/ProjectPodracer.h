@@ -3,3 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+// Trace channel for hover ground probes (DefaultEngine.ini, ignored by default). Only hover proxies using the
+// PodGroundProxy collision profile block it, so probes never touch render geometry
+#define ECC_PodGround ECC_GameTraceChannel1
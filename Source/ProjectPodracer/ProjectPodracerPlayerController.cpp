@@ -6,6 +6,7 @@
 #include "ProjectPodracerUI.h"
 #include "EnhancedInputSubsystems.h"
 #include "ChaosWheeledVehicleMovementComponent.h"
+#include "ProceduralTrackGenerator.h"
 
 void AProjectPodracerPlayerController::BeginPlay()
 {
@@ -55,3 +56,10 @@ void AProjectPodracerPlayerController::OnPossess(APawn* InPawn)
 	// get a pointer to the controlled pawn
 	VehiclePawn = CastChecked<AProjectPodracerPawn>(InPawn);
 }
+
+void AProjectPodracerPlayerController::ServerReportTrackMismatch_Implementation(AProceduralTrackGenerator* Track, uint32 ClientChecksum)
+{
+	// the client races on different ground than everyone else, leave it to the server's logs and whoever hosts
+	UE_LOG(LogTemp, Error, TEXT("%s: track %s came out as %08X on their client, the server's is %08X"), *GetName(),
+		Track ? *Track->GetName() : TEXT("(unknown)"), ClientChecksum, Track ? Track->GetTrackChecksum() : 0u);
+}
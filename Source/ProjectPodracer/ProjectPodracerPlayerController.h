@@ -9,6 +9,7 @@
 class UInputMappingContext;
 class AProjectPodracerPawn;
 class UProjectPodracerUI;
+class AProceduralTrackGenerator;
 
 /**
  *  Vehicle Player Controller class
@@ -65,4 +66,10 @@ protected:
 	virtual void OnPossess(APawn* InPawn) override;
 
 	// End PlayerController interface
+
+public:
+
+	/** Sent by a client whose generated track still doesn't match the server's after regenerating it */
+	UFUNCTION(Server, Reliable)
+	void ServerReportTrackMismatch(AProceduralTrackGenerator* Track, uint32 ClientChecksum);
 };
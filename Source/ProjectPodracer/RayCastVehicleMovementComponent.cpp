@@ -4,10 +4,46 @@
 #include "RayCastVehicleMovementComponent.h"
 #include "ReplicatedSimRayCastVehicle.h"
 #include "Components/BoxComponent.h"
+#include "DrawDebugHelpers.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "Net/UnrealNetwork.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("RayCast vehicle physics mode changes"), STAT_PodRayCastPhysicsModeChanges, STATGROUP_PodGround);
+
+namespace RayCastVehicleMovement
+{
+	// Brings back the SetSimulatePhysics toggle so Pod.RayCastVehicle.PhysicsModeStats can be compared against it
+	static int32 GToggleSimulatePhysics = 0;
+	static FAutoConsoleVariableRef CVarToggleSimulatePhysics(
+		TEXT("Pod.RayCastVehicle.ToggleSimulatePhysics"),
+		GToggleSimulatePhysics,
+		TEXT("Hold grounded ray cast vehicles by switching physics simulation off (old behaviour, rebuilds the body) instead of disabling gravity"));
+
+	static uint64 GTotalModeChanges = 0;
+	static double GModeChangesSince = FPlatformTime::Seconds();
+
+#if !UE_BUILD_SHIPPING
+	static void PhysicsModeStatsCommand(const TArray<FString>& Args)
+	{
+		const double Elapsed = FPlatformTime::Seconds() - GModeChangesSince;
+		UE_LOG(LogTemp, Display, TEXT("Pod.RayCastVehicle.PhysicsModeStats: %llu changes in %.1fs, %.1f/s (%s)"),
+			GTotalModeChanges, Elapsed, Elapsed > 0.0 ? GTotalModeChanges / Elapsed : 0.0,
+			GToggleSimulatePhysics ? TEXT("SetSimulatePhysics") : TEXT("gravity"));
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			GTotalModeChanges = 0;
+			GModeChangesSince = FPlatformTime::Seconds();
+		}
+	}
+
+	static FAutoConsoleCommand PhysicsModeStatsCmd(
+		TEXT("Pod.RayCastVehicle.PhysicsModeStats"),
+		TEXT("Log how often ray cast vehicles switched between hovering and falling since startup or the last 'reset'"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&PhysicsModeStatsCommand));
+#endif
+}
+
 
 // Sets default values for this component's properties
 URayCastVehicleMovementComponent::URayCastVehicleMovementComponent()
@@ -56,7 +92,8 @@ void URayCastVehicleMovementComponent::TickComponent(float DeltaTime, ELevelTick
 	if (!BoxCollider)
 		return;
 
-	// Sub-stepping for stability
+	// Sub-stepping for stability. The ground barely moves within a frame, so one trace serves every substep
+	TraceGroundPlane();
 	const float SubStepTime = DeltaTime / 4.f;
 	for (int32 i = 0; i < 4; ++i)
 	{
@@ -101,30 +138,95 @@ void URayCastVehicleMovementComponent::PerformMovement(float DeltaTime)
 	MaintainHoverHeight(DeltaTime);
 	ApplyInputs(DeltaTime);
 }
-void URayCastVehicleMovementComponent::MaintainHoverHeight(float DeltaTime)
+void URayCastVehicleMovementComponent::TraceGroundPlane()
 {
 	if (!BoxCollider) return;
-	FVector Start = BoxCollider->GetComponentLocation();
-	FVector End = Start - FVector(0, 0, TargetHoverHeight + 100.f);
+	const FVector Start = BoxCollider->GetComponentLocation();
+	const FVector End = Start - FVector(0, 0, TargetHoverHeight + 100.f);
+	const FCollisionQueryParams QueryParams(PodQueryStats::Tag(EPodQueryClass::RayCastVehicle), SCENE_QUERY_STAT_ONLY(RayCastVehicleGround), false, GetOwner());
 
 	FHitResult HitResult;
-	TArray<AActor*> ActorsToIgnore;
-	ActorsToIgnore.Add(GetOwner());
+	bHasGroundPlane = PodGroundProbe::LineTrace(GetWorld(), GroundContactCache, HitResult, Start, End, ECC_PodGround, QueryParams);
+	if (bHasGroundPlane)
+	{
+		GroundPlanePoint = HitResult.Location;
+		GroundPlaneNormal = HitResult.Normal;
+	}
+	bIsOnGround = bHasGroundPlane && HitResult.Distance <= TargetHoverHeight + 50.f;
 
-	bool bHit = UKismetSystemLibrary::LineTraceSingle(
-		GetWorld(), Start, End, UEngineTypes::ConvertToTraceType(ECC_Visibility),
-		false, ActorsToIgnore, bDrawDebug ? EDrawDebugTrace::ForOneFrame : EDrawDebugTrace::None, HitResult, true);
+#if ENABLE_DRAW_DEBUG
+	if (bDrawDebug)
+	{
+		DrawDebugLine(GetWorld(), Start, bHasGroundPlane ? FVector(HitResult.ImpactPoint) : End, FColor::Red, false, 0.0f);
+		if (bHasGroundPlane)
+		{
+			DrawDebugLine(GetWorld(), HitResult.ImpactPoint, End, FColor::Green, false, 0.0f);
+			DrawDebugPoint(GetWorld(), HitResult.ImpactPoint, 16.0f, FColor::Red, false, 0.0f);
+		}
+	}
+#endif
+}
 
-	if (bHit && HitResult.bBlockingHit && HitResult.Distance <= TargetHoverHeight + 50.f)
+bool URayCastVehicleMovementComponent::GetHeightAboveGround(const FVector& Location, float& OutHeight) const
+{
+	// A near-vertical plane is a wall, it has no height to hover at
+	if (!bHasGroundPlane || GroundPlaneNormal.Z < UE_KINDA_SMALL_NUMBER)
 	{
-		BoxCollider->SetSimulatePhysics(false);
-		FVector TargetLocation = HitResult.Location + FVector(0, 0, TargetHoverHeight);
-		BoxCollider->SetWorldLocation(TargetLocation);
+		return false;
+	}
+
+	// Where the vertical through Location meets the plane traced this frame
+	const FVector Offset = Location - GroundPlanePoint;
+	const float GroundZ = GroundPlanePoint.Z - (GroundPlaneNormal.X * Offset.X + GroundPlaneNormal.Y * Offset.Y) / GroundPlaneNormal.Z;
+	OutHeight = Location.Z - GroundZ;
+	return OutHeight >= 0.f && OutHeight <= TargetHoverHeight + 100.f;
+}
+
+void URayCastVehicleMovementComponent::SetHoverLocked(bool bLocked)
+{
+	if (RayCastVehicleMovement::GToggleSimulatePhysics)
+	{
+		if (BoxCollider->IsSimulatingPhysics() == bLocked)
+		{
+			INC_DWORD_STAT(STAT_PodRayCastPhysicsModeChanges);
+			++RayCastVehicleMovement::GTotalModeChanges;
+			BoxCollider->SetSimulatePhysics(!bLocked);
+		}
+		bHoverLocked = bLocked;
+		return;
+	}
+
+	// Coming back from the old toggle with the cvar flipped at runtime
+	if (!BoxCollider->IsSimulatingPhysics())
+	{
+		BoxCollider->SetSimulatePhysics(true);
+	}
+
+	if (bHoverLocked != bLocked)
+	{
+		INC_DWORD_STAT(STAT_PodRayCastPhysicsModeChanges);
+		++RayCastVehicleMovement::GTotalModeChanges;
+		BoxCollider->SetEnableGravity(!bLocked);
+		bHoverLocked = bLocked;
+	}
+}
+
+void URayCastVehicleMovementComponent::MaintainHoverHeight(float DeltaTime)
+{
+	if (!BoxCollider) return;
+	const FVector Location = BoxCollider->GetComponentLocation();
+
+	float Height;
+	if (GetHeightAboveGround(Location, Height) && Height <= TargetHoverHeight + 50.f)
+	{
+		SetHoverLocked(true);
+		const FVector TargetLocation(Location.X, Location.Y, Location.Z - Height + TargetHoverHeight);
+		BoxCollider->SetWorldLocation(TargetLocation, false, nullptr, ETeleportType::TeleportPhysics);
 		BoxCollider->SetPhysicsLinearVelocity(FVector(BoxCollider->GetPhysicsLinearVelocity().X, BoxCollider->GetPhysicsLinearVelocity().Y, 0.f));
 	}
 	else
 	{
-		BoxCollider->SetSimulatePhysics(true);
+		SetHoverLocked(false);
 	}
 
 	Acceleration = FMath::Lerp(0.f, MaxAcceleration, FMath::Abs(AccelerationInput)) * AccelerationInput;
@@ -159,17 +261,8 @@ void URayCastVehicleMovementComponent::StartDrift() { bIsDrifting = true; Steeri
 
 void URayCastVehicleMovementComponent::StopDrift() { bIsDrifting = false; SteeringMultiplier = 2.0f; }
 
-bool URayCastVehicleMovementComponent::IsOnGround() const
-{
-	FHitResult HitResult; TArray<AActor*> ActorsToIgnore; ActorsToIgnore.Add(GetOwner());
-	FVector Start = GetOwner()->GetActorLocation();
-	FVector End = Start - FVector(0, 0, TargetHoverHeight + 50.f);
-
-	bool bHit = UKismetSystemLibrary::LineTraceSingle(
-		GetWorld(), Start, End, UEngineTypes::ConvertToTraceType(ECC_Visibility),
-		false, ActorsToIgnore, bDrawDebug ? EDrawDebugTrace::ForOneFrame : EDrawDebugTrace::None, HitResult, true);
-	return bHit && HitResult.bBlockingHit && HitResult.Distance <= TargetHoverHeight + 50.f;
-}
+// From this frame's ground trace
+bool URayCastVehicleMovementComponent::IsOnGround() const { return bIsOnGround; }
 
 void URayCastVehicleMovementComponent::SaveMove(const FVehicleMoveInput& Move) { MoveHistory.Add(Move); if (MoveHistory.Num() > MaxMoveHistory) { MoveHistory.RemoveAt(0); } }
 
@@ -192,6 +285,7 @@ void URayCastVehicleMovementComponent::CorrectClientState(const FVehicleMoveInpu
 
 	MoveHistory = MovesToReplay;
 
+	TraceGroundPlane();
 	for (const FVehicleMoveInput& Move : MovesToReplay)
 	{
 		AccelerationInput = Move.AccelerationInput;
@@ -209,6 +303,7 @@ void URayCastVehicleMovementComponent::ServerUpdateInputs_Implementation(float T
 	SteeringInput = FMath::Clamp(Steering, -1.f, 1.f);
 	bIsDrifting = Drifting;
 
+	TraceGroundPlane();
 	PerformMovement(GetWorld()->GetDeltaSeconds());
 
 	FVector ServerPosition = BoxCollider->GetComponentLocation();
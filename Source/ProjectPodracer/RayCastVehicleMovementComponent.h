@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/MovementComponent.h"
+#include "PodGroundProbe.h"
 #include "RayCastVehicleMovementComponent.generated.h"
 
 class AReplicatedSimRayCastVehicle;
@@ -53,7 +54,13 @@ public:
 
 private:
 	void PerformMovement(float DeltaTime);
+	// Traces the ground once and keeps its plane for the substeps that follow
+	void TraceGroundPlane();
+	// Height of Location above the cached ground plane, measured straight down. False off the ground
+	bool GetHeightAboveGround(const FVector& Location, float& OutHeight) const;
 	void MaintainHoverHeight(float DeltaTime);
+	// Holds the box on the ground by turning its gravity off instead of making it kinematic, which rebuilds the body
+	void SetHoverLocked(bool bLocked);
 	void CalculateAcceleration(float DeltaTime);
 	void ApplyInputs(float DeltaTime);
 	void SaveMove(const FVehicleMoveInput& Move);
@@ -109,6 +116,13 @@ private:
 
 	float Acceleration;
 
+	FPodGroundContactCache GroundContactCache;
+	FVector GroundPlanePoint = FVector::ZeroVector;
+	FVector GroundPlaneNormal = FVector::UpVector;
+	bool bHasGroundPlane = false;
+	bool bIsOnGround = false;
+	bool bHoverLocked = false;
+
 	TArray<FVehicleMoveInput> MoveHistory;
 	static constexpr int32 MaxMoveHistory = 100;
 	float LastMoveTime;
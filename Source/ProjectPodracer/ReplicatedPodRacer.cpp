@@ -208,6 +208,24 @@ void AReplicatedPodRacer::Destroyed()
     Super::Destroyed();
 }
 
+void AReplicatedPodRacer::NotifyControllerChanged()
+{
+    Super::NotifyControllerChanged();
+    if (PodMovementComponent)
+    {
+        PodMovementComponent->RefreshRoleTick();
+    }
+}
+
+void AReplicatedPodRacer::PostNetReceiveRole()
+{
+    Super::PostNetReceiveRole();
+    if (PodMovementComponent)
+    {
+        PodMovementComponent->RefreshRoleTick();
+    }
+}
+
 // Keeping this function on the Pawn as it manages the creation of EngineComponents
 void AReplicatedPodRacer::AddEngine(FDataTableRowHandle EngineStatsHandle, const FVector& Offset)
 {
@@ -53,6 +53,9 @@ protected:
     virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
     virtual void TornOff() override;
     virtual void Destroyed() override;
+    // Rebind the movement component's role tick
+    virtual void NotifyControllerChanged() override;
+    virtual void PostNetReceiveRole() override;
 
 protected:
     // The component that will handle our movement logic and replication
@@ -7,9 +7,10 @@
 #include "EnhancedInputSubsystems.h"
 #include "Camera/CameraComponent.h"
 #include "Components/BoxComponent.h"
+#include "DrawDebugHelpers.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
+#include "PodGroundProbe.h"
 
 
 // Sets default values
@@ -126,10 +127,8 @@ void ASimulatedRayCastVehicle::BeginPlay()
 void ASimulatedRayCastVehicle::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
-	SuspensionCast(FLeftSuspensionRoot);
-	SuspensionCast(FRightSuspensionRoot);
-	SuspensionCast(RLeftSuspensionRoot);
-	SuspensionCast(RRightSuspensionRoot);
+	GatherSuspensionContacts();
+	ApplySuspensionForces();
 	CalculateAcceleration();
 }
 
@@ -149,95 +148,80 @@ void ASimulatedRayCastVehicle::SetupPlayerInputComponent(UInputComponent* Player
 	}
 }
 
-void ASimulatedRayCastVehicle::SuspensionCast(USceneComponent* SuspensionAxisRef)
+void ASimulatedRayCastVehicle::GatherSuspensionContacts()
 {
-	FVector SuspensionAxisLoc = SuspensionAxisRef->GetComponentLocation();
-	FVector TraceEnd = SuspensionAxisLoc + SuspensionAxisRef->GetUpVector() * (-TargetHoverHeight);// + 200.0f); // Trace further
+	USceneComponent* const SuspensionRoots[NumSuspensions] = { FLeftSuspensionRoot, FRightSuspensionRoot, RLeftSuspensionRoot, RRightSuspensionRoot };
+	FCollisionQueryParams QueryParams(PodQueryStats::Tag(EPodQueryClass::SimulatedRayCastVehicle), SCENE_QUERY_STAT_ONLY(SuspensionCast), false, this);
 
-	FHitResult HitResult;
-	TArray<AActor*> ActorsToIgnore;
-	ActorsToIgnore.Add(this);
-
-	bool bHit = UKismetSystemLibrary::LineTraceSingle(
-		GetWorld(), SuspensionAxisLoc, TraceEnd, UEngineTypes::ConvertToTraceType(ECC_Visibility),
-		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, HitResult, true);
-
-	//FVector TargetUp = FVector::UpVector; // Default to world up if no ground
-	//float CurrentGroundDistance = TargetHoverHeight + 100.f; // Assume far if no hit
-
-	if (bHit && HitResult.bBlockingHit)
+	bIsOnGround = false;
+	for (int32 Index = 0; Index < NumSuspensions; ++Index)
 	{
-		//CurrentGroundDistance = HitResult.Distance;
-		//TargetUp = HitResult.ImpactNormal; // Align to ground
-		// World-Space direction of the spring force.
-		FVector SpringDir = SuspensionAxisRef->GetUpVector();
-		// World-Space velocity of this tire
-		FVector SuspensionWorldVel = BoxCollider->GetPhysicsLinearVelocityAtPoint(SuspensionAxisLoc);
-		// Calculate offset from the raycast
-		float NormalizedHitDist = 1.0f - UKismetMathLibrary::NormalizeToRange(HitResult.Distance, 0, TargetHoverHeight);//SuspensionResetDist - HitResult.Distance;
-		// Calculate velocity along the spring direction
-		// note that springDir is a unit vector, so this returns the magnitude of tireWorldVel
-		// as projected onto springDir
-		float SpringVel = FVector::DotProduct(SpringDir, SuspensionWorldVel);
-		// Calculate the magnitude of the dampened spring force
-		float DampenedSpringForce = (NormalizedHitDist * SpringStrength) - (SpringVel * SpringDamper);
-		// apply the force at the location of this tire, in the direction of the suspension
-		BoxCollider->AddForceAtLocation(SpringDir * DampenedSpringForce, SuspensionAxisLoc);
+		FSuspensionContact& Contact = SuspensionContacts[Index];
+		Contact.Location = SuspensionRoots[Index]->GetComponentLocation();
+		Contact.SpringDir = SuspensionRoots[Index]->GetUpVector();
+		const FVector TraceEnd = Contact.Location - Contact.SpringDir * TargetHoverHeight;
+
+		Contact.bHit = PodGroundProbe::LineTrace(GetWorld(), Contact.Hit, Contact.Location, TraceEnd, ECC_PodGround, QueryParams);
+		bIsOnGround |= Contact.bHit;
 
+#if ENABLE_DRAW_DEBUG
 		if (DrawDebug)
 		{
-			// Draw debug arrow for suspension strength direction
-			FVector End = SuspensionAxisLoc + (SpringDir * DampenedSpringForce * 0.003);
-			UKismetSystemLibrary::DrawDebugArrow(GetWorld(), SuspensionAxisLoc, End, 100.f, FColor::Blue, 0.0f, 5.0f);
+			DrawDebugLine(GetWorld(), Contact.Location, Contact.bHit ? FVector(Contact.Hit.ImpactPoint) : TraceEnd, FColor::Red, false, 0.0f);
+			if (Contact.bHit)
+			{
+				DrawDebugLine(GetWorld(), Contact.Hit.ImpactPoint, TraceEnd, FColor::Green, false, 0.0f);
+				DrawDebugPoint(GetWorld(), Contact.Hit.ImpactPoint, 16.0f, FColor::Red, false, 0.0f);
+			}
 		}
-
-		AccelerateVehicle(SuspensionAxisRef, HitResult);
-
-		// Old Version
-		FVector SuspensionUnitVector = UKismetMathLibrary::GetDirectionUnitVector(HitResult.TraceEnd, HitResult.TraceStart);
-		//FVector SuspensionDistVector = SuspensionUnitVector * NormalizedHitDist * SuspensionStrengthMultiplier;
-		//BoxCollider->AddForceAtLocation(SuspensionDistVector, SuspensionAxisLoc);
-	} else
-	{
-		AccelerateVehicle(SuspensionAxisRef, HitResult);
+#endif
 	}
 }
 
-void ASimulatedRayCastVehicle::CalculateAcceleration()
-{
-	Acceleration = FMath::Lerp(0, MaxAcceleration, AccelerationInput) * AccelerationInput;
-	AccelerationInput = FMath::FInterpTo(AccelerationInput, 0, GetWorld()->GetDeltaSeconds(), 0.3);
-}
-
-void ASimulatedRayCastVehicle::AccelerateVehicle(USceneComponent* SuspensionAxisRef, FHitResult HitResult)
+void ASimulatedRayCastVehicle::ApplySuspensionForces()
 {
-	FVector SuspensionAxisLoc = SuspensionAxisRef->GetComponentLocation();
-	FVector NewCenterOfMass = AccelerationCenterOfMassOffset * AccelerationInput;
-	BoxCollider->SetCenterOfMass(NewCenterOfMass);
+	BoxCollider->SetCenterOfMass(AccelerationCenterOfMassOffset * AccelerationInput);
 
-	// Acceleration Handling
+	// Acceleration Handling, applied at every suspension point like the springs
 	FVector AccelDir = BoxCollider->GetForwardVector() * AccelerationForce * AccelerationInput * BoxCollider->GetMass() * SpeedModifier;
-	FVector GravityStrength = FVector(0, 0, 0);
-	if (!IsOnGround())
+	FVector GravityStrength = bIsOnGround ? FVector::ZeroVector : FVector(0, 0, AccelerationGravityStrength);
+	FVector AccelWithGravity = AccelDir + GravityStrength;
+
+	for (const FSuspensionContact& Contact : SuspensionContacts)
 	{
-		GravityStrength = FVector(0, 0, AccelerationGravityStrength);
+		if (Contact.bHit)
+		{
+			// World-Space velocity of this tire
+			FVector SuspensionWorldVel = BoxCollider->GetPhysicsLinearVelocityAtPoint(Contact.Location);
+			// Calculate offset from the raycast
+			float NormalizedHitDist = 1.0f - UKismetMathLibrary::NormalizeToRange(Contact.Hit.Distance, 0, TargetHoverHeight);
+			// Calculate velocity along the spring direction
+			// note that springDir is a unit vector, so this returns the magnitude of tireWorldVel
+			// as projected onto springDir
+			float SpringVel = FVector::DotProduct(Contact.SpringDir, SuspensionWorldVel);
+			// Calculate the magnitude of the dampened spring force
+			float DampenedSpringForce = (NormalizedHitDist * SpringStrength) - (SpringVel * SpringDamper);
+			// apply the force at the location of this tire, in the direction of the suspension
+			BoxCollider->AddForceAtLocation(Contact.SpringDir * DampenedSpringForce, Contact.Location);
+
+#if ENABLE_DRAW_DEBUG
+			if (DrawDebug)
+			{
+				// Draw debug arrow for suspension strength direction
+				FVector End = Contact.Location + (Contact.SpringDir * DampenedSpringForce * 0.003);
+				DrawDebugDirectionalArrow(GetWorld(), Contact.Location, End, 100.f, FColor::Blue, false, 0.0f, 0, 5.0f);
+			}
+#endif
+		}
+
+		BoxCollider->AddForceAtLocation(AccelWithGravity, Contact.Location);
 	}
-	FVector AccelWithGravity = AccelDir + GravityStrength;
-	BoxCollider->AddForceAtLocation(AccelWithGravity, SuspensionAxisLoc);
 }
 
-bool ASimulatedRayCastVehicle::IsOnGround()
+void ASimulatedRayCastVehicle::CalculateAcceleration()
 {
-	FHitResult HitResult;
-	TArray<AActor*> ActorsToIgnore;
-	ActorsToIgnore.Add(this);
-
-	FVector TraceHeightOfVehicle = GetActorLocation() - FVector(0, 0, TargetHoverHeight);
-
-	bool bHit = UKismetSystemLibrary::LineTraceSingle(
-		GetWorld(), GetActorLocation(), TraceHeightOfVehicle, UEngineTypes::ConvertToTraceType(ECC_Visibility),
-		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, HitResult, true);
-	return bHit;
+	Acceleration = FMath::Lerp(0, MaxAcceleration, AccelerationInput) * AccelerationInput;
+	AccelerationInput = FMath::FInterpTo(AccelerationInput, 0, GetWorld()->GetDeltaSeconds(), 0.3);
 }
 
 void ASimulatedRayCastVehicle::StartDrift(const FInputActionValue& Value)
@@ -12,6 +12,15 @@ class UCameraComponent;
 class USpringArmComponent;
 class UBoxComponent;
 
+// One suspension ray's result for the current tick
+struct FSuspensionContact
+{
+	FVector Location = FVector::ZeroVector;
+	FVector SpringDir = FVector::UpVector;
+	FHitResult Hit;
+	bool bHit = false;
+};
+
 UCLASS(Blueprintable)
 class PROJECTPODRACER_API ASimulatedRayCastVehicle : public APawn
 {
@@ -30,17 +39,18 @@ public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
-	UFUNCTION()
-	void SuspensionCast(USceneComponent* SuspensionAxisRef);
+	// Traces all four suspension rays once and derives the grounded flag from them
+	void GatherSuspensionContacts();
 
-	UFUNCTION()
-	void CalculateAcceleration();
+	// Spring, acceleration and air gravity forces from this tick's contacts
+	void ApplySuspensionForces();
 
 	UFUNCTION()
-	void AccelerateVehicle(USceneComponent* SuspensionAxisRef, FHitResult HitResult);
+	void CalculateAcceleration();
 
+	// Any suspension ray touched the ground this tick
 	UFUNCTION(BlueprintPure)
-	bool IsOnGround();
+	bool IsOnGround() const { return bIsOnGround; }
 
 public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -119,6 +129,11 @@ public:
 	bool DrawDebug = true;
 
 private:
+	// FL, FR, RL, RR
+	static constexpr int32 NumSuspensions = 4;
+	FSuspensionContact SuspensionContacts[NumSuspensions];
+	bool bIsOnGround = false;
+
 	// Input Mapping Context
 	UPROPERTY(EditAnywhere, Category = "Input")
 	UInputMappingContext* DefaultMappingContext;
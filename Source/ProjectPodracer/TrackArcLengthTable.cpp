@@ -0,0 +1,174 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TrackArcLengthTable.h"
+
+#include "Components/SplineComponent.h"
+
+// Entries handed to each worker at a time while building
+static constexpr int32 ArcLengthBuildBatchSize = 256;
+
+// Entries looked up per pass of SampleBatch, small enough for the indices and alphas to stay on the stack
+static constexpr int32 ArcLengthBatchSize = 256;
+
+void FTrackArcLengthTable::Build(const USplineComponent& Spline, float MaxStep, EParallelForFlags Flags)
+{
+	Reset();
+
+	Length = Spline.GetSplineLength();
+	NumSplinePoints = Spline.GetNumberOfSplinePoints();
+	bClosedLoop = Spline.IsClosedLoop();
+	if (NumSplinePoints < 2 || Length <= 0.f)
+	{
+		return;
+	}
+
+	const int32 NumEntries = FMath::CeilToInt32(Length / FMath::Max(MaxStep, 1.f)) + 1;
+	InvStep = (NumEntries - 1) / Length;
+
+	Keys.SetNumUninitialized(NumEntries);
+	LocationX.SetNumUninitialized(NumEntries);
+	LocationY.SetNumUninitialized(NumEntries);
+	LocationZ.SetNumUninitialized(NumEntries);
+	DirectionX.SetNumUninitialized(NumEntries);
+	DirectionY.SetNumUninitialized(NumEntries);
+	DirectionZ.SetNumUninitialized(NumEntries);
+	UpX.SetNumUninitialized(NumEntries);
+	UpY.SetNumUninitialized(NumEntries);
+	UpZ.SetNumUninitialized(NumEntries);
+
+	// The one place the spline's own reparameterization is paid for, once per entry. Reading the spline is const, so
+	// entries are evaluated side by side
+	ParallelFor(TEXT("TrackArcLengthTable"), NumEntries, ArcLengthBuildBatchSize, [&](int32 Entry)
+	{
+		// From the index rather than a running sum, so the last entry lands on the end of the spline
+		const float Distance = Entry == NumEntries - 1 ? Length : Entry / InvStep;
+		const float Key = Spline.GetInputKeyValueAtDistanceAlongSpline(Distance);
+		const FVector Location = Spline.GetLocationAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+		const FVector Direction = Spline.GetDirectionAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+		const FVector UpVector = Spline.GetUpVectorAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+
+		Keys[Entry] = Key;
+		LocationX[Entry] = Location.X;
+		LocationY[Entry] = Location.Y;
+		LocationZ[Entry] = Location.Z;
+		DirectionX[Entry] = Direction.X;
+		DirectionY[Entry] = Direction.Y;
+		DirectionZ[Entry] = Direction.Z;
+		UpX[Entry] = UpVector.X;
+		UpY[Entry] = UpVector.Y;
+		UpZ[Entry] = UpVector.Z;
+	}, Flags);
+}
+
+void FTrackArcLengthTable::Reset()
+{
+	Length = 0.f;
+	InvStep = 0.f;
+	NumSplinePoints = 0;
+	bClosedLoop = false;
+
+	Keys.Reset();
+	LocationX.Reset();
+	LocationY.Reset();
+	LocationZ.Reset();
+	DirectionX.Reset();
+	DirectionY.Reset();
+	DirectionZ.Reset();
+	UpX.Reset();
+	UpY.Reset();
+	UpZ.Reset();
+}
+
+bool FTrackArcLengthTable::IsBuiltFrom(const USplineComponent& Spline) const
+{
+	return !IsEmpty()
+		&& NumSplinePoints == Spline.GetNumberOfSplinePoints()
+		&& bClosedLoop == Spline.IsClosedLoop()
+		&& Length == Spline.GetSplineLength();
+}
+
+float FTrackArcLengthTable::GetInputKey(float Distance) const
+{
+	int32 Index;
+	float Alpha;
+	Locate(Distance, Index, Alpha);
+	return FMath::Lerp(Keys[Index], Keys[Index + 1], Alpha);
+}
+
+void FTrackArcLengthTable::Sample(float Distance, FVector& OutLocation, FVector& OutDirection, FVector& OutUpVector) const
+{
+	int32 Index;
+	float Alpha;
+	Locate(Distance, Index, Alpha);
+	const int32 Next = Index + 1;
+
+	OutLocation.X = FMath::Lerp(LocationX[Index], LocationX[Next], double(Alpha));
+	OutLocation.Y = FMath::Lerp(LocationY[Index], LocationY[Next], double(Alpha));
+	OutLocation.Z = FMath::Lerp(LocationZ[Index], LocationZ[Next], double(Alpha));
+	OutDirection = FVector(FMath::Lerp(DirectionX[Index], DirectionX[Next], Alpha), FMath::Lerp(DirectionY[Index], DirectionY[Next], Alpha), FMath::Lerp(DirectionZ[Index], DirectionZ[Next], Alpha)).GetSafeNormal();
+	OutUpVector = FVector(FMath::Lerp(UpX[Index], UpX[Next], Alpha), FMath::Lerp(UpY[Index], UpY[Next], Alpha), FMath::Lerp(UpZ[Index], UpZ[Next], Alpha)).GetSafeNormal();
+}
+
+void FTrackArcLengthTable::SampleBatch(TConstArrayView<float> Distances, TArrayView<FVector> OutLocations, TArrayView<FVector> OutDirections, TArrayView<FVector> OutUpVectors) const
+{
+	check(OutLocations.Num() == Distances.Num() && OutDirections.Num() == Distances.Num() && OutUpVectors.Num() == Distances.Num());
+
+	int32 Indices[ArcLengthBatchSize];
+	float Alphas[ArcLengthBatchSize];
+	for (int32 First = 0; First < Distances.Num(); First += ArcLengthBatchSize)
+	{
+		const int32 Count = FMath::Min(ArcLengthBatchSize, Distances.Num() - First);
+
+		// Locate the whole pass first, then run each component through it as its own branch-free loop over one array,
+		// which the compiler can vectorize
+		for (int32 Item = 0; Item < Count; ++Item)
+		{
+			Locate(Distances[First + Item], Indices[Item], Alphas[Item]);
+		}
+
+		for (int32 Item = 0; Item < Count; ++Item)
+		{
+			const int32 Index = Indices[Item];
+			const double Alpha = Alphas[Item];
+			FVector& Location = OutLocations[First + Item];
+			Location.X = LocationX[Index] + (LocationX[Index + 1] - LocationX[Index]) * Alpha;
+			Location.Y = LocationY[Index] + (LocationY[Index + 1] - LocationY[Index]) * Alpha;
+			Location.Z = LocationZ[Index] + (LocationZ[Index + 1] - LocationZ[Index]) * Alpha;
+		}
+
+		for (int32 Item = 0; Item < Count; ++Item)
+		{
+			const int32 Index = Indices[Item];
+			const float Alpha = Alphas[Item];
+			OutDirections[First + Item] = FVector(
+				DirectionX[Index] + (DirectionX[Index + 1] - DirectionX[Index]) * Alpha,
+				DirectionY[Index] + (DirectionY[Index + 1] - DirectionY[Index]) * Alpha,
+				DirectionZ[Index] + (DirectionZ[Index + 1] - DirectionZ[Index]) * Alpha);
+		}
+
+		for (int32 Item = 0; Item < Count; ++Item)
+		{
+			const int32 Index = Indices[Item];
+			const float Alpha = Alphas[Item];
+			OutUpVectors[First + Item] = FVector(
+				UpX[Index] + (UpX[Index + 1] - UpX[Index]) * Alpha,
+				UpY[Index] + (UpY[Index + 1] - UpY[Index]) * Alpha,
+				UpZ[Index] + (UpZ[Index + 1] - UpZ[Index]) * Alpha);
+		}
+
+		for (int32 Item = First; Item < First + Count; ++Item)
+		{
+			OutDirections[Item].Normalize();
+			OutUpVectors[Item].Normalize();
+		}
+	}
+}
+
+SIZE_T FTrackArcLengthTable::GetAllocatedSize() const
+{
+	return Keys.GetAllocatedSize()
+		+ LocationX.GetAllocatedSize() + LocationY.GetAllocatedSize() + LocationZ.GetAllocatedSize()
+		+ DirectionX.GetAllocatedSize() + DirectionY.GetAllocatedSize() + DirectionZ.GetAllocatedSize()
+		+ UpX.GetAllocatedSize() + UpY.GetAllocatedSize() + UpZ.GetAllocatedSize();
+}
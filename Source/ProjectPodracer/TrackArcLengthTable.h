@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+
+class USplineComponent;
+
+/**
+ * Location, direction and up vector of a spline at uniform steps of distance along it, in the spline's local space.
+ * A lookup by distance is an index and a lerp between two entries instead of USplineComponent's reparameterization
+ * search, and every component is its own array so batch lookups stream through them.
+ */
+struct PROJECTPODRACER_API FTrackArcLengthTable
+{
+	// Samples Spline at most MaxStep apart, evenly spaced so the last entry lands on its end
+	void Build(const USplineComponent& Spline, float MaxStep, EParallelForFlags Flags = EParallelForFlags::None);
+	void Reset();
+
+	bool IsEmpty() const { return Keys.Num() == 0; }
+	float GetLength() const { return Length; }
+	int32 Num() const { return Keys.Num(); }
+
+	// Whether this was built from Spline as it is now, going by its length, point count and loop
+	bool IsBuiltFrom(const USplineComponent& Spline) const;
+
+	// Distances past the ends wrap round a closed loop and clamp otherwise. The table must not be empty
+	float GetInputKey(float Distance) const;
+	void Sample(float Distance, FVector& OutLocation, FVector& OutDirection, FVector& OutUpVector) const;
+
+	// Sample for every entry of Distances. The outputs must be as long as Distances
+	void SampleBatch(TConstArrayView<float> Distances, TArrayView<FVector> OutLocations, TArrayView<FVector> OutDirections, TArrayView<FVector> OutUpVectors) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	// Entry below Distance and how far it is towards the next one
+	FORCEINLINE void Locate(float Distance, int32& OutIndex, float& OutAlpha) const
+	{
+		float Wrapped = bClosedLoop ? FMath::Fmod(Distance, Length) : Distance;
+		Wrapped = Wrapped < 0.f ? Wrapped + Length : Wrapped;
+		const float Position = FMath::Clamp(Wrapped * InvStep, 0.f, float(Keys.Num() - 1));
+		OutIndex = FMath::Min(int32(Position), Keys.Num() - 2);
+		OutAlpha = Position - OutIndex;
+	}
+
+	float Length = 0.f;
+	float InvStep = 0.f;
+	int32 NumSplinePoints = 0;
+	bool bClosedLoop = false;
+
+	TArray<float> Keys;
+	// Locations stay double, a long track's far end is too far out for float centimetres
+	TArray<double> LocationX;
+	TArray<double> LocationY;
+	TArray<double> LocationZ;
+	TArray<float> DirectionX;
+	TArray<float> DirectionY;
+	TArray<float> DirectionZ;
+	TArray<float> UpX;
+	TArray<float> UpY;
+	TArray<float> UpZ;
+};
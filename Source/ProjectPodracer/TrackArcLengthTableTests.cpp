@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TrackArcLengthTable.h"
+#include "PodTestWorld.h"
+#include "Components/SplineComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrackArcLengthTableTest, "ProjectPodracer.ArcLengthTable.MatchesSpline",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Lookups by distance on generated tracks of 10, 100 and 1000 points must land within a centimetre of the spline's own,
+// one at a time and batched alike. Reports both against the spline
+bool FTrackArcLengthTableTest::RunTest(const FString& Parameters)
+{
+	FPodScopedConsoleVariable NoCache(TEXT("Pod.Track.Cache"), 0);
+	FPodTestWorld TestWorld;
+	constexpr int32 NumLookups = 10000;
+	constexpr float MaxLocationError = 1.f;
+
+	for (const int32 NumberOfControlPoints : { 10, 100, 1000 })
+	{
+		AProceduralTrackGenerator* Track = TestWorld.SpawnTrack(NumberOfControlPoints);
+		if (!TestNotNull(TEXT("Track spawned"), Track))
+		{
+			return false;
+		}
+		Track->Generate();
+
+		const USplineComponent* Spline = Track->TrackSpline;
+		const FTrackArcLengthTable& Table = Track->GetArcLengthTable();
+		const FString Case = FString::Printf(TEXT("%d points"), NumberOfControlPoints);
+		if (!TestTrue(FString::Printf(TEXT("%s table built from the spline"), *Case), Table.IsBuiltFrom(*Spline)))
+		{
+			continue;
+		}
+
+		TArray<float> Distances;
+		FRandomStream DistanceStream(NumberOfControlPoints);
+		for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+		{
+			Distances.Add(DistanceStream.FRandRange(0.f, Table.GetLength()));
+		}
+
+		TArray<FVector> SplineLocations, SplineDirections, SplineUpVectors;
+		SplineLocations.SetNumUninitialized(NumLookups);
+		SplineDirections.SetNumUninitialized(NumLookups);
+		SplineUpVectors.SetNumUninitialized(NumLookups);
+		double Start = FPlatformTime::Seconds();
+		for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+		{
+			const float Key = Spline->GetInputKeyValueAtDistanceAlongSpline(Distances[Lookup]);
+			SplineLocations[Lookup] = Spline->GetLocationAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+			SplineDirections[Lookup] = Spline->GetDirectionAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+			SplineUpVectors[Lookup] = Spline->GetUpVectorAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+		}
+		const double SplineSeconds = FPlatformTime::Seconds() - Start;
+
+		TArray<FVector> Locations, Directions, UpVectors;
+		Locations.SetNumUninitialized(NumLookups);
+		Directions.SetNumUninitialized(NumLookups);
+		UpVectors.SetNumUninitialized(NumLookups);
+		Start = FPlatformTime::Seconds();
+		for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+		{
+			Table.Sample(Distances[Lookup], Locations[Lookup], Directions[Lookup], UpVectors[Lookup]);
+		}
+		const double TableSeconds = FPlatformTime::Seconds() - Start;
+
+		TArray<FVector> BatchLocations, BatchDirections, BatchUpVectors;
+		BatchLocations.SetNumUninitialized(NumLookups);
+		BatchDirections.SetNumUninitialized(NumLookups);
+		BatchUpVectors.SetNumUninitialized(NumLookups);
+		Start = FPlatformTime::Seconds();
+		Table.SampleBatch(Distances, BatchLocations, BatchDirections, BatchUpVectors);
+		const double BatchSeconds = FPlatformTime::Seconds() - Start;
+
+		double MaxError = 0.0;
+		int32 OffDirections = 0;
+		int32 BatchMismatches = 0;
+		for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+		{
+			MaxError = FMath::Max(MaxError, FVector::Dist(Locations[Lookup], SplineLocations[Lookup]));
+			OffDirections += !Directions[Lookup].Equals(SplineDirections[Lookup], 0.01) || !UpVectors[Lookup].Equals(SplineUpVectors[Lookup], 0.01);
+			BatchMismatches += !BatchLocations[Lookup].Equals(Locations[Lookup], UE_KINDA_SMALL_NUMBER)
+				|| !BatchDirections[Lookup].Equals(Directions[Lookup], UE_KINDA_SMALL_NUMBER)
+				|| !BatchUpVectors[Lookup].Equals(UpVectors[Lookup], UE_KINDA_SMALL_NUMBER);
+		}
+		TestTrue(FString::Printf(TEXT("%s largest error %.3f cm within %.1f cm"), *Case, MaxError, MaxLocationError), MaxError <= MaxLocationError);
+		TestEqual(FString::Printf(TEXT("%s directions off the spline's"), *Case), OffDirections, 0);
+		TestEqual(FString::Printf(TEXT("%s batched lookups differing from single ones"), *Case), BatchMismatches, 0);
+		AddInfo(FString::Printf(TEXT("%s, %d entries (%.1f KB), %d lookups: spline %.3f ms, table %.3f ms, batched %.3f ms; largest error %.3f cm"),
+			*Case, Table.Num(), Table.GetAllocatedSize() / 1024.0, NumLookups, SplineSeconds * 1000.0, TableSeconds * 1000.0, BatchSeconds * 1000.0, MaxError));
+
+		Track->ClearAll();
+		Track->Destroy();
+	}
+	return true;
+}
+
+#endif
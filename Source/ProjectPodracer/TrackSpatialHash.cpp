@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TrackSpatialHash.h"
+
+void FTrackSpatialHash::Reset(float CellSize)
+{
+	InvCellSize = 1.0 / FMath::Max(CellSize, 1.f);
+	Points.Reset();
+	CellHeads.Reset();
+	NextInCell.Reset();
+}
+
+int32 FTrackSpatialHash::Add(const FVector2D& Point)
+{
+	const int32 Index = Points.Add(Point);
+	int32& Head = CellHeads.FindOrAdd(GetCell(Point), INDEX_NONE);
+	NextInCell.Add(Head);
+	Head = Index;
+	return Index;
+}
+
+SIZE_T FTrackSpatialHash::GetAllocatedSize() const
+{
+	return Points.GetAllocatedSize() + CellHeads.GetAllocatedSize() + NextInCell.GetAllocatedSize();
+}
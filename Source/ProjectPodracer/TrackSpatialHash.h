@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Points in the XY plane bucketed into square cells of a uniform grid, keyed by cell so the grid can cover a whole
+ * track without allocating the empty cells between its stretches. A query only looks at the cells its radius touches,
+ * so with cells about the size of the usual query radius it visits a handful of points however many there are.
+ */
+struct PROJECTPODRACER_API FTrackSpatialHash
+{
+	// Empties the hash and sets the cell size for the points added next
+	void Reset(float CellSize);
+
+	// Index of the new point, counting up from 0 in the order points were added
+	int32 Add(const FVector2D& Point);
+
+	bool IsEmpty() const { return Points.Num() == 0; }
+	int32 Num() const { return Points.Num(); }
+	const FVector2D& GetPoint(int32 Index) const { return Points[Index]; }
+
+	// Whether any point is closer than Radius to Point
+	bool AnyWithin(const FVector2D& Point, double Radius) const
+	{
+		return !ForEachWithin(Point, Radius, [](int32, double) { return false; });
+	}
+
+	// Calls Visitor(Index, DistanceSquared) for every point closer than Radius to Point, until it returns false.
+	// Returns false when the visitor stopped it
+	template<typename VisitorType>
+	bool ForEachWithin(const FVector2D& Point, double Radius, VisitorType&& Visitor) const
+	{
+		if (Points.Num() == 0)
+		{
+			return true;
+		}
+
+		const double RadiusSquared = Radius * Radius;
+		const FIntPoint MinCell = GetCell(Point - FVector2D(Radius));
+		const FIntPoint MaxCell = GetCell(Point + FVector2D(Radius));
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				const int32* Head = CellHeads.Find(FIntPoint(X, Y));
+				for (int32 Index = Head ? *Head : INDEX_NONE; Index != INDEX_NONE; Index = NextInCell[Index])
+				{
+					const double DistanceSquared = FVector2D::DistSquared(Points[Index], Point);
+					if (DistanceSquared < RadiusSquared && !Visitor(Index, DistanceSquared))
+					{
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	FIntPoint GetCell(const FVector2D& Point) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Point.X * InvCellSize), FMath::FloorToInt32(Point.Y * InvCellSize));
+	}
+
+	double InvCellSize = 1.0;
+	TArray<FVector2D> Points;
+	// Last point added to each cell, and for every point the one added to its cell before it (INDEX_NONE for the first)
+	TMap<FIntPoint, int32> CellHeads;
+	TArray<int32> NextInCell;
+};